@@ -87,6 +87,17 @@ extern void z80ex_set_tstate_callback(Z80EX_CONTEXT *cpu, z80ex_tstate_cb cb_fn,
 /*set RETI callback*/
 extern void z80ex_set_reti_callback(Z80EX_CONTEXT *cpu, z80ex_reti_cb cb_fn, void *user_data);
 
+/*set flat 64k memory block to be accessed directly instead of memory callbacks (NULL to use callbacks)*/
+extern void z80ex_set_memory(Z80EX_CONTEXT *cpu, Z80EX_BYTE *memory);
+
+/*execute opcodes until at least <tstates> T-states are spent, return number of T-states taken
+(excluding ones already reported by z80ex_run_flush)*/
+extern unsigned long z80ex_run(Z80EX_CONTEXT *cpu, unsigned long tstates);
+
+/*when called from callbacks during z80ex_run, returns T-states taken by opcodes completed since
+the run start or previous flush and excludes them from the z80ex_run result*/
+extern unsigned long z80ex_run_flush(Z80EX_CONTEXT *cpu);
+
 /*maskable interrupt*/
 /*returns number of T-states if interrupt was accepted, otherwise 0*/
 extern int z80ex_int(Z80EX_CONTEXT *cpu);
@@ -84,11 +84,19 @@
 #define FLAG_Z	0x40
 #define FLAG_S	0x80
 
+/*raw memory access, either direct or via callbacks*/
+#define MREAD(addr, m1) (cpu->memory? cpu->memory[(Z80EX_WORD)(addr)] : cpu->mread_cb(cpu, (addr), m1, cpu->mread_cb_user_data))
+#define MWRITE(addr, vbyte) \
+{ \
+	if(cpu->memory) cpu->memory[(Z80EX_WORD)(addr)] = (vbyte); \
+	else cpu->mwrite_cb(cpu, (addr), (vbyte), cpu->mwrite_cb_user_data); \
+}
+
 /*read opcode*/
-#define READ_OP_M1() (cpu->int_vector_req? cpu->intread_cb(cpu, cpu->intread_cb_user_data) : cpu->mread_cb(cpu, PC++, 1, cpu->mread_cb_user_data))
+#define READ_OP_M1() (cpu->int_vector_req? cpu->intread_cb(cpu, cpu->intread_cb_user_data) : MREAD(PC++, 1))
 
 /*read opcode argument*/
-#define READ_OP() (cpu->int_vector_req? cpu->intread_cb(cpu, cpu->intread_cb_user_data) : cpu->mread_cb(cpu, PC++, 0, cpu->mread_cb_user_data))
+#define READ_OP() (cpu->int_vector_req? cpu->intread_cb(cpu, cpu->intread_cb_user_data) : MREAD(PC++, 0))
 
 
 #ifndef Z80EX_OPSTEP_FAST_AND_ROUGH
@@ -132,7 +140,7 @@ for using outside of certain opcode execution)*/
 #define READ_MEM(result, addr, t_state) \
 { \
 	T_WAIT_UNTIL(t_state); \
-	result=(cpu->mread_cb(cpu, (addr), 0, cpu->mread_cb_user_data)); \
+	result=MREAD(addr, 0); \
 }
 
 /*read byte from port*/
@@ -146,7 +154,7 @@ for using outside of certain opcode execution)*/
 #define WRITE_MEM(addr, vbyte, t_state) \
 { \
 	T_WAIT_UNTIL(t_state); \
-	cpu->mwrite_cb(cpu, addr, vbyte, cpu->mwrite_cb_user_data); \
+	MWRITE(addr, vbyte); \
 }
 
 /*write byte to port*/
@@ -166,7 +174,7 @@ for using outside of certain opcode execution)*/
 /*read byte from memory*/
 #define READ_MEM(result, addr, t_state) \
 { \
-	result=(cpu->mread_cb(cpu, (addr), 0, cpu->mread_cb_user_data)); \
+	result=MREAD(addr, 0); \
 }
 
 /*read byte from port*/
@@ -178,7 +186,7 @@ for using outside of certain opcode execution)*/
 /*write byte to memory*/
 #define WRITE_MEM(addr, vbyte, t_state) \
 { \
-	cpu->mwrite_cb(cpu, addr, vbyte, cpu->mwrite_cb_user_data); \
+	MWRITE(addr, vbyte); \
 }
 
 /*write byte to port*/
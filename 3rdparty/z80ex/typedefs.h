@@ -70,6 +70,13 @@ struct _z80_cpu_context {
 	z80ex_reti_cb reti_cb;
 	void *reti_cb_user_data;
 	
+	/*flat 64k memory accessed directly instead of mread/mwrite callbacks (optional)*/
+	Z80EX_BYTE *memory;
+	
+	/*batched execution state (see z80ex_run)*/
+	long run_limit;
+	long run_done;
+	
 	/*other stuff*/
 	regpair tmpword;
 	regpair tmpaddr;
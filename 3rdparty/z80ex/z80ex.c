@@ -181,6 +181,35 @@ LIB_EXPORT void z80ex_set_reti_callback(Z80EX_CONTEXT *cpu, z80ex_reti_cb cb_fn,
 	cpu->reti_cb_user_data=user_data;
 }
 
+LIB_EXPORT void z80ex_set_memory(Z80EX_CONTEXT *cpu, Z80EX_BYTE *memory)
+{
+	cpu->memory=memory;
+}
+
+LIB_EXPORT unsigned long z80ex_run(Z80EX_CONTEXT *cpu, unsigned long tstates)
+{
+	unsigned long done;
+	
+	cpu->run_limit=(long)tstates;
+	cpu->run_done=0;
+	while(cpu->run_done < cpu->run_limit)
+	{
+		cpu->run_done+=z80ex_step(cpu);
+	}
+	done=(unsigned long)cpu->run_done;
+	cpu->run_limit=cpu->run_done=0;
+	return(done);
+}
+
+LIB_EXPORT unsigned long z80ex_run_flush(Z80EX_CONTEXT *cpu)
+{
+	const long done=cpu->run_done;
+	
+	cpu->run_limit-=done;
+	cpu->run_done=0;
+	return((unsigned long)done);
+}
+
 /*non-maskable interrupt*/
 LIB_EXPORT int z80ex_nmi(Z80EX_CONTEXT *cpu)
 {
@@ -196,10 +225,10 @@ LIB_EXPORT int z80ex_nmi(Z80EX_CONTEXT *cpu)
 
 	TSTATES(5); 
 	
-	cpu->mwrite_cb(cpu, --SP, cpu->pc.b.h, cpu->mwrite_cb_user_data); /*PUSH PC -- high byte */
+	MWRITE(--SP, cpu->pc.b.h); /*PUSH PC -- high byte */
 	TSTATES(3);
 		
-	cpu->mwrite_cb(cpu, --SP, cpu->pc.b.l, cpu->mwrite_cb_user_data); /*PUSH PC -- low byte */
+	MWRITE(--SP, cpu->pc.b.l); /*PUSH PC -- low byte */
 	TSTATES(3);
 	
 	PC=0x0066;
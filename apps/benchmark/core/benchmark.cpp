@@ -11,11 +11,20 @@
 //local includes
 #include "benchmark.h"
 #include "ay.h"
+#include "dac.h"
+#include "tfm.h"
 #include "z80.h"
 #include "mixer.h"
+#include "packed.h"
+#include "parameters.h"
+#include "templates.h"
 //common includes
 #include <contract.h>
 #include <make_ptr.h>
+//library includes
+#include <binary/container_factories.h>
+//std includes
+#include <algorithm>
 //boost includes
 #include <boost/format.hpp>
 
@@ -78,6 +87,11 @@ namespace Benchmark
     class MemoryPerformanceTest : public Benchmark::PerformanceTest
     {
     public:
+      explicit MemoryPerformanceTest(std::size_t memSize)
+        : MemSize(memSize)
+      {
+      }
+
       std::string Category() const override
       {
         return "Z80 emulation";
@@ -85,7 +99,10 @@ namespace Benchmark
 
       std::string Name() const override
       {
-        return "Memory access";
+        //partially backed address space is accessed via callbacks
+        return MemSize < 65536
+          ? (boost::format("Memory access (%uK, callbacks)") % (MemSize / 1024)).str()
+          : std::string("Memory access");
       }
 
       double Execute() const override
@@ -103,10 +120,12 @@ namespace Benchmark
           0x18, 0xfa        //jr loop
         };
         Dump mem(Z80_TEST_MEM, std::end(Z80_TEST_MEM));
-        mem.resize(65536);
+        mem.resize(MemSize);
         const Devices::Z80::Chip::Ptr dev = CreateDevice(UINT64_C(3500000), 24, mem, Devices::Z80::ChipIO::Ptr());
         return Test(*dev, TEST_DURATION, FRAME_DURATION);
       }
+    private:
+      const std::size_t MemSize;
     };
 
     class IoPerformanceTest : public Benchmark::PerformanceTest
@@ -161,18 +180,92 @@ namespace Benchmark
 
     void ForAllTests(TestsVisitor& visitor)
     {
-      visitor.OnPerformanceTest(MemoryPerformanceTest());
+      visitor.OnPerformanceTest(MemoryPerformanceTest(65536));
+      visitor.OnPerformanceTest(MemoryPerformanceTest(49152));
       visitor.OnPerformanceTest(IoPerformanceTest());
     }
   }
 
+  namespace DAC
+  {
+    class PerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      explicit PerformanceTest(bool interpolate)
+        : Interpolate(interpolate)
+      {
+      }
+
+      std::string Category() const override
+      {
+        return "DAC emulation";
+      }
+
+      std::string Name() const override
+      {
+        return Interpolate ? "Interpolation" : "No interpolation";
+      }
+
+      double Execute() const override
+      {
+        const Devices::DAC::Chip::Ptr dev = CreateDevice(SOUND_FREQ, 8000, Interpolate);
+        return Test(*dev, TEST_DURATION, FRAME_DURATION);
+      }
+    private:
+      const bool Interpolate;
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      visitor.OnPerformanceTest(PerformanceTest(false));
+      visitor.OnPerformanceTest(PerformanceTest(true));
+    }
+  }
+
+  namespace TFM
+  {
+    class PerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      explicit PerformanceTest(Devices::FM::EngineType engine)
+        : Engine(engine)
+      {
+      }
+
+      std::string Category() const override
+      {
+        return "TFM emulation";
+      }
+
+      std::string Name() const override
+      {
+        return Engine == Devices::FM::ENGINE_BATCH ? "Batch" : "Reference";
+      }
+
+      double Execute() const override
+      {
+        const Devices::TFM::Chip::Ptr dev = CreateDevice(3500000, SOUND_FREQ, Engine);
+        return Test(*dev, TEST_DURATION, FRAME_DURATION);
+      }
+    private:
+      const Devices::FM::EngineType Engine;
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      visitor.OnPerformanceTest(PerformanceTest(Devices::FM::ENGINE_REFERENCE));
+      visitor.OnPerformanceTest(PerformanceTest(Devices::FM::ENGINE_BATCH));
+    }
+  }
+
   namespace Mixer
   {
     class PerformanceTest : public Benchmark::PerformanceTest
     {
     public:
-      explicit PerformanceTest(uint_t channels)
+      PerformanceTest(uint_t channels, bool block)
         : Channels(channels)
+        , Block(block)
       {
       }
 
@@ -183,22 +276,231 @@ namespace Benchmark
 
       std::string Name() const override
       {
-        return (boost::format("%u-channels") % Channels).str();
+        return (boost::format(Block ? "%u-channels block" : "%u-channels") % Channels).str();
       }
 
       double Execute() const override
       {
-        return Test(Channels, TEST_DURATION, SOUND_FREQ);
+        if (Block)
+        {
+          const uint_t blockSize = uint64_t(SOUND_FREQ) * FRAME_DURATION.Get() / FRAME_DURATION.PER_SECOND;
+          return TestBlock(Channels, TEST_DURATION, SOUND_FREQ, blockSize);
+        }
+        else
+        {
+          return Test(Channels, TEST_DURATION, SOUND_FREQ);
+        }
       }
     private:
       const uint_t Channels;
+      const bool Block;
     };
 
     void ForAllTests(TestsVisitor& visitor)
     {
       for (uint_t chan = 1; chan <= 4; ++chan)
       {
-        visitor.OnPerformanceTest(PerformanceTest(chan));
+        visitor.OnPerformanceTest(PerformanceTest(chan, false));
+        visitor.OnPerformanceTest(PerformanceTest(chan, true));
+      }
+    }
+  }
+
+  namespace Templates
+  {
+    const Time::Milliseconds TEST_DURATION(1000);
+
+    class PerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      PerformanceTest(String templ, Mode mode)
+        : Template(std::move(templ))
+        , TestMode(mode)
+      {
+      }
+
+      std::string Category() const override
+      {
+        return "String templates (M/s)";
+      }
+
+      std::string Name() const override
+      {
+        static const char* const MODES[] = {"reparse", "compiled", "compiled to buffer"};
+        return (boost::format("%1% (%2%)") % Template % MODES[TestMode]).str();
+      }
+
+      double Execute() const override
+      {
+        return Test(Template, TestMode, TEST_DURATION);
+      }
+    private:
+      const String Template;
+      const Mode TestMode;
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      //xtractor and file backends defaults
+      const String templates[] = {"XTractor/[Filename]/[Subpath]", "[Subpath]_[Title].wav"};
+      for (const auto& templ : templates)
+      {
+        visitor.OnPerformanceTest(PerformanceTest(templ, REPARSE));
+        visitor.OnPerformanceTest(PerformanceTest(templ, COMPILED));
+        visitor.OnPerformanceTest(PerformanceTest(templ, COMPILED_BUFFER));
+      }
+    }
+  }
+
+  namespace Parameters
+  {
+    const Time::Milliseconds TEST_DURATION(1000);
+
+    class PerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      explicit PerformanceTest(Mode mode)
+        : TestMode(mode)
+      {
+      }
+
+      std::string Category() const override
+      {
+        return "Parameters (M/s)";
+      }
+
+      std::string Name() const override
+      {
+        static const char* const MODES[] = {"name construction", "container lookup", "merged lookup"};
+        return MODES[TestMode];
+      }
+
+      double Execute() const override
+      {
+        return Test(TestMode, TEST_DURATION);
+      }
+    private:
+      const Mode TestMode;
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      visitor.OnPerformanceTest(PerformanceTest(NAME));
+      visitor.OnPerformanceTest(PerformanceTest(CONTAINER_LOOKUP));
+      visitor.OnPerformanceTest(PerformanceTest(MERGED_LOOKUP));
+    }
+  }
+
+  namespace Packed
+  {
+    const Time::Milliseconds TEST_DURATION(1000);
+
+    const char* const SAMPLES[] =
+    {
+      "cc3/test1.cc3",
+      "cc3/test2.cc3",
+      "dsq/test.dsq",
+      "esv/test.esv",
+      "gam/test1.gam",
+      "gam/test2.gam",
+      "gam/test3.gamplus",
+      "hrum/sample1.hrm",
+      "hrum/sample2.hrm",
+      "hrust1/no_depacker.bin",
+      "hrust1/with_depacker.bin",
+      "hrust2/HotA!r.p",
+      "hrust2/LokMyEye.p",
+      "lzs/test1.lzs",
+      "msp/test1.msp",
+      "msp/test2.msp",
+      "pcd/ver6_1.pcd",
+      "pcd/ver6_2.pcd",
+      "tlz/test.tlz",
+      "tlz/test.tlzp",
+      "trush/test.trs",
+    };
+
+    class DecodeTest : public Benchmark::PerformanceTest
+    {
+    public:
+      DecodeTest(Formats::Packed::Decoder::Ptr decoder, std::string sample, Binary::Container::Ptr data)
+        : Decoder(std::move(decoder))
+        , Sample(std::move(sample))
+        , Data(std::move(data))
+      {
+      }
+
+      std::string Category() const override
+      {
+        return "Packed data decoding (MB/s)";
+      }
+
+      std::string Name() const override
+      {
+        return (boost::format("%1% (%2%)") % Decoder->GetDescription() % Sample).str();
+      }
+
+      double Execute() const override
+      {
+        return TestDecode(*Decoder, *Data, TEST_DURATION);
+      }
+    private:
+      const Formats::Packed::Decoder::Ptr Decoder;
+      const std::string Sample;
+      const Binary::Container::Ptr Data;
+    };
+
+    class ScanTest : public Benchmark::PerformanceTest
+    {
+    public:
+      ScanTest(const DecodersArray& decoders, Binary::Container::Ptr data)
+        : Decoders(decoders)
+        , Data(std::move(data))
+      {
+      }
+
+      std::string Category() const override
+      {
+        return "Packed data decoding (MB/s)";
+      }
+
+      std::string Name() const override
+      {
+        return (boost::format("Raw scan of %1% bytes by %2% decoders") % Data->Size() % Decoders.size()).str();
+      }
+
+      double Execute() const override
+      {
+        return TestScan(Decoders, *Data, TEST_DURATION);
+      }
+    private:
+      const DecodersArray& Decoders;
+      const Binary::Container::Ptr Data;
+    };
+
+    void ForAllTests(const std::string& samplesPath, TestsVisitor& visitor)
+    {
+      const DecodersArray decoders = CreateDecoders();
+      std::unique_ptr<Dump> allSamples(new Dump());
+      for (const auto sample : SAMPLES)
+      {
+        const Binary::Container::Ptr data = OpenSample(samplesPath + '/' + sample);
+        if (!data)
+        {
+          continue;
+        }
+        const uint8_t* const content = static_cast<const uint8_t*>(data->Start());
+        allSamples->insert(allSamples->end(), content, content + data->Size());
+        const auto decoder = std::find_if(decoders.begin(), decoders.end(),
+          [&data](const Formats::Packed::Decoder::Ptr& decoder) {return !!decoder->Decode(*data);});
+        if (decoder != decoders.end())
+        {
+          visitor.OnPerformanceTest(DecodeTest(*decoder, sample, data));
+        }
+      }
+      if (!allSamples->empty())
+      {
+        visitor.OnPerformanceTest(ScanTest(decoders, Binary::CreateContainer(std::move(allSamples))));
       }
     }
   }
@@ -207,6 +509,15 @@ namespace Benchmark
   {
     AY::ForAllTests(visitor);
     Z80::ForAllTests(visitor);
+    DAC::ForAllTests(visitor);
+    TFM::ForAllTests(visitor);
     Mixer::ForAllTests(visitor);
+    Templates::ForAllTests(visitor);
+    Parameters::ForAllTests(visitor);
+  }
+
+  void ForPackedDataTests(const std::string& samplesPath, TestsVisitor& visitor)
+  {
+    Packed::ForAllTests(samplesPath, visitor);
   }
 }
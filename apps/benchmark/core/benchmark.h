@@ -37,4 +37,6 @@ namespace Benchmark
   };
 
   void ForAllTests(TestsVisitor& visitor);
+  //! @param samplesPath directory with packed samples (samples/packed in source tree)
+  void ForPackedDataTests(const std::string& samplesPath, TestsVisitor& visitor);
 }
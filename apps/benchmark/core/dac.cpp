@@ -0,0 +1,155 @@
+/**
+* 
+* @file
+*
+* @brief  DAC test implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "dac.h"
+//common includes
+#include <make_ptr.h>
+//library includes
+#include <sound/matrix_mixer.h>
+#include <time/timer.h>
+//std includes
+#include <cmath>
+
+namespace
+{
+  const uint_t CHANNELS = 4;
+  const uint_t SAMPLES = 8;
+
+  class DACParameters : public Devices::DAC::ChipParameters
+  {
+  public:
+    DACParameters(uint_t soundFreq, uint_t samplesFreq, bool interpolate)
+      : Sound(soundFreq)
+      , Samples(samplesFreq)
+      , Interpolation(interpolate)
+    {
+    }
+
+    uint_t Version() const override
+    {
+      return 1;
+    }
+
+    uint_t BaseSampleFreq() const override
+    {
+      return Samples;
+    }
+
+    uint_t SoundFreq() const override
+    {
+      return Sound;
+    }
+
+    bool Interpolate() const override
+    {
+      return Interpolation;
+    }
+  private:
+    const uint_t Sound;
+    const uint_t Samples;
+    const bool Interpolation;
+  };
+
+  //single sine period with optional loop
+  class SineSample : public Devices::DAC::Sample
+  {
+  public:
+    SineSample(std::size_t size, std::size_t loop)
+      : Content(size)
+      , LoopPos(loop)
+    {
+      for (std::size_t idx = 0; idx != size; ++idx)
+      {
+        Content[idx] = static_cast<Sound::Sample::Type>(Sound::Sample::MAX * std::sin(6.28318530718 * idx / size));
+      }
+    }
+
+    Sound::Sample::Type Get(std::size_t pos) const override
+    {
+      return Content[pos];
+    }
+
+    std::size_t Size() const override
+    {
+      return Content.size();
+    }
+
+    std::size_t Loop() const override
+    {
+      return LoopPos;
+    }
+
+    uint_t Rms() const override
+    {
+      return Sound::Sample::MAX / 2;
+    }
+  private:
+    std::vector<Sound::Sample::Type> Content;
+    const std::size_t LoopPos;
+  };
+}
+
+namespace Benchmark
+{
+  namespace DAC
+  {
+    Devices::DAC::Chip::Ptr CreateDevice(uint_t soundFreq, uint_t samplesFreq, bool interpolate)
+    {
+      const Devices::DAC::ChipParameters::Ptr params = MakePtr<DACParameters>(soundFreq, samplesFreq, interpolate);
+      const Devices::DAC::Chip::Ptr result = Devices::DAC::CreateChip(params, Sound::FourChannelsMatrixMixer::Create(), Sound::Receiver::CreateStub());
+      for (uint_t idx = 0; idx != SAMPLES; ++idx)
+      {
+        const std::size_t size = 256 << (idx % 4);
+        //odd samples are not looped
+        result->SetSample(idx, MakePtr<SineSample>(size, idx % 2 ? size : 0));
+      }
+      return result;
+    }
+
+    double Test(Devices::DAC::Chip& dev, const Time::Milliseconds& duration, const Time::Microseconds& frameDuration)
+    {
+      using namespace Devices::DAC;
+      const Time::Timer timer;
+      const Stamp period = frameDuration;
+      const uint_t frames = Stamp(duration).Get() / period.Get();
+      DataChunk chunk;
+      chunk.Data.resize(CHANNELS);
+      for (uint_t chan = 0; chan != CHANNELS; ++chan)
+      {
+        ChannelData& data = chunk.Data[chan];
+        data.Channel = chan;
+        data.Enabled = true;
+        data.Level = Devices::LevelType(chan + 1, CHANNELS);
+      }
+      for (uint_t frame = 0; frame != frames; ++frame)
+      {
+        for (uint_t chan = 0; chan != CHANNELS; ++chan)
+        {
+          ChannelData& data = chunk.Data[chan];
+          data.Mask = ChannelData::NOTESLIDE;
+          data.NoteSlide = (frame + chan) % 8;
+          //retrigger notes every 16 frames
+          if (0 == (frame + 4 * chan) % 16)
+          {
+            data.Mask |= ChannelData::ENABLED | ChannelData::NOTE | ChannelData::SAMPLENUM | ChannelData::POSINSAMPLE | ChannelData::LEVEL;
+            data.Note = 24 + (frame / 16 + chan * 5) % 36;
+            data.SampleNum = (frame / 16 + chan) % SAMPLES;
+            data.PosInSample = 0;
+          }
+        }
+        chunk.TimeStamp += period;
+        dev.RenderData(chunk);
+      }
+      const Stamp elapsed = timer.Elapsed();
+      return double(chunk.TimeStamp.Get()) / elapsed.Get();
+    }
+  }
+}
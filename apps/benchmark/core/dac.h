@@ -0,0 +1,23 @@
+/**
+* 
+* @file
+*
+* @brief  DAC test interface
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <devices/dac.h>
+
+namespace Benchmark
+{
+  namespace DAC
+  {
+    Devices::DAC::Chip::Ptr CreateDevice(uint_t soundFreq, uint_t samplesFreq, bool interpolate);
+    double Test(Devices::DAC::Chip& dev, const Time::Milliseconds& duration, const Time::Microseconds& frameDuration);
+  }
+}
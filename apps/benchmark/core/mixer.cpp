@@ -13,6 +13,8 @@
 //library includes
 #include <sound/matrix_mixer.h>
 #include <time/timer.h>
+//std includes
+#include <vector>
 
 namespace Benchmark
 {
@@ -35,6 +37,29 @@ namespace Benchmark
       return double(emulated.Get()) / elapsed.Get();
     }
 
+    template<unsigned Channels>
+    double TestBlock(const Time::Milliseconds& duration, uint_t soundFreq, uint_t blockSize)
+    {
+      const typename Sound::FixedChannelsMixer<Channels>::Ptr mixer = Sound::FixedChannelsMatrixMixer<Channels>::Create();
+
+      std::vector<Sound::Sample::Type> input(Channels * blockSize);
+      typename Sound::FixedChannelsMixer<Channels>::InBlockType planes;
+      for (uint_t chan = 0; chan != Channels; ++chan)
+      {
+        planes[chan] = &input[chan * blockSize];
+      }
+      std::vector<Sound::Sample> output(blockSize);
+      const Time::Timer timer;
+      const uint_t totalFrames = uint64_t(duration.Get()) * soundFreq / duration.PER_SECOND;
+      for (uint_t frame = 0; frame < totalFrames; frame += blockSize)
+      {
+        mixer->ApplyBlock(planes, blockSize, &output[0]);
+      }
+      const Time::Nanoseconds elapsed = timer.Elapsed();
+      const Time::Nanoseconds emulated(duration);
+      return double(emulated.Get()) / elapsed.Get();
+    }
+
     double Test(uint_t channels, const Time::Milliseconds& duration, uint_t soundFreq)
     {
       switch (channels)
@@ -51,5 +76,22 @@ namespace Benchmark
         return 0;
       }
     }
+
+    double TestBlock(uint_t channels, const Time::Milliseconds& duration, uint_t soundFreq, uint_t blockSize)
+    {
+      switch (channels)
+      {
+      case 1:
+        return TestBlock<1>(duration, soundFreq, blockSize);
+      case 2:
+        return TestBlock<2>(duration, soundFreq, blockSize);
+      case 3:
+        return TestBlock<3>(duration, soundFreq, blockSize);
+      case 4:
+        return TestBlock<4>(duration, soundFreq, blockSize);
+      default:
+        return 0;
+      }
+    }
   }
 }
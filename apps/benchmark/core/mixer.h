@@ -18,5 +18,7 @@ namespace Benchmark
   namespace Mixer
   {
     double Test(uint_t channels, const Time::Milliseconds& duration, uint_t soundFreq);
+    //planar input is mixed by blocks of @blockSize samples
+    double TestBlock(uint_t channels, const Time::Milliseconds& duration, uint_t soundFreq, uint_t blockSize);
   }
 }
@@ -0,0 +1,139 @@
+/**
+* 
+* @file
+*
+* @brief  Packed data decoding test implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "packed.h"
+//common includes
+#include <pointers.h>
+//library includes
+#include <binary/container_factories.h>
+#include <formats/packed/decoders.h>
+#include <time/timer.h>
+//std includes
+#include <fstream>
+
+namespace Benchmark
+{
+  namespace Packed
+  {
+    DecodersArray CreateDecoders()
+    {
+      using namespace Formats::Packed;
+      DecodersArray result;
+      result.push_back(CreateCodeCruncher3Decoder());
+      result.push_back(CreateCompressorCode4Decoder());
+      result.push_back(CreateCompressorCode4PlusDecoder());
+      result.push_back(CreateDataSquieezerDecoder());
+      result.push_back(CreateESVCruncherDecoder());
+      result.push_back(CreateHrumDecoder());
+      result.push_back(CreateHrust1Decoder());
+      result.push_back(CreateHrust21Decoder());
+      result.push_back(CreateHrust23Decoder());
+      result.push_back(CreateLZSDecoder());
+      result.push_back(CreateMSPackDecoder());
+      result.push_back(CreatePowerfullCodeDecreaser61Decoder());
+      result.push_back(CreatePowerfullCodeDecreaser61iDecoder());
+      result.push_back(CreatePowerfullCodeDecreaser62Decoder());
+      result.push_back(CreateTRUSHDecoder());
+      result.push_back(CreateGamePackerDecoder());
+      result.push_back(CreateGamePackerPlusDecoder());
+      result.push_back(CreateTurboLZDecoder());
+      result.push_back(CreateTurboLZProtectedDecoder());
+      result.push_back(CreateCharPresDecoder());
+      result.push_back(CreatePack2Decoder());
+      result.push_back(CreateLZH1Decoder());
+      result.push_back(CreateLZH2Decoder());
+      result.push_back(CreateMegaLZDecoder());
+      return result;
+    }
+
+    Binary::Container::Ptr OpenSample(const std::string& path)
+    {
+      std::ifstream stream(path.c_str(), std::ios::binary);
+      if (!stream)
+      {
+        return Binary::Container::Ptr();
+      }
+      stream.seekg(0, std::ios_base::end);
+      std::unique_ptr<Dump> content(new Dump(static_cast<std::size_t>(stream.tellg())));
+      stream.seekg(0);
+      stream.read(safe_ptr_cast<char*>(content->data()), content->size());
+      return stream && !content->empty()
+        ? Binary::CreateContainer(std::move(content))
+        : Binary::Container::Ptr();
+    }
+
+    double GetMegabytesPerSecond(uint64_t bytes, const Time::Timer& timer)
+    {
+      const Time::Microseconds elapsed = timer.Elapsed();
+      return double(bytes) / elapsed.Get();
+    }
+
+    double TestDecode(const Formats::Packed::Decoder& decoder, const Binary::Container& data, const Time::Milliseconds& duration)
+    {
+      const Time::Timer timer;
+      uint64_t decoded = 0;
+      do
+      {
+        if (const Formats::Packed::Container::Ptr result = decoder.Decode(data))
+        {
+          decoded += result->Size();
+        }
+        else
+        {
+          return 0;
+        }
+      }
+      while (timer.Elapsed() < duration);
+      return GetMegabytesPerSecond(decoded, timer);
+    }
+
+    uint64_t Scan(const Formats::Packed::Decoder& decoder, const Binary::Container& data)
+    {
+      const Binary::Format::Ptr format = decoder.GetFormat();
+      const std::size_t size = data.Size();
+      uint64_t decoded = 0;
+      for (std::size_t offset = 0; offset < size; )
+      {
+        const Binary::Container::Ptr rest = data.GetSubcontainer(offset, size - offset);
+        if (!format->Match(*rest))
+        {
+          offset += format->NextMatchOffset(*rest);
+        }
+        else if (const Formats::Packed::Container::Ptr result = decoder.Decode(*rest))
+        {
+          decoded += result->Size();
+          offset += result->PackedSize();
+        }
+        else
+        {
+          ++offset;
+        }
+      }
+      return decoded;
+    }
+
+    double TestScan(const DecodersArray& decoders, const Binary::Container& data, const Time::Milliseconds& duration)
+    {
+      const Time::Timer timer;
+      uint64_t scanned = 0;
+      do
+      {
+        for (const auto& decoder : decoders)
+        {
+          Scan(*decoder, data);
+        }
+        scanned += data.Size();
+      }
+      while (timer.Elapsed() < duration);
+      return GetMegabytesPerSecond(scanned, timer);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+/**
+* 
+* @file
+*
+* @brief  Packed data decoding test interface
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//common includes
+#include <types.h>
+//library includes
+#include <formats/packed.h>
+#include <time/stamp.h>
+//std includes
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+  namespace Packed
+  {
+    typedef std::vector<Formats::Packed::Decoder::Ptr> DecodersArray;
+
+    //LZ-based ZX packers
+    DecodersArray CreateDecoders();
+    //@return empty pointer if failed
+    Binary::Container::Ptr OpenSample(const std::string& path);
+    //@return decoded megabytes per second
+    double TestDecode(const Formats::Packed::Decoder& decoder, const Binary::Container& data, const Time::Milliseconds& duration);
+    //@return scanned megabytes per second trying all the decoders at every matched offset like raw scanner does
+    double TestScan(const DecodersArray& decoders, const Binary::Container& data, const Time::Milliseconds& duration);
+  }
+}
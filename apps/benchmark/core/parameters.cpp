@@ -0,0 +1,85 @@
+/**
+* 
+* @file
+*
+* @brief  Parameters access test implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "parameters.h"
+//library includes
+#include <parameters/container.h>
+#include <parameters/merged_accessor.h>
+#include <time/timer.h>
+//std includes
+#include <vector>
+
+namespace Benchmark
+{
+  namespace Parameters
+  {
+    const std::size_t ITERATIONS_PER_CHECK = 1000;
+    const std::size_t NAMES_COUNT = 64;
+
+    std::vector<std::string> MakePaths()
+    {
+      std::vector<std::string> result;
+      for (std::size_t idx = 0; idx != NAMES_COUNT; ++idx)
+      {
+        result.push_back("zxtune.sound.backends.option" + std::to_string(idx));
+      }
+      return result;
+    }
+
+    //every container keeps every third name, so lookups walk through the whole merged chain for some names
+    ::Parameters::Container::Ptr MakeContainer(const std::vector< ::Parameters::NameType>& names, std::size_t start)
+    {
+      const ::Parameters::Container::Ptr result = ::Parameters::Container::Create();
+      for (std::size_t idx = start; idx < names.size(); idx += 3)
+      {
+        result->SetValue(names[idx], ::Parameters::IntType(idx));
+      }
+      return result;
+    }
+
+    double Test(Mode mode, const Time::Milliseconds& duration)
+    {
+      const std::vector<std::string> paths = MakePaths();
+      const std::vector< ::Parameters::NameType> names(paths.begin(), paths.end());
+      const ::Parameters::Container::Ptr first = MakeContainer(names, 0);
+      const ::Parameters::Container::Ptr second = MakeContainer(names, 1);
+      const ::Parameters::Container::Ptr third = MakeContainer(names, 2);
+      const ::Parameters::Accessor::Ptr merged = ::Parameters::CreateMergedAccessor(first, second, third);
+      std::size_t found = 0;
+      uint64_t operations = 0;
+      const Time::Timer timer;
+      do
+      {
+        for (std::size_t idx = 0; idx != ITERATIONS_PER_CHECK; ++idx)
+        {
+          const std::size_t nameIdx = idx % NAMES_COUNT;
+          ::Parameters::IntType val = 0;
+          switch (mode)
+          {
+          case NAME:
+            found += ::Parameters::NameType(paths[nameIdx]) == names[nameIdx];
+            break;
+          case CONTAINER_LOOKUP:
+            found += first->FindValue(names[nameIdx], val);
+            break;
+          case MERGED_LOOKUP:
+            found += merged->FindValue(names[nameIdx], val);
+            break;
+          }
+        }
+        operations += ITERATIONS_PER_CHECK;
+      }
+      while (timer.Elapsed() < duration);
+      const Time::Microseconds elapsed = timer.Elapsed();
+      return found ? double(operations) / elapsed.Get() : 0;
+    }
+  }
+}
@@ -0,0 +1,33 @@
+/**
+* 
+* @file
+*
+* @brief  Parameters access test interface
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <time/stamp.h>
+
+namespace Benchmark
+{
+  namespace Parameters
+  {
+    enum Mode
+    {
+      //name construction from string
+      NAME,
+      //lookup in plain container
+      CONTAINER_LOOKUP,
+      //lookup in merged accessor, typical for module properties
+      MERGED_LOOKUP
+    };
+
+    //@return millions of operations per second
+    double Test(Mode mode, const Time::Milliseconds& duration);
+  }
+}
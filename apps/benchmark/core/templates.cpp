@@ -0,0 +1,83 @@
+/**
+* 
+* @file
+*
+* @brief  String templates test implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "templates.h"
+//library includes
+#include <strings/fields.h>
+#include <strings/template.h>
+#include <time/timer.h>
+
+namespace Benchmark
+{
+  namespace Templates
+  {
+    //typical values of extracted files names fields
+    class FieldsSource : public Strings::SkipFieldsSource
+    {
+    public:
+      String GetFieldValue(const String& fieldName) const override
+      {
+        if (fieldName == "Filename")
+        {
+          return "collection.trd";
+        }
+        else if (fieldName == "Path")
+        {
+          return "/home/user/music/collection.trd";
+        }
+        else if (fieldName == "Subpath")
+        {
+          return "+12288/TRD/song.C/+0";
+        }
+        else if (fieldName == "Title")
+        {
+          return "Some song title";
+        }
+        return Strings::SkipFieldsSource::GetFieldValue(fieldName);
+      }
+    };
+
+    const std::size_t ITERATIONS_PER_CHECK = 1000;
+
+    double Test(const String& templ, Mode mode, const Time::Milliseconds& duration)
+    {
+      const FieldsSource source;
+      const Strings::Template::Ptr compiled = Strings::Template::Create(templ);
+      String buffer;
+      std::size_t totalSize = 0;
+      uint64_t instantiations = 0;
+      const Time::Timer timer;
+      do
+      {
+        for (std::size_t idx = 0; idx != ITERATIONS_PER_CHECK; ++idx)
+        {
+          switch (mode)
+          {
+          case REPARSE:
+            totalSize += Strings::Template::Instantiate(templ, source).size();
+            break;
+          case COMPILED:
+            totalSize += compiled->Instantiate(source).size();
+            break;
+          case COMPILED_BUFFER:
+            compiled->Instantiate(source, buffer);
+            totalSize += buffer.size();
+            break;
+          }
+        }
+        instantiations += ITERATIONS_PER_CHECK;
+      }
+      while (timer.Elapsed() < duration);
+      const Time::Microseconds elapsed = timer.Elapsed();
+      return totalSize ? double(instantiations) / elapsed.Get() : 0;
+    }
+  }
+}
@@ -0,0 +1,35 @@
+/**
+* 
+* @file
+*
+* @brief  String templates test interface
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//common includes
+#include <types.h>
+//library includes
+#include <time/stamp.h>
+
+namespace Benchmark
+{
+  namespace Templates
+  {
+    enum Mode
+    {
+      //template is parsed at every instantiation
+      REPARSE,
+      //compiled template, new string for every result
+      COMPILED,
+      //compiled template, single buffer for all the results
+      COMPILED_BUFFER
+    };
+
+    //@return millions of instantiations per second
+    double Test(const String& templ, Mode mode, const Time::Milliseconds& duration);
+  }
+}
@@ -0,0 +1,116 @@
+/**
+* 
+* @file
+*
+* @brief  TFM test implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "tfm.h"
+//common includes
+#include <make_ptr.h>
+//library includes
+#include <time/timer.h>
+
+namespace
+{
+  class TFMParameters : public Devices::TFM::ChipParameters
+  {
+  public:
+    TFMParameters(uint64_t clockFreq, uint_t soundFreq, Devices::FM::EngineType engine)
+      : Clock(clockFreq)
+      , Sound(soundFreq)
+      , Emulation(engine)
+    {
+    }
+
+    uint_t Version() const override
+    {
+      return 1;
+    }
+
+    uint64_t ClockFreq() const override
+    {
+      return Clock;
+    }
+
+    uint_t SoundFreq() const override
+    {
+      return Sound;
+    }
+
+    Devices::FM::EngineType Engine() const override
+    {
+      return Emulation;
+    }
+  private:
+    const uint64_t Clock;
+    const uint_t Sound;
+    const Devices::FM::EngineType Emulation;
+  };
+}
+
+namespace Benchmark
+{
+  namespace TFM
+  {
+    Devices::TFM::Chip::Ptr CreateDevice(uint64_t clockFreq, uint_t soundFreq, Devices::FM::EngineType engine)
+    {
+      const Devices::TFM::ChipParameters::Ptr params = MakePtr<TFMParameters>(clockFreq, soundFreq, engine);
+      return Devices::TFM::CreateChip(params, Sound::Receiver::CreateStub());
+    }
+
+    double Test(Devices::TFM::Chip& dev, const Time::Milliseconds& duration, const Time::Microseconds& frameDuration)
+    {
+      using namespace Devices::TFM;
+      const Time::Timer timer;
+      DataChunk chunk;
+      //all the channels use all the algorithms with different envelopes
+      for (uint_t chip = 0; chip != CHIPS; ++chip)
+      {
+        for (uint_t chan = 0; chan != 3; ++chan)
+        {
+          const uint_t voice = chip * 3 + chan;
+          for (uint_t op = 0; op != 4; ++op)
+          {
+            const uint_t base = chan + op * 4;
+            chunk.Data.push_back(Register(chip, 0x30 + base, 0x01 + op));
+            chunk.Data.push_back(Register(chip, 0x40 + base, op == 3 ? 0x00 : 0x18 + voice));
+            chunk.Data.push_back(Register(chip, 0x50 + base, 0x1f));
+            chunk.Data.push_back(Register(chip, 0x60 + base, 0x04 + voice));
+            chunk.Data.push_back(Register(chip, 0x70 + base, 0x02));
+            chunk.Data.push_back(Register(chip, 0x80 + base, 0x27 + (op << 4)));
+          }
+          chunk.Data.push_back(Register(chip, 0xb0 + chan, voice | ((voice & 3) << 3)));
+        }
+      }
+      dev.RenderData(chunk);
+      const Stamp period = frameDuration;
+      const uint_t frames = Stamp(duration).Get() / period.Get();
+      for (uint_t val = 0; val != frames; ++val)
+      {
+        chunk.Data.clear();
+        //new note on some channel every two frames
+        if (0 == (val & 1))
+        {
+          const uint_t voice = (val >> 1) % VOICES;
+          const uint_t chip = voice / 3;
+          const uint_t chan = voice % 3;
+          const uint_t freq = 0x200 + ((val * 0x35) & 0x1ff);
+          const uint_t octave = 2 + (val >> 4) % 4;
+          chunk.Data.push_back(Register(chip, 0x28, chan));
+          chunk.Data.push_back(Register(chip, 0xa4 + chan, (octave << 3) | (freq >> 8)));
+          chunk.Data.push_back(Register(chip, 0xa0 + chan, freq & 0xff));
+          chunk.Data.push_back(Register(chip, 0x28, 0xf0 | chan));
+        }
+        chunk.TimeStamp += period;
+        dev.RenderData(chunk);
+      }
+      const Stamp elapsed = timer.Elapsed();
+      return double(chunk.TimeStamp.Get()) / elapsed.Get();
+    }
+  }
+}
@@ -31,8 +31,16 @@ namespace
   };
 }
 
-int main()
+int main(int argc, char* argv[])
 {
   ExecuteTestsVisitor visitor;
-  Benchmark::ForAllTests(visitor);
+  //packed samples path is optional
+  if (argc > 1)
+  {
+    Benchmark::ForPackedDataTests(argv[1], visitor);
+  }
+  else
+  {
+    Benchmark::ForAllTests(visitor);
+  }
 }
@@ -13,21 +13,28 @@
 #include "../zxtune.h"
 //common includes
 #include <contract.h>
-#include <cycle_buffer.h>
 #include <error_tools.h>
 #include <progress_callback.h>
 #include <make_ptr.h>
 //library includes
+#include <async/shared_workers.h>
 #include <binary/container.h>
 #include <binary/container_factories.h>
 #include <core/core_parameters.h>
-#include <core/module_open.h>
+#include <core/module_registry.h>
 #include <module/holder.h>
 #include <parameters/container.h>
 #include <platform/version/api.h>
 #include <sound/sound_parameters.h>
 //std includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <vector>
 //boost includes
 #include <boost/bind.hpp>
 
@@ -47,6 +54,8 @@ namespace
     }
   };
 
+  //objects are shared between calls, so handle removal does not affect calls in progress
+  //the same object may be added several times (e.g. shared module) and should be deleted the same times count
   template<class PtrType>
   class HandlesCache
   {
@@ -55,20 +64,52 @@ namespace
     {
       const ZXTuneHandle result = ObjectTraits<PtrType>::GetHandle(val);
       Require(result != ZXTuneHandle());
-      Require(Handles.insert(typename Handle2Object::value_type(result, val)).second);
+      const std::lock_guard<std::mutex> lock(Guard);
+      Entry& entry = Handles[result];
+      Require(!entry.Object || entry.Object == val);
+      entry.Object = std::move(val);
+      ++entry.References;
       return result;
     }
 
     void Delete(ZXTuneHandle handle)
     {
-      Handles.erase(handle);
+      PtrType val;
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        const typename Handle2Object::iterator it = Handles.find(handle);
+        if (it == Handles.end() || --it->second.References)
+        {
+          return;
+        }
+        val.swap(it->second.Object);
+        Handles.erase(it);
+      }
+      //object is released out of lock
     }
 
     PtrType Get(ZXTuneHandle handle) const
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       const typename Handle2Object::const_iterator it = Handles.find(handle);
       Require(it != Handles.end());
-      return it->second;
+      return it->second.Object;
+    }
+
+    //resolves all the handles atomically, unknown ones are reported as empty objects
+    std::vector<PtrType> Get(const std::vector<ZXTuneHandle>& handles) const
+    {
+      std::vector<PtrType> result(handles.size());
+      const std::lock_guard<std::mutex> lock(Guard);
+      for (std::size_t idx = 0; idx != handles.size(); ++idx)
+      {
+        const typename Handle2Object::const_iterator it = Handles.find(handles[idx]);
+        if (it != Handles.end())
+        {
+          result[idx] = it->second.Object;
+        }
+      }
+      return result;
     }
 
     static HandlesCache<PtrType>& Instance()
@@ -77,7 +118,18 @@ namespace
       return self;
     }
   private:
-    typedef std::map<ZXTuneHandle, PtrType> Handle2Object;
+    struct Entry
+    {
+      Entry()
+        : References()
+      {
+      }
+
+      PtrType Object;
+      std::size_t References;
+    };
+    typedef std::map<ZXTuneHandle, Entry> Handle2Object;
+    mutable std::mutex Guard;
     Handle2Object Handles;
   };
 
@@ -88,65 +140,129 @@ namespace
   static_assert(Sound::Sample::BITS == 16, "Incompatible sound sample bits count");
   static_assert(Sound::Sample::MID == 0, "Incompatible sound sample type");
 
-  class BufferRender : public Sound::Receiver
+  //@return pointer to the next output sample
+  typedef void* (*SamplesConverter)(const Sound::Sample* in, std::size_t count, void* out);
+
+  void* ConvertToS16(const Sound::Sample* in, std::size_t count, void* out)
   {
-  public:
-    typedef std::shared_ptr<BufferRender> Ptr;
+    std::memcpy(out, in, count * sizeof(*in));
+    return static_cast<Sound::Sample*>(out) + count;
+  }
 
-    BufferRender()
-      : Buffer(32768)
-      , DoneSamples()
+  void* ConvertToFloat(const Sound::Sample* in, std::size_t count, void* out)
+  {
+    const float SCALE = 1.0f / 32768;
+    float* target = static_cast<float*>(out);
+    for (const Sound::Sample* const lim = in + count; in != lim; ++in)
     {
+      *target++ = SCALE * in->Left();
+      *target++ = SCALE * in->Right();
     }
+    return target;
+  }
 
-    void ApplyData(const Sound::Chunk::Ptr& data) override
+  SamplesConverter GetConverter(ZXTuneSampleFormat format)
+  {
+    switch (format)
     {
-      Buffer.Put(data->begin(), data->size());
+    case ZXTUNE_SAMPLE_S16:
+      return &ConvertToS16;
+    case ZXTUNE_SAMPLE_FLOAT:
+      return &ConvertToFloat;
+    default:
+      Require(false);
+      return 0;
     }
+  }
 
-    void Flush() override
+  //Puts rendered data directly to the caller's buffer.
+  //Only the part of frame not fitted to the buffer is kept (as the chunk itself) till the next call.
+  class DirectRender : public Sound::Receiver
+  {
+  public:
+    typedef std::shared_ptr<DirectRender> Ptr;
+
+    DirectRender()
+      : Target()
+      , TargetSize()
+      , Convert()
+      , PendingOffset()
+      , DoneSamples()
     {
     }
 
-    std::size_t GetCurrentSample() const
+    void ApplyData(Sound::Chunk::Ptr data) override
+    {
+      if (Pending)
+      {
+        const std::size_t size = Pending->size();
+        Pending->resize(size + data->size());
+        std::copy(data->data(), data->data() + data->size(), Pending->data() + size);
+        return;
+      }
+      const std::size_t toPut = Put(data->data(), data->size());
+      if (toPut != data->size())
+      {
+        Pending = std::move(data);
+        PendingOffset = toPut;
+      }
+    }
+
+    void Flush() override
     {
-      return DoneSamples;
     }
 
-    std::size_t GetSamples(std::size_t count, Sound::Sample* target)
+    //@param convert null to drop data
+    void SetTarget(void* target, std::size_t samples, SamplesConverter convert)
     {
-      const Sound::Sample* part1 = 0;
-      std::size_t part1Size = 0;
-      const Sound::Sample* part2 = 0;
-      std::size_t part2Size = 0;
-      if (const std::size_t toGet = Buffer.Peek(count, part1, part1Size, part2, part2Size))
+      Target = target;
+      TargetSize = samples;
+      Convert = convert;
+      if (Pending)
       {
-        std::memcpy(target, part1, part1Size * sizeof(*part1));
-        if (part2)
+        PendingOffset += Put(Pending->data() + PendingOffset, Pending->size() - PendingOffset);
+        if (PendingOffset == Pending->size())
         {
-          std::memcpy(target + part1Size, part2, part2Size * sizeof(*part2));
+          Pending.reset();
         }
-        Buffer.Consume(toGet);
-        DoneSamples += toGet;
-        return toGet;
       }
-      return 0;
     }
 
-    std::size_t DropSamples(std::size_t count)
+    bool HasSpace() const
+    {
+      return TargetSize != 0;
+    }
+
+    std::size_t GetCurrentSample() const
     {
-      const std::size_t toDrop = Buffer.Consume(count);
-      DoneSamples += toDrop;
-      return toDrop;
+      return DoneSamples;
     }
 
     void Reset()
     {
-      Buffer.Reset();
+      Target = 0;
+      TargetSize = 0;
+      Pending.reset();
       DoneSamples = 0;
     }
   private:
-    CycleBuffer<Sound::Sample> Buffer;
+    std::size_t Put(const Sound::Sample* data, std::size_t count)
+    {
+      const std::size_t toPut = std::min(count, TargetSize);
+      if (toPut && Convert)
+      {
+        Target = Convert(data, toPut, Target);
+      }
+      TargetSize -= toPut;
+      DoneSamples += toPut;
+      return toPut;
+    }
+  private:
+    void* Target;
+    std::size_t TargetSize;
+    SamplesConverter Convert;
+    Sound::Chunk::Ptr Pending;
+    std::size_t PendingOffset;
     std::size_t DoneSamples;
   };
 
@@ -155,28 +271,22 @@ namespace
   public:
     typedef std::shared_ptr<PlayerWrapper> Ptr;
 
-    PlayerWrapper(Parameters::Container::Ptr params, Module::Renderer::Ptr renderer, BufferRender::Ptr buffer)
-      : Params(params)
-      , Renderer(renderer)
-      , Buffer(buffer)
+    PlayerWrapper(Parameters::Container::Ptr params, Module::Renderer::Ptr renderer, DirectRender::Ptr buffer)
+      : Params(std::move(params))
+      , Renderer(std::move(renderer))
+      , Buffer(std::move(buffer))
     {
     }
 
-    std::size_t RenderSound(Sound::Sample* target, std::size_t samples)
+    std::size_t RenderSound(void* target, std::size_t samples, ZXTuneSampleFormat format)
     {
-      std::size_t result = 0;
-      while (samples)
+      const std::size_t start = Buffer->GetCurrentSample();
+      Buffer->SetTarget(target, samples, GetConverter(format));
+      while (Buffer->HasSpace() && Renderer->RenderFrame())
       {
-        const std::size_t got = Buffer->GetSamples(samples, target);
-        target += got;
-        samples -= got;
-        result += got;
-        if (0 == samples || !Renderer->RenderFrame())
-        {
-          break;
-        }
       }
-      return result;
+      Buffer->SetTarget(0, 0, 0);
+      return Buffer->GetCurrentSample() - start;
     }
 
     std::size_t Seek(std::size_t samples)
@@ -185,18 +295,11 @@ namespace
       {
         Reset();
       }
-      while (samples != Buffer->GetCurrentSample())
+      Buffer->SetTarget(0, samples - Buffer->GetCurrentSample(), 0);
+      while (Buffer->HasSpace() && Renderer->RenderFrame())
       {
-        const std::size_t toDrop = samples - Buffer->GetCurrentSample();
-        if (const std::size_t dropped = Buffer->DropSamples(toDrop))
-        {
-          continue;
-        }
-        if (!Renderer->RenderFrame())
-        {
-          break;
-        }
       }
+      Buffer->SetTarget(0, 0, 0);
       return Buffer->GetCurrentSample();
     }
 
@@ -216,18 +319,126 @@ namespace
       const Parameters::Container::Ptr params = Parameters::Container::Create();
       //copy initial properties
       holder->GetModuleProperties()->Process(*params);
-      const BufferRender::Ptr buffer = MakePtr<BufferRender>();
+      const DirectRender::Ptr buffer = MakePtr<DirectRender>();
       const Module::Renderer::Ptr renderer = holder->CreateRenderer(params, buffer);
       return MakePtr<PlayerWrapper>(params, renderer, buffer);
     }
   private:
     const Parameters::Container::Ptr Params;
     const Module::Renderer::Ptr Renderer;
-    const BufferRender::Ptr Buffer;
+    const DirectRender::Ptr Buffer;
   };
 
   typedef HandlesCache<PlayerWrapper::Ptr> PlayersCache;
 
+  int RenderSound(PlayerWrapper& player, void* buffer, std::size_t samples, ZXTuneSampleFormat format)
+  {
+    try
+    {
+      Require(buffer != 0 || samples == 0);
+      return static_cast<int>(player.RenderSound(buffer, samples, format));
+    }
+    catch (const Error&)
+    {
+      return -1;
+    }
+    catch (const std::exception&)
+    {
+      return -1;
+    }
+  }
+
+  //requests are grouped by player, groups are rendered concurrently by shared workers and calling thread
+  class RenderBatch
+  {
+  public:
+    typedef std::shared_ptr<RenderBatch> Ptr;
+
+    RenderBatch(ZXTuneRenderRequest* requests, std::size_t count)
+      : Requests(requests)
+      , Order(count)
+      , Next(0)
+      , Done(0)
+    {
+      std::vector<ZXTuneHandle> handles(count);
+      for (std::size_t idx = 0; idx != count; ++idx)
+      {
+        handles[idx] = requests[idx].Player;
+        Order[idx] = idx;
+      }
+      Players = PlayersCache::Instance().Get(handles);
+      //keep requests order for the same player
+      std::stable_sort(Order.begin(), Order.end(),
+        [&handles](std::size_t lh, std::size_t rh) {return handles[lh] < handles[rh];});
+      for (std::size_t idx = 0; idx != count; ++idx)
+      {
+        if (idx == 0 || handles[Order[idx]] != handles[Order[idx - 1]])
+        {
+          Groups.push_back(idx);
+        }
+      }
+      Groups.push_back(count);
+    }
+
+    std::size_t GetGroupsCount() const
+    {
+      return Groups.size() - 1;
+    }
+
+    void Process()
+    {
+      const std::size_t total = GetGroupsCount();
+      std::size_t processed = 0;
+      for (std::size_t grp; (grp = Next++) < total; ++processed)
+      {
+        for (std::size_t idx = Groups[grp], lim = Groups[grp + 1]; idx != lim; ++idx)
+        {
+          Render(Order[idx]);
+        }
+      }
+      if (processed)
+      {
+        const std::lock_guard<std::mutex> lock(Mutex);
+        Done += processed;
+        if (Done == total)
+        {
+          Condition.notify_all();
+        }
+      }
+    }
+
+    std::size_t Wait()
+    {
+      {
+        std::unique_lock<std::mutex> lock(Mutex);
+        Condition.wait(lock, [this] () {return Done == GetGroupsCount();});
+      }
+      std::size_t succeed = 0;
+      for (std::size_t idx = 0; idx != Order.size(); ++idx)
+      {
+        succeed += Requests[idx].Result >= 0;
+      }
+      return succeed;
+    }
+  private:
+    void Render(std::size_t idx)
+    {
+      ZXTuneRenderRequest& req = Requests[idx];
+      req.Result = Players[idx]
+        ? RenderSound(*Players[idx], req.Buffer, req.Samples, req.Format)
+        : -1;
+    }
+  private:
+    ZXTuneRenderRequest* const Requests;
+    std::vector<PlayerWrapper::Ptr> Players;
+    std::vector<std::size_t> Order;
+    std::vector<std::size_t> Groups;
+    std::atomic<std::size_t> Next;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::size_t Done;
+  };
+
   bool FindDefaultValue(const Parameters::NameType& name, Parameters::IntType& value)
   {
     typedef std::pair<Parameters::NameType, Parameters::IntType> Name2Val;
@@ -277,7 +488,8 @@ ZXTuneHandle ZXTune_OpenModule(ZXTuneHandle data)
   {
     const Parameters::Container::Ptr params = Parameters::Container::Create();
     const Binary::Container::Ptr src = ContainersCache::Instance().Get(data);
-    const Module::Holder::Ptr result = Module::Open(*params, *src);
+    //modules with the same content are shared between callers
+    const Module::Holder::Ptr result = Module::Registry::Instance().Open(*params, src, String());
     return ModulesCache::Instance().Add(result);
   }
   catch (const Error&)
@@ -345,13 +557,17 @@ void ZXTune_DestroyPlayer(ZXTuneHandle player)
   PlayersCache::Instance().Delete(player);
 }
 
-// returns actually rendered bytes
 int ZXTune_RenderSound(ZXTuneHandle player, void* buffer, size_t samples)
+{
+  return ZXTune_RenderSoundTo(player, buffer, samples, ZXTUNE_SAMPLE_S16);
+}
+
+int ZXTune_RenderSoundTo(ZXTuneHandle player, void* buffer, size_t samples, ZXTuneSampleFormat format)
 {
   try
   {
     const PlayerWrapper::Ptr wrapper = PlayersCache::Instance().Get(player);
-    return wrapper->RenderSound(static_cast<Sound::Sample*>(buffer), samples);
+    return RenderSound(*wrapper, buffer, samples, format);
   }
   catch (const Error&)
   {
@@ -363,12 +579,38 @@ int ZXTune_RenderSound(ZXTuneHandle player, void* buffer, size_t samples)
   }
 }
 
+size_t ZXTune_RenderSoundBatch(ZXTuneRenderRequest* requests, size_t count)
+{
+  try
+  {
+    Require(requests != 0 || count == 0);
+    const RenderBatch::Ptr batch = MakePtr<RenderBatch>(requests, count);
+    Async::SharedWorkers& workers = Async::SharedWorkers::Instance();
+    const std::size_t groups = batch->GetGroupsCount();
+    //calling thread processes groups too
+    for (std::size_t helpers = std::min(workers.Size(), groups ? groups - 1 : 0); helpers; --helpers)
+    {
+      workers.Execute(std::bind(&RenderBatch::Process, batch));
+    }
+    batch->Process();
+    return batch->Wait();
+  }
+  catch (const Error&)
+  {
+    return 0;
+  }
+  catch (const std::exception&)
+  {
+    return 0;
+  }
+}
+
 int ZXTune_SeekSound(ZXTuneHandle player, size_t sample)
 {
   try
   {
     const PlayerWrapper::Ptr wrapper = PlayersCache::Instance().Get(player);
-    return wrapper->Seek(sample);
+    return static_cast<int>(wrapper->Seek(sample));
   }
   catch (const Error&)
   {
@@ -15,6 +15,7 @@
 #include <types.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 namespace
 {
@@ -52,9 +53,43 @@ int main(int argc, char* argv[])
     std::cout << "Opening module" << std::endl;
     const ZXTuneHandle module = ZXTune_OpenModule(data);
     Require(module);
+    std::cout << "Opening shared module" << std::endl;
+    const ZXTuneHandle data2 = ZXTune_CreateData(&dump.front(), dump.size());
+    Require(data2 && data2 != data);
+    const ZXTuneHandle module2 = ZXTune_OpenModule(data2);
+    Require(module2 == module);
+    ZXTune_CloseData(data2);
+    ZXTune_CloseModule(module2);
     std::cout << "Creating player" << std::endl;
     ZXTuneHandle player = ZXTune_CreatePlayer(module);
     Require(player);
+    std::cout << "Rendering" << std::endl;
+    std::vector<short> s16(2 * 1000);
+    Require(ZXTune_RenderSound(player, &s16.front(), 1000) == 1000);
+    std::cout << "Rendering batch" << std::endl;
+    const ZXTuneHandle player2 = ZXTune_CreatePlayer(module);
+    Require(player2);
+    std::vector<short> s16batch(2 * 1000);
+    std::vector<float> fltbatch(2 * 1000);
+    ZXTuneRenderRequest requests[] =
+    {
+      {player, &s16batch.front(), 1000, ZXTUNE_SAMPLE_S16, 0},
+      {player2, &fltbatch.front(), 1000, ZXTUNE_SAMPLE_FLOAT, 0},
+      {0, &s16batch.front(), 1000, ZXTUNE_SAMPLE_S16, 0},
+    };
+    Require(ZXTune_RenderSoundBatch(requests, 3) == 2);
+    Require(requests[0].Result == 1000 && requests[1].Result == 1000 && requests[2].Result < 0);
+    //second player is started from the beginning
+    for (std::size_t idx = 0; idx != s16.size(); ++idx)
+    {
+      Require(static_cast<int>(fltbatch[idx] * 32768) == s16[idx]);
+    }
+    Require(ZXTune_SeekSound(player, 0) == 0);
+    ZXTune_DestroyPlayer(player2);
+    ZXTune_DestroyPlayer(player);
+    ZXTune_CloseModule(module);
+    ZXTune_CloseData(data);
+    std::cout << "Done" << std::endl;
   }
   catch (const std::exception&)
   {
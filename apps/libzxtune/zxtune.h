@@ -31,6 +31,17 @@ extern "C" {
 #define ZXTUNE_API ZXTUNE_API_IMPORT
 #endif
 
+/*
+  Thread safety:
+  - all the functions may be called concurrently from any threads;
+  - data, module and player handles are stored in synchronized registries, so objects may be created and closed
+    from different threads; closed object is released after the last call using it is finished;
+  - module may be shared between any number of players, each of them keeps own playback state;
+  - modules opened from the same content are shared process-wide, so the same handle may be returned several times,
+    each of them should be closed;
+  - every single player should not be used by several threads simultaneously (call-side serialization required).
+*/
+
 // universal handle type
 typedef const void* ZXTuneHandle;
 
@@ -61,13 +72,43 @@ ZXTUNE_API bool ZXTune_GetModuleInfo(ZXTuneHandle module, ZXTuneModuleInfo* info
 // Players operating
 ZXTUNE_API ZXTuneHandle ZXTune_CreatePlayer(ZXTuneHandle module);
 ZXTUNE_API void ZXTune_DestroyPlayer(ZXTuneHandle player);
-// returns actually rendered bytes
+// renders interleaved 16-bit signed stereo samples, returns actually rendered samples count or -1 on error
 ZXTUNE_API int ZXTune_RenderSound(ZXTuneHandle player, void* buffer, size_t samples);
 ZXTUNE_API int ZXTune_SeekSound(ZXTuneHandle player, size_t sample);
 ZXTUNE_API bool ZXTune_ResetSound(ZXTuneHandle player);
 ZXTUNE_API bool ZXTune_GetPlayerParameterInt(ZXTuneHandle player, const char* paramName, int* paramValue);
 ZXTUNE_API bool ZXTune_SetPlayerParameterInt(ZXTuneHandle player, const char* paramName, int paramValue);
 
+// Direct rendering
+// Output sample rate is controlled by "zxtune.sound.frequency" player parameter
+typedef enum
+{
+  // interleaved 16-bit signed stereo (L,R)
+  ZXTUNE_SAMPLE_S16 = 0,
+  // interleaved 32-bit float stereo (L,R) in range [-1.0, 1.0)
+  ZXTUNE_SAMPLE_FLOAT = 1
+} ZXTuneSampleFormat;
+
+// renders samples in specified format directly into buffer, no intermediate buffering is performed except of tail of
+// the last rendered frame; returns actually rendered samples count (less than requested at the end of playback) or -1 on error
+ZXTUNE_API int ZXTune_RenderSoundTo(ZXTuneHandle player, void* buffer, size_t samples, ZXTuneSampleFormat format);
+
+typedef struct
+{
+  // in
+  ZXTuneHandle Player;
+  void* Buffer;
+  size_t Samples;
+  ZXTuneSampleFormat Format;
+  // out: the same as ZXTune_RenderSoundTo result
+  int Result;
+} ZXTuneRenderRequest;
+
+// renders several players per call, all the handles are resolved at once
+// requests for different players are rendered concurrently, requests for the same player are rendered sequentially in order
+// returns count of successfully processed requests, failed ones have negative Result
+ZXTUNE_API size_t ZXTune_RenderSoundBatch(ZXTuneRenderRequest* requests, size_t count);
+
 #ifdef __cplusplus
 } //extern
 #endif
@@ -10,6 +10,8 @@
 
 
 //common includes
+#include <crc.h>
+#include <error_tools.h>
 #include <progress_callback.h>
 #include <make_ptr.h>
 //library includes
@@ -17,6 +19,7 @@
 #include <analysis/result.h>
 #include <analysis/scanner.h>
 #include <async/data_receiver.h>
+#include <binary/data_adapter.h>
 #include <binary/format_factories.h>
 #include <debug/log.h>
 #include <formats/archived/decoders.h>
@@ -28,15 +31,20 @@
 #include <io/impl/boost_filesystem_path.h>
 #include <parameters/container.h>
 #include <platform/application.h>
+#include <platform/tools.h>
 #include <platform/version/api.h>
 #include <strings/array.h>
 #include <strings/fields.h>
 #include <strings/format.h>
 #include <strings/template.h>
 //std includes
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <iostream>
 #include <locale>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <set>
 //boost includes
@@ -47,6 +55,8 @@
 //text includes
 #include "text/text.h"
 
+#define FILE_TAG 29767CAE
+
 namespace
 {
   const Debug::Stream Dbg("XTractor");
@@ -62,15 +72,17 @@ namespace Analysis
 
     //! Name to distinguish. Can be empty
     virtual String Name() const = 0;
-    //! Data associated with. Cannot be empty
+    //! Data associated with. Cannot be empty except parent nodes
     virtual Binary::Container::Ptr Data() const = 0;
-    //! Parent node. Ptr() if root node
+    //! Parent node. Ptr() if root node. Parents do not keep data to release it as soon as node is processed
     virtual Ptr Parent() const = 0;
   };
 
   Node::Ptr CreateRootNode(Binary::Container::Ptr data, const String& name);
   Node::Ptr CreateSubnode(Node::Ptr parent, Binary::Container::Ptr data, const String& name);
   Node::Ptr CreateSubnode(Node::Ptr parent, Binary::Container::Ptr data, std::size_t offset);
+  //! @return Node with the same path and without data
+  Node::Ptr CreatePathNode(Node::Ptr node);
 }
 
 namespace
@@ -103,6 +115,34 @@ namespace
     const String NameVal;
   };
 
+  class PathNode : public Analysis::Node
+  {
+  public:
+    PathNode(Analysis::Node::Ptr parent, String name)
+      : ParentVal(std::move(parent))
+      , NameVal(std::move(name))
+    {
+    }
+
+    String Name() const override
+    {
+      return NameVal;
+    }
+
+    Binary::Container::Ptr Data() const override
+    {
+      return Binary::Container::Ptr();
+    }
+
+    Analysis::Node::Ptr Parent() const override
+    {
+      return ParentVal;
+    }
+  private:
+    const Analysis::Node::Ptr ParentVal;
+    const String NameVal;
+  };
+
   class SubNode : public Analysis::Node
   {
   public:
@@ -142,19 +182,26 @@ namespace Analysis
     return MakePtr<RootNode>(std::move(data), name);
   }
 
+  Node::Ptr CreatePathNode(Node::Ptr node)
+  {
+    return node->Data()
+      ? MakePtr<PathNode>(node->Parent(), node->Name())
+      : node;
+  }
+
   Node::Ptr CreateSubnode(Node::Ptr parent, Binary::Container::Ptr data, const String& name)
   {
-    return MakePtr<SubNode>(std::move(parent), std::move(data), name);
+    return MakePtr<SubNode>(CreatePathNode(std::move(parent)), std::move(data), name);
   }
 
   Node::Ptr CreateSubnode(Node::Ptr parent, Binary::Container::Ptr data, std::size_t offset)
   {
-    return MakePtr<SubNode>(std::move(parent), std::move(data), Strings::Format("+%1%", offset));
+    return MakePtr<SubNode>(CreatePathNode(std::move(parent)), std::move(data), Strings::Format("+%1%", offset));
   }
 
   Node::Ptr CreateSubnode(Node::Ptr parent, Binary::Container::Ptr data, const String& name, std::size_t offset)
   {
-    auto intermediate = CreateSubnode(parent, data, offset);
+    auto intermediate = MakePtr<PathNode>(CreatePathNode(std::move(parent)), Strings::Format("+%1%", offset));
     return CreateSubnode(std::move(intermediate), std::move(data), name);
   }
 }
@@ -376,6 +423,170 @@ namespace
     const Parameters::Container::Ptr Params;
   };
 
+  //64-bit hash independent of crc32 to distinguish content without reading stored data
+  uint64_t GetHash64(const Binary::Data& data)
+  {
+    const uint64_t MULTIPLIER = UINT64_C(0x9e3779b97f4a7c15);
+    const uint8_t* const start = static_cast<const uint8_t*>(data.Start());
+    const std::size_t size = data.Size();
+    uint64_t hash = size * MULTIPLIER;
+    std::size_t pos = 0;
+    for (; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t))
+    {
+      uint64_t word;
+      std::memcpy(&word, start + pos, sizeof(word));
+      hash = (hash ^ word) * MULTIPLIER;
+      hash ^= hash >> 29;
+    }
+    for (; pos != size; ++pos)
+    {
+      hash = (hash ^ start[pos]) * MULTIPLIER;
+      hash ^= hash >> 29;
+    }
+    return hash;
+  }
+
+  //stores each unique content once, found items are listed in manifest.
+  //Blobs index is not persistent, so directory should not contain results of previous runs
+  class DeduplicatedSaveTarget : public Parsing::Target
+  {
+  public:
+    DeduplicatedSaveTarget(String dir, bool verify)
+      : Dir(std::move(dir))
+      , Verify(verify)
+      , Params(Parameters::Container::Create())
+      , Total(0)
+      , TotalSize(0)
+      , Unique(0)
+      , SavedSize(0)
+    {
+      const boost::filesystem::path path(Dir);
+      if (boost::filesystem::exists(path) && !(boost::filesystem::is_directory(path) && boost::filesystem::is_empty(path)))
+      {
+        throw MakeFormattedError(THIS_LINE, Text::DEDUP_DIR_NOT_EMPTY, Dir);
+      }
+      //never overwrite anything
+      Params->SetValue(Parameters::ZXTune::IO::Providers::File::OVERWRITE_EXISTING, 0);
+      Manifest = IO::CreateStream(GetPath(Text::DEDUP_MANIFEST_NAME), *Params, Log::ProgressCallback::Stub());
+    }
+
+    void ApplyData(Parsing::Result::Ptr result) override
+    {
+      try
+      {
+        const Binary::Container::Ptr data = result->Data();
+        const String line = Store(*data) + '\t' + result->Name() + '\n';
+        const std::lock_guard<std::mutex> lock(Guard);
+        Manifest->ApplyData(Binary::DataAdapter(line.data(), line.size()));
+      }
+      catch (const Error& e)
+      {
+        std::cout << e.ToString();
+      }
+    }
+
+    void Flush() override
+    {
+      Manifest->Flush();
+      std::cout << Strings::Format(Text::DEDUP_OUTPUT, Total, TotalSize, Unique, SavedSize) << std::endl;
+    }
+  private:
+    typedef std::pair<std::size_t, uint32_t> Key;
+
+    struct Slot
+    {
+      typedef std::shared_ptr<Slot> Ptr;
+
+      std::mutex Guard;
+      //by stored file index
+      std::vector<uint64_t> Hashes;
+    };
+
+    String Store(const Binary::Data& data)
+    {
+      const Key key(data.Size(), Crc32(static_cast<const uint8_t*>(data.Start()), data.Size()));
+      const Slot::Ptr slot = GetSlot(key);
+      //concurrent stores of the same content are waiting for the first one
+      const std::lock_guard<std::mutex> lock(slot->Guard);
+      const uint64_t hash = GetHash64(data);
+      for (std::size_t idx = 0, lim = slot->Hashes.size(); idx != lim; ++idx)
+      {
+        if (slot->Hashes[idx] != hash)
+        {
+          continue;
+        }
+        const String name = GetBlobName(key, idx);
+        if (!Verify || IsStored(name, data))
+        {
+          Account(key.first, false);
+          return name;
+        }
+      }
+      const String name = GetBlobName(key, slot->Hashes.size());
+      const Binary::OutputStream::Ptr target = IO::CreateStream(GetPath(name), *Params, Log::ProgressCallback::Stub());
+      target->ApplyData(data);
+      slot->Hashes.push_back(hash);
+      Account(key.first, true);
+      return name;
+    }
+
+    Slot::Ptr GetSlot(const Key& key)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Slot::Ptr& result = Slots[key];
+      if (!result)
+      {
+        result = MakePtr<Slot>();
+      }
+      return result;
+    }
+
+    //optional paranoid check of matched hashes by content comparison with already stored data
+    bool IsStored(const String& name, const Binary::Data& data) const
+    {
+      const Binary::Container::Ptr stored = IO::OpenData(GetPath(name), *Params, Log::ProgressCallback::Stub());
+      return stored->Size() == data.Size()
+          && 0 == std::memcmp(stored->Start(), data.Start(), data.Size());
+    }
+
+    void Account(std::size_t size, bool stored)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      ++Total;
+      TotalSize += size;
+      if (stored)
+      {
+        ++Unique;
+      }
+      else
+      {
+        SavedSize += size;
+      }
+    }
+
+    static String GetBlobName(const Key& key, std::size_t idx)
+    {
+      const String base = Strings::Format(Text::DEDUP_BLOB_NAME, key.first, key.second);
+      return idx ? base + '_' + std::to_string(idx) : base;
+    }
+
+    String GetPath(const String& name) const
+    {
+      return IO::Details::ToString(boost::filesystem::path(Dir) / name);
+    }
+  private:
+    const String Dir;
+    const bool Verify;
+    const Parameters::Container::Ptr Params;
+    Binary::OutputStream::Ptr Manifest;
+    std::mutex Guard;
+    std::map<Key, Slot::Ptr> Slots;
+    std::size_t Total;
+    uint64_t TotalSize;
+    std::size_t Unique;
+    uint64_t SavedSize;
+  };
+
   class StatisticTarget : public Parsing::Target
   {
   public:
@@ -408,6 +619,11 @@ namespace Parsing
     return MakePtr<SaveTarget>();
   }
 
+  Parsing::Target::Ptr CreateDeduplicatedSaveTarget(const String& dir, bool verify)
+  {
+    return MakePtr<DeduplicatedSaveTarget>(dir, verify);
+  }
+
   Parsing::Target::Ptr CreateStatisticTarget()
   {
     return MakePtr<StatisticTarget>();
@@ -498,6 +714,204 @@ namespace
   };
 }
 
+namespace
+{
+  //total size of data waiting for processing
+  class DataBudget
+  {
+  public:
+    typedef std::shared_ptr<DataBudget> Ptr;
+
+    explicit DataBudget(uint64_t limit)
+      : Limit(limit)
+      , InUse()
+    {
+    }
+
+    //single data bigger than limit is passed when nothing else is in use
+    void Acquire(uint64_t size)
+    {
+      std::unique_lock<std::mutex> lock(Guard);
+      Released.wait(lock, [this, size]() {return !InUse || InUse + size <= Limit;});
+      InUse += size;
+    }
+
+    //accounts data produced while processing already accounted one, so waiting may deadlock
+    void Charge(uint64_t size)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      InUse += size;
+    }
+
+    void Release(uint64_t size)
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        InUse -= size;
+      }
+      Released.notify_all();
+    }
+  private:
+    const uint64_t Limit;
+    uint64_t InUse;
+    std::mutex Guard;
+    std::condition_variable Released;
+  };
+
+  class BudgetedNode : public Analysis::Node
+  {
+  public:
+    BudgetedNode(Analysis::Node::Ptr delegate, DataBudget::Ptr budget, std::size_t size)
+      : Delegate(std::move(delegate))
+      , Budget(std::move(budget))
+      , Size(size)
+    {
+    }
+
+    ~BudgetedNode() override
+    {
+      Budget->Release(Size);
+    }
+
+    String Name() const override
+    {
+      return Delegate->Name();
+    }
+
+    Binary::Container::Ptr Data() const override
+    {
+      return Delegate->Data();
+    }
+
+    Analysis::Node::Ptr Parent() const override
+    {
+      return Delegate->Parent();
+    }
+  private:
+    const Analysis::Node::Ptr Delegate;
+    const DataBudget::Ptr Budget;
+    const std::size_t Size;
+  };
+
+  //data is kept in temporary file which is removed with the node
+  class SpilledNode : public Analysis::Node
+  {
+  public:
+    SpilledNode(const Analysis::Node& node, String path, Parameters::Accessor::Ptr params)
+      : NameVal(node.Name())
+      , ParentVal(node.Parent())
+      , Path(std::move(path))
+      , Params(std::move(params))
+    {
+    }
+
+    ~SpilledNode() override
+    {
+      boost::system::error_code ec;
+      boost::filesystem::remove(Path, ec);
+    }
+
+    String Name() const override
+    {
+      return NameVal;
+    }
+
+    Binary::Container::Ptr Data() const override
+    {
+      return IO::OpenData(Path, *Params, Log::ProgressCallback::Stub());
+    }
+
+    Analysis::Node::Ptr Parent() const override
+    {
+      return ParentVal;
+    }
+  private:
+    const String NameVal;
+    const Analysis::Node::Ptr ParentVal;
+    const String Path;
+    const Parameters::Accessor::Ptr Params;
+  };
+
+  class DataLimitPoint : public Analysis::NodeReceiver
+  {
+  public:
+    DataLimitPoint(DataBudget::Ptr budget, std::size_t spillSize, const String& spillDir, Analysis::NodeReceiver::Ptr target)
+      : Budget(std::move(budget))
+      , SpillSize(spillSize)
+      , SpillDir(spillDir)
+      , Params(Parameters::Container::Create())
+      , Target(std::move(target))
+      , SpillFailures()
+      , SpillFailuresSize()
+    {
+      Params->SetValue(Parameters::ZXTune::IO::Providers::File::OVERWRITE_EXISTING, 1);
+    }
+
+    void ApplyData(Analysis::Node::Ptr node) override
+    {
+      const std::size_t size = node->Data()->Size();
+      if (SpillSize && size >= SpillSize)
+      {
+        if (auto spilled = Spill(*node))
+        {
+          return Target->ApplyData(std::move(spilled));
+        }
+        ++SpillFailures;
+        SpillFailuresSize += size;
+      }
+      if (Budget)
+      {
+        Budget->Acquire(size);
+        Target->ApplyData(MakePtr<BudgetedNode>(std::move(node), Budget, size));
+      }
+      else
+      {
+        Target->ApplyData(std::move(node));
+      }
+    }
+
+    void Flush() override
+    {
+      Target->Flush();
+      if (SpillFailures)
+      {
+        std::cout << Strings::Format(Text::SPILL_FAILED_OUTPUT, SpillFailures, SpillFailuresSize) << std::endl;
+      }
+    }
+  private:
+    //@return empty pointer if failed, so data is kept in memory
+    Analysis::Node::Ptr Spill(const Analysis::Node& node) const
+    {
+      try
+      {
+        const boost::filesystem::path dir = SpillDir.empty() ? boost::filesystem::temp_directory_path() : boost::filesystem::path(SpillDir);
+        const String path = IO::Details::ToString(boost::filesystem::unique_path(dir / "xtractor-%%%%-%%%%-%%%%-%%%%"));
+        const Binary::OutputStream::Ptr stream = IO::CreateStream(path, *Params, Log::ProgressCallback::Stub());
+        stream->ApplyData(*node.Data());
+        Dbg("Spilled %1% to %2%", node.Name(), path);
+        return MakePtr<SpilledNode>(node, path, Params);
+      }
+      catch (const Error& e)
+      {
+        Dbg("Failed to spill %1%: %2%", node.Name(), e.ToString());
+      }
+      catch (const boost::filesystem::filesystem_error& e)
+      {
+        Dbg("Failed to spill %1%: %2%", node.Name(), e.what());
+      }
+      return Analysis::Node::Ptr();
+    }
+  private:
+    const DataBudget::Ptr Budget;
+    const std::size_t SpillSize;
+    const String SpillDir;
+    const Parameters::Container::Ptr Params;
+    const Analysis::NodeReceiver::Ptr Target;
+    std::atomic<std::size_t> SpillFailures;
+    std::atomic<uint64_t> SpillFailuresSize;
+  };
+}
+
 namespace Analysis
 {
   NodeReceiver::Ptr CreateSizeFilter(std::size_t minSize, NodeReceiver::Ptr target)
@@ -514,6 +928,13 @@ namespace Analysis
   {
     return MakePtr<MatchedDataFilter>(filter, target);
   }
+
+  NodeReceiver::Ptr CreateDataLimit(uint64_t limit, std::size_t spillSize, const String& spillDir, NodeReceiver::Ptr target)
+  {
+    return limit || spillSize
+      ? MakePtr<DataLimitPoint>(limit ? MakePtr<DataBudget>(limit) : DataBudget::Ptr(), spillSize, spillDir, target)
+      : target;
+  }
 }
 
 namespace
@@ -522,7 +943,7 @@ namespace
   {
   public:
     NestedScannerTarget(Analysis::Node::Ptr root, Analysis::NodeReceiver& toScan, Analysis::NodeReceiver& toStore)
-      : Root(std::move(root))
+      : Root(Analysis::CreatePathNode(std::move(root)))
       , ToScan(toScan)
       , ToStore(toStore)
     {
@@ -532,7 +953,7 @@ namespace
     {
       const String name = decoder.GetDescription();
       Dbg("Found %1% in %2% bytes at %3%", name, data->Size(), offset);
-      auto archNode = Analysis::CreateSubnode(Root, std::move(data), name, offset);
+      auto archNode = Analysis::CreateSubnode(Root, data, name, offset);
       const ScanFiles walker(ToScan, std::move(archNode));
       data->ExploreFiles(walker);
     }
@@ -573,7 +994,7 @@ namespace
     public:
       ScanFiles(Analysis::NodeReceiver& toScan, Analysis::Node::Ptr node)
         : ToScan(toScan)
-        , ArchiveNode(std::move(node))
+        , ArchiveNode(Analysis::CreatePathNode(std::move(node)))
       {
       }
 
@@ -600,8 +1021,10 @@ namespace
   class AnalysisTarget : public Analysis::NodeTransceiver
   {
   public:
-    AnalysisTarget()
+    //nested data is accounted in budget without waiting
+    explicit AnalysisTarget(DataBudget::Ptr budget)
       : Scanner(Analysis::CreateScanner())
+      , Nested(std::move(budget), *this)
     {
       Formats::Archived::FillScanner(*Scanner);
       Formats::Packed::FillScanner(*Scanner);
@@ -612,7 +1035,7 @@ namespace
     void ApplyData(Analysis::Node::Ptr node) override
     {
       Dbg("Analyze %1%", node->Name());
-      NestedScannerTarget target(node, *this, *Target);
+      NestedScannerTarget target(node, Nested, *Target);
       try
       {
         Scanner->Scan(node->Data(), target);
@@ -632,8 +1055,37 @@ namespace
     {
       Target = target;
     }
+  private:
+    class NestedPoint : public Analysis::NodeReceiver
+    {
+    public:
+      NestedPoint(DataBudget::Ptr budget, Analysis::NodeReceiver& target)
+        : Budget(std::move(budget))
+        , Target(target)
+      {
+      }
+
+      void ApplyData(Analysis::Node::Ptr node) override
+      {
+        if (Budget)
+        {
+          const std::size_t size = node->Data()->Size();
+          Budget->Charge(size);
+          node = MakePtr<BudgetedNode>(std::move(node), Budget, size);
+        }
+        Target.ApplyData(std::move(node));
+      }
+
+      void Flush() override
+      {
+      }
+    private:
+      const DataBudget::Ptr Budget;
+      Analysis::NodeReceiver& Target;
+    };
   private:
     const Analysis::Scanner::RWPtr Scanner;
+    NestedPoint Nested;
     Analysis::NodeReceiver::Ptr Target;
   };
 }
@@ -907,6 +1359,11 @@ namespace
     virtual std::string FormatFilter() const = 0;
     virtual std::size_t SaveThreadsCount() const = 0;
     virtual std::size_t SaveDataQueueSize() const = 0;
+    virtual uint64_t SaveDataQueueBytes() const = 0;
+    virtual std::size_t SpillSize() const = 0;
+    virtual String SpillDir() const = 0;
+    virtual String DedupDir() const = 0;
+    virtual bool DedupVerify() const = 0;
     virtual bool StatisticOutput() const = 0;
   };
 
@@ -917,13 +1374,15 @@ namespace
 
     virtual std::size_t AnalysisThreads() const = 0;
     virtual std::size_t AnalysisDataQueueSize() const = 0;
+    virtual uint64_t AnalysisDataQueueBytes() const = 0;
   };
 
   Analysis::NodeReceiver::Ptr CreateTarget(const TargetOptions& opts)
   {
+    const String dedupDir = opts.DedupDir();
     const Parsing::Target::Ptr save = opts.StatisticOutput()
       ? Parsing::CreateStatisticTarget()
-      : Parsing::CreateSaveTarget();
+      : (dedupDir.empty() ? Parsing::CreateSaveTarget() : Parsing::CreateDeduplicatedSaveTarget(dedupDir, opts.DedupVerify()));
     const Analysis::NodeReceiver::Ptr makeName = MakePtr<TargetNamePoint>(opts.TargetNameTemplate(), save);
     const Analysis::NodeReceiver::Ptr storeAll = makeName;
     const Analysis::NodeReceiver::Ptr storeNoEmpty = opts.IgnoreEmptyData()
@@ -938,7 +1397,8 @@ namespace
       ? Analysis::CreateMatchFilter(filter, storeEnoughSize)
       : storeEnoughSize;
     const Analysis::NodeReceiver::Ptr result = storeMatchedFilter;
-    return AsyncWrap<Analysis::Node::Ptr>(opts.SaveThreadsCount(), opts.SaveDataQueueSize(), result);
+    const Analysis::NodeReceiver::Ptr queue = AsyncWrap<Analysis::Node::Ptr>(opts.SaveThreadsCount(), opts.SaveDataQueueSize(), result);
+    return Analysis::CreateDataLimit(opts.SaveDataQueueBytes(), opts.SpillSize(), opts.SpillDir(), queue);
   }
 
   template<class InType, class OutType = InType>
@@ -972,8 +1432,14 @@ namespace
 
   Analysis::NodeTransceiver::Ptr CreateAnalyser(const AnalysisOptions& opts)
   {
-    const Analysis::NodeTransceiver::Ptr analyser = MakePtr<AnalysisTarget>();
-    const Analysis::NodeReceiver::Ptr input = AsyncWrap<Analysis::Node::Ptr>(opts.AnalysisThreads(), opts.AnalysisDataQueueSize(), analyser);
+    //both queued and being analysed data including unpacked nested one is accounted, only new input waits
+    const uint64_t limit = opts.AnalysisDataQueueBytes();
+    const DataBudget::Ptr budget = limit ? MakePtr<DataBudget>(limit) : DataBudget::Ptr();
+    const Analysis::NodeTransceiver::Ptr analyser = MakePtr<AnalysisTarget>(budget);
+    const Analysis::NodeReceiver::Ptr queue = AsyncWrap<Analysis::Node::Ptr>(opts.AnalysisThreads(), opts.AnalysisDataQueueSize(), analyser);
+    const Analysis::NodeReceiver::Ptr input = budget
+      ? MakePtr<DataLimitPoint>(budget, 0, String(), queue)
+      : queue;
     return MakePtr<TransceivePipe<Analysis::Node::Ptr> >(input, analyser);
   }
 
@@ -992,13 +1458,20 @@ namespace
     Options()
       : AnalysisThreadsValue(1)
       , AnalysisDataQueueSizeValue(10)
+      , AnalysisDataQueueBytesValue(uint64_t(256) << 20)
       , TargetNameTemplateValue(Text::DEFAULT_TARGET_NAME_TEMPLATE)
       , IgnoreEmptyDataValue(false)
       , MinDataSizeValue(0)
       , FormatFilterValue()
       , SaveThreadsCountValue(1)
       , SaveDataQueueSizeValue(500)
+      , SaveDataQueueBytesValue(uint64_t(256) << 20)
+      , SpillSizeValue(0)
+      , SpillDirValue()
+      , DedupDirValue()
+      , DedupVerifyValue(false)
       , StatisticOutputValue(false)
+      , MemoryUsageValue(false)
       //cmdline
       , OptionsDescription(Text::TARGET_SECTION)
     {
@@ -1006,13 +1479,20 @@ namespace
       OptionsDescription.add_options()
         (Text::ANALYSIS_THREADS_KEY, value<std::size_t>(&AnalysisThreadsValue), Text::ANALYSIS_THREADS_DESC)
         (Text::ANALYSIS_QUEUE_SIZE_KEY, value<std::size_t>(&AnalysisDataQueueSizeValue), Text::ANALYSIS_QUEUE_SIZE_DESC)
+        (Text::ANALYSIS_QUEUE_BYTES_KEY, value<uint64_t>(&AnalysisDataQueueBytesValue), Text::ANALYSIS_QUEUE_BYTES_DESC)
         (Text::TARGET_NAME_TEMPLATE_KEY, value<String>(&TargetNameTemplateValue), Text::TARGET_NAME_TEMPLATE_DESC)
         (Text::IGNORE_EMPTY_KEY, bool_switch(&IgnoreEmptyDataValue), Text::IGNORE_EMPTY_DESC)
         (Text::MINIMAL_SIZE_KEY, value<std::size_t>(&MinDataSizeValue), Text::MINIMAL_SIZE_DESC)
         (Text::FORMAT_FILTER_KEY, value<std::string>(&FormatFilterValue), Text::FORMAT_FILTER_DESC)
         (Text::SAVE_THREADS_KEY, value<std::size_t>(&SaveThreadsCountValue), Text::SAVE_THREADS_DESC)
         (Text::SAVE_QUEUE_SIZE_KEY, value<std::size_t>(&SaveDataQueueSizeValue), Text::SAVE_QUEUE_SIZE_DESC)
+        (Text::SAVE_QUEUE_BYTES_KEY, value<uint64_t>(&SaveDataQueueBytesValue), Text::SAVE_QUEUE_BYTES_DESC)
+        (Text::SPILL_SIZE_KEY, value<std::size_t>(&SpillSizeValue), Text::SPILL_SIZE_DESC)
+        (Text::SPILL_DIR_KEY, value<String>(&SpillDirValue), Text::SPILL_DIR_DESC)
+        (Text::DEDUP_DIR_KEY, value<String>(&DedupDirValue), Text::DEDUP_DIR_DESC)
+        (Text::DEDUP_VERIFY_KEY, bool_switch(&DedupVerifyValue), Text::DEDUP_VERIFY_DESC)
         (Text::OUTPUT_STATISTIC_KEY, bool_switch(&StatisticOutputValue), Text::OUTPUT_STATISTIC_DESC)
+        (Text::MEMORY_USAGE_KEY, bool_switch(&MemoryUsageValue), Text::MEMORY_USAGE_DESC)
        ;
     }
 
@@ -1026,6 +1506,11 @@ namespace
       return AnalysisDataQueueSizeValue;
     }
 
+    uint64_t AnalysisDataQueueBytes() const override
+    {
+      return AnalysisDataQueueBytesValue;
+    }
+
     String TargetNameTemplate() const override
     {
       return TargetNameTemplateValue;
@@ -1056,11 +1541,41 @@ namespace
       return SaveDataQueueSizeValue;
     }
 
+    uint64_t SaveDataQueueBytes() const override
+    {
+      return SaveDataQueueBytesValue;
+    }
+
+    std::size_t SpillSize() const override
+    {
+      return SpillSizeValue;
+    }
+
+    String SpillDir() const override
+    {
+      return SpillDirValue;
+    }
+
+    String DedupDir() const override
+    {
+      return DedupDirValue;
+    }
+
+    bool DedupVerify() const override
+    {
+      return DedupVerifyValue;
+    }
+
     bool StatisticOutput() const override
     {
       return StatisticOutputValue;
     }
 
+    bool MemoryUsage() const
+    {
+      return MemoryUsageValue;
+    }
+
     const boost::program_options::options_description& GetOptionsDescription() const
     {
       return OptionsDescription;
@@ -1068,13 +1583,20 @@ namespace
   private:
     std::size_t AnalysisThreadsValue;
     std::size_t AnalysisDataQueueSizeValue;
+    uint64_t AnalysisDataQueueBytesValue;
     String TargetNameTemplateValue;
     bool IgnoreEmptyDataValue;
     std::size_t MinDataSizeValue;
     std::string FormatFilterValue;
     std::size_t SaveThreadsCountValue;
     std::size_t SaveDataQueueSizeValue;
+    uint64_t SaveDataQueueBytesValue;
+    std::size_t SpillSizeValue;
+    String SpillDirValue;
+    String DedupDirValue;
+    bool DedupVerifyValue;
     bool StatisticOutputValue;
+    bool MemoryUsageValue;
     boost::program_options::options_description OptionsDescription;
   };
 }
@@ -1112,6 +1634,10 @@ public:
 
     std::for_each(paths.begin(), paths.end(), boost::bind(&StringsReceiver::ApplyData, input.get(), _1));
     input->Flush();
+    if (Opts.MemoryUsage())
+    {
+      std::cout << Strings::Format(Text::MEMORY_USAGE_OUTPUT, Platform::GetPeakMemoryUsage()) << std::endl;
+    }
     return 0;
   }
 private:
@@ -3,6 +3,17 @@
 
 namespace Text
 {
+extern const Char ANALYSIS_QUEUE_BYTES_DESC[] = {
+  'l','i','m','i','t',' ','o','f',' ','d','a','t','a',' ','s','i','z','e',' ','i','n',' ','b','y','t','e','s',
+  ' ','w','a','i','t','i','n','g',' ','f','o','r',' ','o','r',' ','b','e','i','n','g',' ','i','n',' ','a','n',
+  'a','l','y','s','i','s',' ','i','n','c','l','u','d','i','n','g',' ','u','n','p','a','c','k','e','d',' ','n',
+  'e','s','t','e','d',' ','d','a','t','a','.',' ','N','e','w',' ','i','n','p','u','t',' ','i','s',' ','s','u',
+  's','p','e','n','d','e','d',' ','w','h','e','n',' ','e','x','c','e','e','d','e','d','.',' ','0',' ','t','o',
+  ' ','d','i','s','a','b','l','e','.',' ','D','e','f','a','u','l','t',' ','i','s',' ','2','5','6','M','b',0
+};
+extern const Char ANALYSIS_QUEUE_BYTES_KEY[] = {
+  'a','n','a','l','y','s','i','s','-','q','u','e','u','e','-','b','y','t','e','s',0
+};
 extern const Char ANALYSIS_QUEUE_SIZE_DESC[] = {
   'q','u','e','u','e',' ','s','i','z','e',' ','f','o','r',' ','p','a','r','a','l','l','e','l',' ','a','n','a',
   'l','y','s','i','s','.',' ','V','a','l','u','a','b','l','e',' ','o','n','l','y',' ','w','h','e','n',' ','-',
@@ -20,6 +31,42 @@ extern const Char ANALYSIS_THREADS_DESC[] = {
 extern const Char ANALYSIS_THREADS_KEY[] = {
   'a','n','a','l','y','s','i','s','-','t','h','r','e','a','d','s',0
 };
+extern const Char DEDUP_BLOB_NAME[] = {
+  '%','1','%','_','%','2','$','0','8','x',0
+};
+extern const Char DEDUP_DIR_DESC[] = {
+  's','t','o','r','e',' ','e','v','e','r','y',' ','u','n','i','q','u','e',' ','d','a','t','a',' ','o','n','l',
+  'y',' ','o','n','c','e',' ','i','n',' ','s','p','e','c','i','f','i','e','d',' ','n','e','w',' ','o','r',' ',
+  'e','m','p','t','y',' ','d','i','r','e','c','t','o','r','y','.',' ','T','a','r','g','e','t',' ','n','a','m',
+  'e','s',' ','a','r','e',' ','l','i','s','t','e','d',' ','i','n',' ','m','a','n','i','f','e','s','t','.','t',
+  'x','t',' ','t','h','e','r','e',' ','i','n','s','t','e','a','d',' ','o','f',' ','s','a','v','i','n','g',0
+};
+extern const Char DEDUP_DIR_KEY[] = {
+  'd','e','d','u','p','-','d','i','r',0
+};
+extern const Char DEDUP_DIR_NOT_EMPTY[] = {
+  'D','e','d','u','p','l','i','c','a','t','i','o','n',' ','d','i','r','e','c','t','o','r','y',' ','\'','%','1',
+  '%','\'',' ','i','s',' ','n','o','t',' ','e','m','p','t','y','.',' ','S','p','e','c','i','f','y',' ','n','e',
+  'w',' ','o','r',' ','e','m','p','t','y',' ','o','n','e',0
+};
+extern const Char DEDUP_MANIFEST_NAME[] = {
+  'm','a','n','i','f','e','s','t','.','t','x','t',0
+};
+extern const Char DEDUP_OUTPUT[] = {
+  '%','1','%',' ','f','i','l','e','s',' ','o','u','t','p','u','t','.',' ','T','o','t','a','l',' ','s','i','z',
+  'e',' ','i','s',' ','%','2','%',' ','b','y','t','e','s','.',' ','S','t','o','r','e','d',' ','%','3','%',' ',
+  'u','n','i','q','u','e',' ','f','i','l','e','s',',',' ','%','4','%',' ','b','y','t','e','s',' ','s','a','v',
+  'e','d',0
+};
+extern const Char DEDUP_VERIFY_DESC[] = {
+  'c','o','m','p','a','r','e',' ','c','o','n','t','e','n','t',' ','o','f',' ','d','a','t','a',' ','m','a','t',
+  'c','h','e','d',' ','b','y',' ','s','i','z','e',' ','a','n','d',' ','h','a','s','h','e','s',' ','w','i','t',
+  'h',' ','a','l','r','e','a','d','y',' ','s','t','o','r','e','d',' ','f','i','l','e','.',' ','V','a','l','u',
+  'a','b','l','e',' ','o','n','l','y',' ','w','i','t','h',' ','-','-','d','e','d','u','p','-','d','i','r',0
+};
+extern const Char DEDUP_VERIFY_KEY[] = {
+  'd','e','d','u','p','-','v','e','r','i','f','y',0
+};
 extern const Char DEFAULT_TARGET_NAME_TEMPLATE[] = {
   'X','T','r','a','c','t','o','r','/','[','F','i','l','e','n','a','m','e',']','/','[','S','u','b','p','a','t',
   'h',']',0
@@ -51,6 +98,17 @@ extern const Char INPUT_DESC[] = {
 extern const Char INPUT_KEY[] = {
   'i','n','p','u','t',0
 };
+extern const Char MEMORY_USAGE_DESC[] = {
+  'r','e','p','o','r','t',' ','p','e','a','k',' ','m','e','m','o','r','y',' ','u','s','a','g','e',' ','a','t',
+  ' ','t','h','e',' ','e','n','d',0
+};
+extern const Char MEMORY_USAGE_KEY[] = {
+  'm','e','m','o','r','y','-','u','s','a','g','e',0
+};
+extern const Char MEMORY_USAGE_OUTPUT[] = {
+  'P','e','a','k',' ','m','e','m','o','r','y',' ','u','s','a','g','e',' ','i','s',' ','%','1','%',' ','b','y',
+  't','e','s',0
+};
 extern const Char MINIMAL_SIZE_DESC[] = {
   'd','o',' ','n','o','t',' ','s','t','o','r','e',' ','f','i','l','e','s',' ','w','i','t','h',' ','l','e','s',
   's','e','r',' ','s','i','z','e','.',' ','D','e','f','a','u','l','t',' ','i','s',' ','0',0
@@ -68,6 +126,16 @@ extern const Char OUTPUT_STATISTIC_KEY[] = {
 extern const Char PROGRAM_NAME[] = {
   'x','t','r','a','c','t','o','r',0
 };
+extern const Char SAVE_QUEUE_BYTES_DESC[] = {
+  'l','i','m','i','t',' ','o','f',' ','d','a','t','a',' ','s','i','z','e',' ','i','n',' ','b','y','t','e','s',
+  ' ','w','a','i','t','i','n','g',' ','f','o','r',' ','s','a','v','i','n','g','.',' ','A','n','a','l','y','s',
+  'i','s',' ','i','s',' ','s','u','s','p','e','n','d','e','d',' ','w','h','e','n',' ','e','x','c','e','e','d',
+  'e','d','.',' ','0',' ','t','o',' ','d','i','s','a','b','l','e','.',' ','D','e','f','a','u','l','t',' ','i',
+  's',' ','2','5','6','M','b',0
+};
+extern const Char SAVE_QUEUE_BYTES_KEY[] = {
+  's','a','v','e','-','q','u','e','u','e','-','b','y','t','e','s',0
+};
 extern const Char SAVE_QUEUE_SIZE_DESC[] = {
   'q','u','e','u','e',' ','s','i','z','e',' ','f','o','r',' ','p','a','r','a','l','l','e','l',' ','d','a','t',
   'a',' ','s','a','v','i','n','g','.',' ','V','a','l','u','a','b','l','e',' ','o','n','l','y',' ','w','h','e',
@@ -85,6 +153,29 @@ extern const Char SAVE_THREADS_DESC[] = {
 extern const Char SAVE_THREADS_KEY[] = {
   's','a','v','e','-','t','h','r','e','a','d','s',0
 };
+extern const Char SPILL_DIR_DESC[] = {
+  'd','i','r','e','c','t','o','r','y',' ','f','o','r',' ','t','e','m','p','o','r','a','r','y',' ','f','i','l',
+  'e','s','.',' ','D','e','f','a','u','l','t',' ','i','s',' ','s','y','s','t','e','m',' ','t','e','m','p','o',
+  'r','a','r','y',' ','d','i','r','e','c','t','o','r','y',0
+};
+extern const Char SPILL_DIR_KEY[] = {
+  's','p','i','l','l','-','d','i','r',0
+};
+extern const Char SPILL_FAILED_OUTPUT[] = {
+  '%','1','%',' ','f','i','l','e','s',' ','(','%','2','%',' ','b','y','t','e','s',')',' ','f','a','i','l','e',
+  'd',' ','t','o',' ','b','e',' ','s','t','o','r','e','d',' ','i','n',' ','t','e','m','p','o','r','a','r','y',
+  ' ','f','i','l','e','s',' ','a','n','d',' ','w','e','r','e',' ','k','e','p','t',' ','i','n',' ','m','e','m',
+  'o','r','y',0
+};
+extern const Char SPILL_SIZE_DESC[] = {
+  'm','i','n','i','m','a','l',' ','d','a','t','a',' ','s','i','z','e',' ','i','n',' ','b','y','t','e','s',' ',
+  't','o',' ','k','e','e','p',' ','i','n',' ','t','e','m','p','o','r','a','r','y',' ','f','i','l','e',' ','w',
+  'h','i','l','e',' ','w','a','i','t','i','n','g',' ','f','o','r',' ','s','a','v','i','n','g','.',' ','0',' ',
+  't','o',' ','d','i','s','a','b','l','e','.',' ','D','e','f','a','u','l','t',' ','i','s',' ','0',0
+};
+extern const Char SPILL_SIZE_KEY[] = {
+  's','p','i','l','l','-','s','i','z','e',0
+};
 extern const Char STATISTIC_OUTPUT[] = {
   '%','1','%',' ','f','i','l','e','s',' ','o','u','t','p','u','t','.',' ','T','o','t','a','l',' ','s','i','z',
   'e',' ','i','s',' ','%','2','%',' ','b','y','t','e','s',0
@@ -3,10 +3,20 @@
 
 namespace Text
 {
+extern const Char ANALYSIS_QUEUE_BYTES_DESC[];
+extern const Char ANALYSIS_QUEUE_BYTES_KEY[];
 extern const Char ANALYSIS_QUEUE_SIZE_DESC[];
 extern const Char ANALYSIS_QUEUE_SIZE_KEY[];
 extern const Char ANALYSIS_THREADS_DESC[];
 extern const Char ANALYSIS_THREADS_KEY[];
+extern const Char DEDUP_BLOB_NAME[];
+extern const Char DEDUP_DIR_DESC[];
+extern const Char DEDUP_DIR_KEY[];
+extern const Char DEDUP_DIR_NOT_EMPTY[];
+extern const Char DEDUP_MANIFEST_NAME[];
+extern const Char DEDUP_OUTPUT[];
+extern const Char DEDUP_VERIFY_DESC[];
+extern const Char DEDUP_VERIFY_KEY[];
 extern const Char DEFAULT_TARGET_NAME_TEMPLATE[];
 extern const Char FORMAT_FILTER_DESC[];
 extern const Char FORMAT_FILTER_KEY[];
@@ -16,15 +26,25 @@ extern const Char IGNORE_EMPTY_DESC[];
 extern const Char IGNORE_EMPTY_KEY[];
 extern const Char INPUT_DESC[];
 extern const Char INPUT_KEY[];
+extern const Char MEMORY_USAGE_DESC[];
+extern const Char MEMORY_USAGE_KEY[];
+extern const Char MEMORY_USAGE_OUTPUT[];
 extern const Char MINIMAL_SIZE_DESC[];
 extern const Char MINIMAL_SIZE_KEY[];
 extern const Char OUTPUT_STATISTIC_DESC[];
 extern const Char OUTPUT_STATISTIC_KEY[];
 extern const Char PROGRAM_NAME[];
+extern const Char SAVE_QUEUE_BYTES_DESC[];
+extern const Char SAVE_QUEUE_BYTES_KEY[];
 extern const Char SAVE_QUEUE_SIZE_DESC[];
 extern const Char SAVE_QUEUE_SIZE_KEY[];
 extern const Char SAVE_THREADS_DESC[];
 extern const Char SAVE_THREADS_KEY[];
+extern const Char SPILL_DIR_DESC[];
+extern const Char SPILL_DIR_KEY[];
+extern const Char SPILL_FAILED_OUTPUT[];
+extern const Char SPILL_SIZE_DESC[];
+extern const Char SPILL_SIZE_KEY[];
 extern const Char STATISTIC_OUTPUT[];
 extern const Char TARGET_NAME_TEMPLATE_DESC[];
 extern const Char TARGET_NAME_TEMPLATE_KEY[];
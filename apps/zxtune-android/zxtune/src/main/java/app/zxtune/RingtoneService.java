@@ -28,15 +28,14 @@ import android.widget.Toast;
 import java.io.File;
 import java.io.IOException;
 import java.io.InvalidObjectException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Locale;
 import java.util.concurrent.TimeUnit;
 
 import app.zxtune.playback.FileIterator;
 import app.zxtune.playback.PlayableItem;
-import app.zxtune.sound.PlayerEventsListener;
 import app.zxtune.sound.SamplesSource;
-import app.zxtune.sound.StubPlayerEventsListener;
-import app.zxtune.sound.SyncPlayer;
 import app.zxtune.sound.WaveWriteSamplesTarget;
 
 public class RingtoneService extends IntentService {
@@ -139,26 +138,43 @@ public class RingtoneService extends IntentService {
     return item.getModule().getProperty("CRC"/*ZXTune.Module.Attributes.CRC*/, item.getDataId().hashCode());
   }
   
-  //TODO: rework errors processing scheme
-  private class NotifyEventsListener extends StubPlayerEventsListener {
-    @Override
-    public void onError(Exception e) {
-      makeToast(e);
-    }
-  }; 
-  
   private void convert(PlayableItem item, TimeStamp limit, File location) throws InvalidObjectException {
     makeToast(getString(R.string.ringtone_create_started), Toast.LENGTH_SHORT);
-    final TimeLimitedSamplesSource source = new TimeLimitedSamplesSource(item.getModule().createPlayer(), limit);
-    final WaveWriteSamplesTarget target = new WaveWriteSamplesTarget(location.getAbsolutePath());
-    final PlayerEventsListener events = new NotifyEventsListener(); 
-    final SyncPlayer player = new SyncPlayer(source, target, events);
+    final ZXTune.Player player = item.getModule().createPlayer();
     try {
-      player.startPlayback();
+      final WaveWriteSamplesTarget target = new WaveWriteSamplesTarget(location.getAbsolutePath());
+      try {
+        render(player, limit, target);
+      } finally {
+        target.release();
+      }
+    } catch (Exception e) {
+      //TODO: rework errors processing scheme
+      makeToast(e);
     } finally {
       player.release();
     }
   }
+
+  //sound data is rendered by native code directly to the memory passed to target, no intermediate java arrays
+  private static void render(ZXTune.Player player, TimeStamp limit, WaveWriteSamplesTarget target) {
+    final int sampleRate = target.getSampleRate();
+    player.setPosition(0);
+    player.setProperty(ZXTune.Properties.Sound.LOOPED, 1);
+    player.setProperty(ZXTune.Properties.Sound.FREQUENCY, sampleRate);
+    final int bufferSize = target.getPreferableBufferSize();
+    final ByteBuffer buf = ByteBuffer.allocateDirect(bufferSize * SamplesSource.Sample.BYTES).order(ByteOrder.nativeOrder());
+    target.start();
+    try {
+      for (long restSamples = limit.convertTo(TimeUnit.SECONDS) * sampleRate;
+           restSamples > 0 && player.render(buf);
+           restSamples -= bufferSize / SamplesSource.Channels.COUNT) {
+        target.writeSamples(buf);
+      }
+    } finally {
+      target.stop();
+    }
+  }
   
   private String setAsRingtone(PlayableItem item, TimeStamp limit, File path) {
     final ContentValues values = createRingtoneData(item, limit, path);
@@ -216,40 +232,4 @@ public class RingtoneService extends IntentService {
     }
     return ringtoneUri;
   }
-  
-  private static class TimeLimitedSamplesSource implements SamplesSource {
-
-    private ZXTune.Player player;
-    private final TimeStamp limit;
-    private int restSamples;
-    
-    public TimeLimitedSamplesSource(ZXTune.Player player, TimeStamp limit) {
-      this.player = player;
-      this.limit = limit;
-      player.setPosition(0);
-      player.setProperty(ZXTune.Properties.Sound.LOOPED, 1);
-    }
-    
-    @Override
-    public void initialize(int sampleRate) {
-      player.setProperty(ZXTune.Properties.Sound.FREQUENCY, sampleRate);
-      restSamples = (int) (limit.convertTo(TimeUnit.SECONDS) * sampleRate);
-    }
-
-    @Override
-    public boolean getSamples(short[] buf) {
-      if (restSamples > 0 && player.render(buf)) {
-        restSamples -= buf.length / SamplesSource.Channels.COUNT;
-        return true;
-      } else {
-        return false;
-      }
-    }
-
-    @Override
-    public void release() {
-      player.release();
-      player = null;
-    }
-  }
 }
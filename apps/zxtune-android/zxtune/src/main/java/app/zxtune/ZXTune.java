@@ -196,6 +196,13 @@ public final class ZXTune {
      * @return Is there more data to render
      */
     boolean render(short[] result);
+
+    /**
+     * Render sound data directly to native memory
+     * @param result Direct buffer with native byte order. Whole capacity is filled, trailing incomplete sample is ignored
+     * @return Is there more data to render
+     */
+    boolean render(ByteBuffer result);
     
     /**
      * @param pos Index of next rendered frame
@@ -391,6 +398,11 @@ public final class ZXTune {
     public boolean render(short[] result) {
       return Player_Render(handle, result);
     }
+
+    @Override
+    public boolean render(ByteBuffer result) {
+      return Player_RenderDirect(handle, result);
+    }
     
     @Override
     public int analyze(int bands[], int levels[]) {
@@ -451,6 +463,7 @@ public final class ZXTune {
 
   // working with player
   private static native boolean Player_Render(int player, short[] result);
+  private static native boolean Player_RenderDirect(int player, ByteBuffer result);
   private static native int Player_Analyze(int player, int bands[], int levels[]);
   private static native int Player_GetPosition(int player);
   private static native void Player_SetPosition(int player, int pos);
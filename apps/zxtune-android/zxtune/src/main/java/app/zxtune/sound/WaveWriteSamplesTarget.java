@@ -13,8 +13,12 @@ package app.zxtune.sound;
 import java.io.FileNotFoundException;
 import java.io.IOException;
 import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.ShortBuffer;
+import java.nio.channels.FileChannel;
 
-public final class WaveWriteSamplesTarget implements SamplesTarget {
+public final class WaveWriteSamplesTarget {
   
   static final int SAMPLERATE = 44100;
   static final int CHANNELS = 1;
@@ -52,30 +56,33 @@ public final class WaveWriteSamplesTarget implements SamplesTarget {
   static final int OFFSET_SAMPLERATE = 24;
   static final int OFFSET_BPS = 28;
   static final int OFFSET_DATA_SIZE = 40;
-  byte buffer[];
   final RandomAccessFile file;
+  final FileChannel channel;
   int doneBytes;
 
   public WaveWriteSamplesTarget(String filename) {
-    this.buffer = new byte[CHANNELS * BYTES_PER_SAMPLE * SAMPLERATE];
     try {
       this.file = new RandomAccessFile(filename, "rw");
     } catch (FileNotFoundException e) {
       throw new RuntimeException(e);
     }
+    this.channel = file.getChannel();
   }
 
-  @Override
+  /**
+   * @return target sample rate in Hz
+   */
   public int getSampleRate() {
     return SAMPLERATE;
   }
 
-  @Override
+  /**
+   * @return buffer size in samples
+   */
   public int getPreferableBufferSize() {
     return SAMPLERATE;//1s buffer
   }
 
-  @Override
   public void start() {
     try {
       file.seek(header.length);
@@ -85,21 +92,25 @@ public final class WaveWriteSamplesTarget implements SamplesTarget {
     doneBytes = 0;
   }
 
-  @Override
-  public void writeSamples(short[] input) {
-    final int inSamples = input.length / SamplesSource.Channels.COUNT;
-    final int outBytes = inSamples * SamplesSource.Sample.BYTES; 
-    allocateBuffer(outBytes);
-    convertBuffer(input, outBytes);
+  /**
+   * @param buffer direct buffer of sound data in S16/stereo/interleaved format with native byte order.
+   *        Content is converted in place
+   */
+  public void writeSamples(ByteBuffer buffer) {
+    final int outBytes = convertBuffer(buffer);
+    buffer.limit(outBytes);
     try {
-      file.write(buffer, 0, outBytes);
+      while (buffer.hasRemaining()) {
+        channel.write(buffer);
+      }
     } catch (IOException e) {
       throw new RuntimeException(e);
+    } finally {
+      buffer.clear();
     }
     doneBytes += outBytes;
   }
 
-  @Override
   public void stop() {
     setHeaderLE32(OFFSET_SAMPLERATE, SAMPLERATE);
     setHeaderLE32(OFFSET_BPS, SAMPLERATE * BYTES_PER_SAMPLE);
@@ -114,29 +125,29 @@ public final class WaveWriteSamplesTarget implements SamplesTarget {
     }
   }
 
-  @Override
   public void release() {
-  }
-  
-  private void allocateBuffer(int size) {
-    if (buffer.length < size) {
-      buffer = new byte[size];
+    try {
+      file.close();
+    } catch (IOException e) {
+      throw new RuntimeException(e);
     }
   }
   
-  private void convertBuffer(short[] input, int outBytes) {
+  //output is never ahead of input, so mono data is stored in place
+  private static int convertBuffer(ByteBuffer buffer) {
     assert BYTES_PER_SAMPLE == 2;
     assert CHANNELS == 1;
-    for (int in = 0, out = 0; out < outBytes; )
-    {
+    final ShortBuffer input = buffer.asShortBuffer();
+    final ShortBuffer output = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN).asShortBuffer();
+    final int samples = input.remaining() / SamplesSource.Channels.COUNT;
+    for (int idx = 0; idx != samples; ++idx) {
       int sample = 0;
       for (int ch = 0; ch != SamplesSource.Channels.COUNT; ++ch) {
-        sample += input[in++];
+        sample += input.get();
       }
-      sample /= SamplesSource.Channels.COUNT;
-      buffer[out++] = (byte) (sample & 0xff);
-      buffer[out++] = (byte) ((sample >> 8) & 0xff);
+      output.put((short) (sample / SamplesSource.Channels.COUNT));
     }
+    return samples * BYTES_PER_SAMPLE;
   }
   
   private void setHeaderLE32(int offset, int value) {
@@ -19,8 +19,8 @@
 #include <error.h>
 //library includes
 #include <binary/container_factories.h>
-#include <core/module_open.h>
 #include <core/module_detect.h>
+#include <core/module_registry.h>
 
 namespace
 {
@@ -29,9 +29,8 @@ namespace
     try
     {
       const Parameters::Accessor::Ptr options = Parameters::GlobalOptions();
-      auto module = subpath.empty()
-          ? Module::Open(*options, *data)
-          : Module::Open(*options, ZXTune::OpenLocation(*options, data, subpath));
+      //modules opened several times (playlist and browser, preview etc) are shared
+      auto module = Module::Registry::Instance().Open(*options, data, subpath);
       Dbg("Module::Create(data=%p, subpath=%s)=%p", data.get(), subpath, module.get());
       return Module::Storage::Instance().Add(std::move(module));
     }
@@ -15,151 +15,11 @@
 #include "player.h"
 #include "properties.h"
 #include "zxtune.h"
-//common includes
-#include <make_ptr.h>
-//library includes
-#include <parameters/merged_accessor.h>
-#include <sound/mixer_factory.h>
 //std includes
-#include <deque>
+#include <algorithm>
 
 namespace
 {
-  static_assert(Sound::Sample::CHANNELS == 2, "Incompatible sound channels count");
-  static_assert(Sound::Sample::BITS == 16, "Incompatible sound sample bits count");
-  static_assert(Sound::Sample::MID == 0, "Incompatible sound sample type");
-
-  class BufferTarget : public Sound::Receiver
-  {
-  public:
-    typedef std::shared_ptr<BufferTarget> Ptr;
-
-    void ApplyData(Sound::Chunk::Ptr data) override
-    {
-      Buffers.emplace_back(std::move(data));
-    }
-
-    void Flush() override
-    {
-    }
-
-    std::size_t GetSamples(std::size_t count, int16_t* target)
-    {
-      if (Buffers.empty())
-      {
-        return 0;
-      }
-      Buff& cur = Buffers.front();
-      const std::size_t samples = count / Sound::Sample::CHANNELS;
-      const std::size_t copied = cur.Get(samples, target);
-      if (0 == cur.Avail)
-      {
-        Buffers.pop_front();
-      }
-      return copied * Sound::Sample::CHANNELS;
-    }
-  private:
-    struct Buff
-    {
-      explicit Buff(Sound::Chunk::Ptr data)
-        : Data(std::move(data))
-        , Avail(Data->size())
-      {
-      }
-      
-      std::size_t Get(std::size_t count, void* target)
-      {
-        const std::size_t toCopy = std::min(count, Avail);
-        std::memcpy(target, &Data->back() + 1 - Avail, toCopy * sizeof(Data->front()));
-        Avail -= toCopy;
-        return toCopy;
-      }
-    
-      Sound::Chunk::Ptr Data;
-      std::size_t Avail;
-    };
-    std::deque<Buff> Buffers;
-  };
-
-  class PlayerControl : public Player::Control
-  {
-  public:
-    PlayerControl(Parameters::Container::Ptr params, Module::Renderer::Ptr render, BufferTarget::Ptr buffer)
-      : Params(std::move(params))
-      , Renderer(std::move(render))
-      , Buffer(std::move(buffer))
-      , TrackState(Renderer->GetTrackState())
-      , Analyser(Renderer->GetAnalyzer())
-    {
-    }
-    
-    uint_t GetPosition() const override
-    {
-      return TrackState->Frame();
-    }
-
-    uint_t Analyze(uint_t maxEntries, uint32_t* bands, uint32_t* levels) const override
-    {
-      const auto& result = Analyser->GetState();
-      uint_t doneEntries = 0;
-      for (auto it = result.begin(), lim = result.end(); it != lim && doneEntries != maxEntries; ++it, ++doneEntries)
-      {
-        bands[doneEntries] = it->Band;
-        levels[doneEntries] = it->Level;
-      }
-      return doneEntries;
-    }
-
-    Parameters::Container::Ptr GetParameters() const override
-    {
-      return Params;
-    }
-    
-    bool Render(uint_t samples, int16_t* buffer) override
-    {
-      for (;;)
-      {
-        if (const std::size_t got = Buffer->GetSamples(samples, buffer))
-        {
-          buffer += got;
-          samples -= got;
-          if (!samples)
-          {
-            break;
-          }
-        }
-        if (!Renderer->RenderFrame())
-        {
-          break;
-        }
-      }
-      std::fill_n(buffer, samples, 0);
-      return samples == 0;
-    }
-
-    void Seek(uint_t frame) override
-    {
-      Renderer->SetPosition(frame);
-    }
-  private:
-    const Parameters::Container::Ptr Params;
-    const Module::Renderer::Ptr Renderer;
-    const BufferTarget::Ptr Buffer;
-    const Module::TrackState::Ptr TrackState;
-    const Module::Analyzer::Ptr Analyser;
-  };
-
-  Player::Control::Ptr CreateControl(Module::Holder::Ptr module)
-  {
-    auto globalParameters = Parameters::GlobalOptions();
-    auto localParameters = Parameters::Container::Create();
-    auto internalProperties = module->GetModuleProperties();
-    auto properties = Parameters::CreateMergedAccessor(localParameters, std::move(internalProperties), std::move(globalParameters));
-    auto buffer = MakePtr<BufferTarget>();
-    auto renderer = module->CreateRenderer(properties, buffer);
-    return MakePtr<PlayerControl>(std::move(localParameters), std::move(renderer), std::move(buffer));
-  }
-
   template<class StorageType, class ResultType>
   class AutoArray
   {
@@ -206,7 +66,7 @@ namespace Player
 {
   Player::Storage::HandleType Create(Module::Holder::Ptr module)
   {
-    auto ctrl = CreateControl(module);
+    auto ctrl = CreateControl(module, Parameters::GlobalOptions());
     Dbg("Player::Create(module=%p)=%p", module.get(), ctrl.get());
     return Player::Storage::Instance().Add(std::move(ctrl));
   }
@@ -226,6 +86,23 @@ JNIEXPORT jboolean JNICALL Java_app_zxtune_ZXTune_Player_1Render
   return false;
 }
 
+JNIEXPORT jboolean JNICALL Java_app_zxtune_ZXTune_Player_1RenderDirect
+  (JNIEnv* env, jclass /*self*/, jint playerHandle, jobject buffer)
+{
+  if (const auto& player = Player::Storage::Instance().Get(playerHandle))
+  {
+    //rendered directly to native memory without pinning java arrays, so no critical section against GC
+    const jlong capacity = env->GetDirectBufferCapacity(buffer);
+    void* const addr = env->GetDirectBufferAddress(buffer);
+    const std::size_t samples = capacity > 0 ? static_cast<std::size_t>(capacity) / sizeof(Sound::Sample) : 0;
+    if (samples && addr)
+    {
+      return player->Render(samples * Sound::Sample::CHANNELS, static_cast<int16_t*>(addr));
+    }
+  }
+  return false;
+}
+
 JNIEXPORT jint JNICALL Java_app_zxtune_ZXTune_Player_1Analyze
   (JNIEnv* env, jclass /*self*/, jint playerHandle, jintArray bands, jintArray levels)
 {
@@ -34,5 +34,8 @@ namespace Player
 
   typedef ObjectsStorage<Control::Ptr> Storage;
 
+  //! Sound data is rendered directly to the memory passed to Control::Render
+  Control::Ptr CreateControl(Module::Holder::Ptr module, Parameters::Accessor::Ptr globalParameters);
+
   Storage::HandleType Create(Module::Holder::Ptr module);
 }
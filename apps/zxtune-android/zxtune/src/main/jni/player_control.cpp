@@ -0,0 +1,169 @@
+/**
+*
+* @file
+*
+* @brief Player control implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "player.h"
+//common includes
+#include <make_ptr.h>
+#include <pointers.h>
+//library includes
+#include <parameters/merged_accessor.h>
+//std includes
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  static_assert(Sound::Sample::CHANNELS == 2, "Incompatible sound channels count");
+  static_assert(Sound::Sample::BITS == 16, "Incompatible sound sample bits count");
+  static_assert(Sound::Sample::MID == 0, "Incompatible sound sample type");
+  static_assert(sizeof(Sound::Sample) == Sound::Sample::CHANNELS * sizeof(int16_t), "Incompatible sound sample layout");
+
+  //Puts rendered data directly to the caller's memory. Only the part of frame not fit to it is kept till next call
+  class BufferTarget : public Sound::Receiver
+  {
+  public:
+    typedef std::shared_ptr<BufferTarget> Ptr;
+
+    BufferTarget()
+      : Target()
+      , Avail()
+      , RestPos()
+    {
+    }
+
+    void ApplyData(Sound::Chunk::Ptr data) override
+    {
+      const std::size_t toCopy = std::min(data->size(), Avail);
+      Put(data->begin(), toCopy);
+      Rest.insert(Rest.end(), data->begin() + toCopy, data->end());
+    }
+
+    void Flush() override
+    {
+    }
+
+    void SetTarget(uint8_t* target, std::size_t samples)
+    {
+      Target = target;
+      Avail = samples;
+      const std::size_t fromRest = std::min(Rest.size() - RestPos, Avail);
+      Put(Rest.data() + RestPos, fromRest);
+      RestPos += fromRest;
+      if (RestPos == Rest.size())
+      {
+        //keep capacity for the next frames
+        Rest.clear();
+        RestPos = 0;
+      }
+    }
+
+    std::size_t GetAvail() const
+    {
+      return Avail;
+    }
+
+    void ResetTarget()
+    {
+      Target = nullptr;
+      Avail = 0;
+    }
+  private:
+    void Put(const Sound::Sample* samples, std::size_t count)
+    {
+      //target memory is not required to be aligned
+      std::memcpy(Target, samples, count * sizeof(*samples));
+      Target += count * sizeof(*samples);
+      Avail -= count;
+    }
+  private:
+    uint8_t* Target;
+    std::size_t Avail;
+    std::vector<Sound::Sample> Rest;
+    std::size_t RestPos;
+  };
+
+  class PlayerControl : public Player::Control
+  {
+  public:
+    PlayerControl(Parameters::Container::Ptr params, Module::Renderer::Ptr render, BufferTarget::Ptr buffer)
+      : Params(std::move(params))
+      , Renderer(std::move(render))
+      , Buffer(std::move(buffer))
+      , TrackState(Renderer->GetTrackState())
+      , Analyser(Renderer->GetAnalyzer())
+    {
+    }
+
+    uint_t GetPosition() const override
+    {
+      return TrackState->Frame();
+    }
+
+    uint_t Analyze(uint_t maxEntries, uint32_t* bands, uint32_t* levels) const override
+    {
+      //per-thread buffer to avoid allocation on every poll
+      static thread_local std::vector<Module::Analyzer::ChannelState> result;
+      Analyser->GetState(0, result);
+      uint_t doneEntries = 0;
+      for (auto it = result.begin(), lim = result.end(); it != lim && doneEntries != maxEntries; ++it, ++doneEntries)
+      {
+        bands[doneEntries] = it->Band;
+        levels[doneEntries] = it->Level;
+      }
+      return doneEntries;
+    }
+
+    Parameters::Container::Ptr GetParameters() const override
+    {
+      return Params;
+    }
+
+    bool Render(uint_t samples, int16_t* buffer) override
+    {
+      const std::size_t wholeSamples = samples / Sound::Sample::CHANNELS;
+      Buffer->SetTarget(safe_ptr_cast<uint8_t*>(buffer), wholeSamples);
+      while (Buffer->GetAvail() && Renderer->RenderFrame())
+      {
+      }
+      const std::size_t restSamples = Buffer->GetAvail();
+      Buffer->ResetTarget();
+      //trailing incomplete sample is zeroed too
+      const std::size_t rest = restSamples * Sound::Sample::CHANNELS + samples % Sound::Sample::CHANNELS;
+      std::fill_n(buffer + samples - rest, rest, 0);
+      return restSamples == 0;
+    }
+
+    void Seek(uint_t frame) override
+    {
+      Renderer->SetPosition(frame);
+    }
+  private:
+    const Parameters::Container::Ptr Params;
+    const Module::Renderer::Ptr Renderer;
+    const BufferTarget::Ptr Buffer;
+    const Module::TrackState::Ptr TrackState;
+    const Module::Analyzer::Ptr Analyser;
+  };
+}
+
+namespace Player
+{
+  Control::Ptr CreateControl(Module::Holder::Ptr module, Parameters::Accessor::Ptr globalParameters)
+  {
+    auto localParameters = Parameters::Container::Create();
+    auto internalProperties = module->GetModuleProperties();
+    auto properties = Parameters::CreateMergedAccessor(localParameters, std::move(internalProperties), std::move(globalParameters));
+    auto buffer = MakePtr<BufferTarget>();
+    auto renderer = module->CreateRenderer(properties, buffer);
+    return MakePtr<PlayerControl>(std::move(localParameters), std::move(renderer), std::move(buffer));
+  }
+}
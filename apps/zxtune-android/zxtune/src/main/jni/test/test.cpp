@@ -0,0 +1,180 @@
+/**
+*
+* @file
+*
+* @brief Player control test
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "../player.h"
+//common includes
+#include <error_tools.h>
+#include <make_ptr.h>
+//std includes
+#include <iostream>
+#include <vector>
+
+#define FILE_TAG 2F4C6A19
+
+namespace
+{
+  const uint_t FRAMES = 200;
+
+  //frames of different size, some of them are delivered by several chunks
+  std::size_t GetFrameSize(uint_t frame)
+  {
+    return 1 + (frame * 37) % 300;
+  }
+
+  Sound::Sample GetSample(std::size_t idx)
+  {
+    const Sound::Sample::Type left = static_cast<Sound::Sample::Type>(idx * 7919);
+    const Sound::Sample::Type right = static_cast<Sound::Sample::Type>(idx * 104729);
+    return Sound::Sample(left, right);
+  }
+
+  class StubRenderer : public Module::Renderer
+  {
+  public:
+    explicit StubRenderer(Sound::Receiver::Ptr target)
+      : Target(std::move(target))
+      , Frame()
+      , Done()
+    {
+    }
+
+    Module::TrackState::Ptr GetTrackState() const override
+    {
+      return Module::TrackState::Ptr();
+    }
+
+    Module::Analyzer::Ptr GetAnalyzer() const override
+    {
+      return Module::Analyzer::Ptr();
+    }
+
+    bool RenderFrame() override
+    {
+      if (Frame >= FRAMES)
+      {
+        return false;
+      }
+      const std::size_t size = GetFrameSize(Frame);
+      const std::size_t parts = 1 + Frame % 3;
+      for (std::size_t part = 0; part != parts; ++part)
+      {
+        const std::size_t partSize = part + 1 == parts ? size - size / parts * part : size / parts;
+        if (partSize)
+        {
+          Sound::Chunk::Ptr chunk(new Sound::Chunk(partSize));
+          for (auto& smp : *chunk)
+          {
+            smp = GetSample(Done++);
+          }
+          Target->ApplyData(std::move(chunk));
+        }
+      }
+      return ++Frame < FRAMES;
+    }
+
+    void Reset() override
+    {
+      SetPosition(0);
+    }
+
+    void SetPosition(uint_t frame) override
+    {
+      Frame = frame;
+    }
+  private:
+    const Sound::Receiver::Ptr Target;
+    uint_t Frame;
+    std::size_t Done;
+  };
+
+  class StubHolder : public Module::Holder
+  {
+  public:
+    Module::Information::Ptr GetModuleInformation() const override
+    {
+      return Module::Information::Ptr();
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Parameters::Container::Create();
+    }
+
+    Module::Renderer::Ptr CreateRenderer(Parameters::Accessor::Ptr /*params*/, Sound::Receiver::Ptr target) const override
+    {
+      return MakePtr<StubRenderer>(std::move(target));
+    }
+  };
+
+  std::size_t GetTotalSamples()
+  {
+    std::size_t res = 0;
+    for (uint_t frame = 0; frame != FRAMES; ++frame)
+    {
+      res += GetFrameSize(frame);
+    }
+    return res;
+  }
+
+  void TestRender(std::size_t bufferSize)
+  {
+    std::cout << "Render by " << bufferSize << " values:";
+    const Player::Control::Ptr control = Player::CreateControl(MakePtr<StubHolder>(), Parameters::Container::Create());
+    const std::size_t total = GetTotalSamples();
+    std::vector<int16_t> buffer(bufferSize);
+    std::size_t done = 0;
+    for (bool more = true; more; )
+    {
+      //garbage to check filling
+      std::fill(buffer.begin(), buffer.end(), 0x5555);
+      more = control->Render(static_cast<uint_t>(bufferSize), buffer.data());
+      for (std::size_t pos = 0; pos + Sound::Sample::CHANNELS <= bufferSize; pos += Sound::Sample::CHANNELS, ++done)
+      {
+        const Sound::Sample ref = done < total ? GetSample(done) : Sound::Sample();
+        if (buffer[pos] != ref.Left() || buffer[pos + 1] != ref.Right())
+        {
+          std::cout << " failed\n";
+          throw MakeFormattedError(THIS_LINE, "Sample %1%=<%2%,%3%> while expected <%4%,%5%>", done, buffer[pos], buffer[pos + 1], ref.Left(), ref.Right());
+        }
+      }
+      if (bufferSize % Sound::Sample::CHANNELS && buffer.back() != 0)
+      {
+        std::cout << " failed\n";
+        throw MakeFormattedError(THIS_LINE, "Trailing value %1% is not zeroed", buffer.back());
+      }
+      if (more != (done <= total))
+      {
+        std::cout << " failed\n";
+        throw MakeFormattedError(THIS_LINE, "Invalid render result at %1% of %2% samples", done, total);
+      }
+    }
+    std::cout << " passed\n";
+  }
+}
+
+int main()
+{
+  try
+  {
+    const std::size_t SIZES[] = {2, 3, 64, 599, 600, 4096, 100000};
+    for (const auto size : SIZES)
+    {
+      TestRender(size);
+    }
+    std::cout << " Succeed!" << std::endl;
+    return 0;
+  }
+  catch (const Error& e)
+  {
+    std::cerr << e.ToString();
+    return 1;
+  }
+}
@@ -103,6 +103,14 @@ JNIEXPORT jint JNICALL Java_app_zxtune_ZXTune_Module_1CreatePlayer
 JNIEXPORT jboolean JNICALL Java_app_zxtune_ZXTune_Player_1Render
   (JNIEnv *, jclass, jint, jshortArray);
 
+/*
+ * Class:     app_zxtune_ZXTune
+ * Method:    Player_RenderDirect
+ * Signature: (ILjava/nio/ByteBuffer;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_app_zxtune_ZXTune_Player_1RenderDirect
+  (JNIEnv *, jclass, jint, jobject);
+
 /*
  * Class:     app_zxtune_ZXTune
  * Method:    Player_Analyze
@@ -18,6 +18,8 @@
 #include <debug/log.h>
 #include <module/properties/path.h>
 #include <parameters/merged_accessor.h>
+//std includes
+#include <mutex>
 
 namespace
 {
@@ -161,15 +163,18 @@ namespace
   public:
     typedef std::unique_ptr<const DelayLoadItemProvider> Ptr;
 
-    DelayLoadItemProvider(Playlist::Item::DataProvider::Ptr provider, Parameters::Accessor::Ptr playlistParams, const Playlist::IO::ContainerItem& item)
+    DelayLoadItemProvider(Playlist::Item::DataProvider::Ptr provider, Parameters::Accessor::Ptr playlistParams,
+      Playlist::IO::ContainerItemsSource::Ptr items, std::size_t index)
       : Provider(std::move(provider))
-      , Params(Parameters::CreateMergedAccessor(Module::CreatePathProperties(item.Path), item.AdjustedParameters, playlistParams))
-      , Path(item.Path)
+      , PlaylistParams(std::move(playlistParams))
+      , Items(std::move(items))
+      , Index(index)
     {
     }
 
     Playlist::Item::Data::Ptr OpenItem() const
     {
+      Parse();
       try
       {
         CollectorStub collector(*Params);
@@ -184,19 +189,43 @@ namespace
 
     String GetPath() const
     {
+      Parse();
       return Path;
     }
 
     Parameters::Container::Ptr GetParameters() const
     {
+      Parse();
       const Parameters::Container::Ptr res = Parameters::Container::Create();
       Params->Process(*res);
       return res;
     }
+
+    const Playlist::IO::ContainerItemAttributes* GetAttributes() const
+    {
+      Parse();
+      return Attributes.get();
+    }
+  private:
+    //called under owner's lock
+    void Parse() const
+    {
+      if (!Params)
+      {
+        const Playlist::IO::ContainerItem item = Items->GetItem(Index);
+        Params = Parameters::CreateMergedAccessor(Module::CreatePathProperties(item.Path), item.AdjustedParameters, PlaylistParams);
+        Path = item.Path;
+        Attributes = item.Attributes;
+      }
+    }
   private:
     const Playlist::Item::DataProvider::Ptr Provider;
-    const Parameters::Accessor::Ptr Params;
-    const String Path;
+    const Parameters::Accessor::Ptr PlaylistParams;
+    const Playlist::IO::ContainerItemsSource::Ptr Items;
+    const std::size_t Index;
+    mutable Parameters::Accessor::Ptr Params;
+    mutable String Path;
+    mutable Playlist::IO::ContainerItemAttributes::Ptr Attributes;
   };
 
   class DelayLoadItemData : public Playlist::Item::Data
@@ -222,6 +251,7 @@ namespace
 
     Parameters::Container::Ptr GetAdjustedParameters() const override
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       return Provider.get() ? Provider->GetParameters() : Delegate->GetAdjustedParameters();
     }
 
@@ -234,12 +264,18 @@ namespace
     //playlist-related
     Error GetState() const override
     {
+      if (HasDelayedAttributes())
+      {
+        //only valid items have got attributes
+        return Error();
+      }
       AcquireDelegate();
       return Delegate->GetState();
     }
 
     String GetFullPath() const override
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       return Provider.get() ? Provider->GetPath() : Delegate->GetFullPath();
     }
 
@@ -251,67 +287,82 @@ namespace
 
     String GetType() const override
     {
-      AcquireDelegate();
-      return Delegate->GetType();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Type, &Playlist::Item::Data::GetType);
     }
 
     String GetDisplayName() const override
     {
-      AcquireDelegate();
-      return Delegate->GetDisplayName();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::DisplayName, &Playlist::Item::Data::GetDisplayName);
     }
 
     Time::MillisecondsDuration GetDuration() const override
     {
-      AcquireDelegate();
-      return Delegate->GetDuration();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Duration, &Playlist::Item::Data::GetDuration);
     }
 
     String GetAuthor() const override
     {
-      AcquireDelegate();
-      return Delegate->GetAuthor();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Author, &Playlist::Item::Data::GetAuthor);
     }
 
     String GetTitle() const override
     {
-      AcquireDelegate();
-      return Delegate->GetTitle();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Title, &Playlist::Item::Data::GetTitle);
     }
 
     String GetComment() const override
     {
-      AcquireDelegate();
-      return Delegate->GetComment();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Comment, &Playlist::Item::Data::GetComment);
     }
 
     uint32_t GetChecksum() const override
     {
-      AcquireDelegate();
-      return Delegate->GetChecksum();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Checksum, &Playlist::Item::Data::GetChecksum);
     }
 
     uint32_t GetCoreChecksum() const override
     {
-      AcquireDelegate();
-      return Delegate->GetCoreChecksum();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::CoreChecksum, &Playlist::Item::Data::GetCoreChecksum);
     }
 
     std::size_t GetSize() const override
     {
-      AcquireDelegate();
-      return Delegate->GetSize();
+      return GetAttribute(&Playlist::IO::ContainerItemAttributes::Size, &Playlist::Item::Data::GetSize);
     }
   private:
+    //items may be loaded from several threads simultaneously
     void AcquireDelegate() const
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       if (!Delegate)
       {
         Delegate = Provider->OpenItem();
         Provider.reset();
       }
     }
+
+    bool HasDelayedAttributes() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Provider.get() && Provider->GetAttributes();
+    }
+
+    //use stored attributes until module is loaded, real properties may be changed later
+    template<class T>
+    T GetAttribute(T Playlist::IO::ContainerItemAttributes::*attr, T (Playlist::Item::Data::*getter)() const) const
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        if (const auto* attributes = Provider.get() ? Provider->GetAttributes() : nullptr)
+        {
+          return attributes->*attr;
+        }
+      }
+      AcquireDelegate();
+      return ((*Delegate).*getter)();
+    }
   private:
+    mutable std::mutex Guard;
     mutable DelayLoadItemProvider::Ptr Provider;
     mutable Playlist::Item::Data::Ptr Delegate;
   };
@@ -320,36 +371,59 @@ namespace
   {
   public:
     DelayLoadItemsIterator(Playlist::Item::DataProvider::Ptr provider,
-      Parameters::Accessor::Ptr properties, Playlist::IO::ContainerItems::Ptr items)
+      Parameters::Accessor::Ptr properties, Playlist::IO::ContainerItemsSource::Ptr items)
       : Provider(std::move(provider))
       , Properties(std::move(properties))
       , Items(std::move(items))
-      , Current(Items->begin())
+      , Count(Items->GetCount())
+      , Current()
     {
     }
 
     bool IsValid() const override
     {
-      return Current != Items->end();
+      return Current != Count;
     }
 
     Playlist::Item::Data::Ptr Get() const override
     {
-      Require(Current != Items->end());
-      DelayLoadItemProvider::Ptr provider = MakePtr<DelayLoadItemProvider>(Provider, Properties, *Current);
+      Require(Current != Count);
+      DelayLoadItemProvider::Ptr provider = MakePtr<DelayLoadItemProvider>(Provider, Properties, Items, Current);
       return MakePtr<DelayLoadItemData>(std::move(provider));
     }
 
     void Next() override
     {
-      Require(Current != Items->end());
+      Require(Current != Count);
       ++Current;
     }
   private:
     const Playlist::Item::DataProvider::Ptr Provider;
     const Parameters::Accessor::Ptr Properties;
+    const Playlist::IO::ContainerItemsSource::Ptr Items;
+    const std::size_t Count;
+    std::size_t Current;
+  };
+
+  class ContainerItemsArray : public Playlist::IO::ContainerItemsSource
+  {
+  public:
+    explicit ContainerItemsArray(Playlist::IO::ContainerItems::Ptr items)
+      : Items(std::move(items))
+    {
+    }
+
+    std::size_t GetCount() const override
+    {
+      return Items->size();
+    }
+
+    Playlist::IO::ContainerItem GetItem(std::size_t idx) const override
+    {
+      return Items->at(idx);
+    }
+  private:
     const Playlist::IO::ContainerItems::Ptr Items;
-    Playlist::IO::ContainerItems::const_iterator Current;
   };
 
   class ContainerImpl : public Playlist::IO::Container
@@ -357,7 +431,7 @@ namespace
   public:
     ContainerImpl(Playlist::Item::DataProvider::Ptr provider,
       Parameters::Accessor::Ptr properties,
-      Playlist::IO::ContainerItems::Ptr items)
+      Playlist::IO::ContainerItemsSource::Ptr items)
       : Provider(std::move(provider))
       , Properties(std::move(properties))
       , Items(std::move(items))
@@ -371,7 +445,7 @@ namespace
 
     unsigned GetItemsCount() const override
     {
-      return static_cast<unsigned>(Items->size());
+      return static_cast<unsigned>(Items->GetCount());
     }
 
     Playlist::Item::Collection::Ptr GetItems() const override
@@ -381,7 +455,7 @@ namespace
   private:
     const Playlist::Item::DataProvider::Ptr Provider;
     const Parameters::Accessor::Ptr Properties;
-    const Playlist::IO::ContainerItems::Ptr Items;
+    const Playlist::IO::ContainerItemsSource::Ptr Items;
   };
 }
 
@@ -392,6 +466,13 @@ namespace Playlist
     Container::Ptr CreateContainer(Item::DataProvider::Ptr provider,
       Parameters::Accessor::Ptr properties,
       ContainerItems::Ptr items)
+    {
+      return CreateContainer(provider, properties, MakePtr<ContainerItemsArray>(items));
+    }
+
+    Container::Ptr CreateContainer(Item::DataProvider::Ptr provider,
+      Parameters::Accessor::Ptr properties,
+      ContainerItemsSource::Ptr items)
     {
       return MakePtr<ContainerImpl>(provider, properties, items);
     }
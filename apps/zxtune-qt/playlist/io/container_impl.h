@@ -15,15 +15,41 @@
 #include "playlist/supp/data_provider.h"
 //library includes
 #include <parameters/accessor.h>
+#include <time/duration.h>
 
 namespace Playlist
 {
   namespace IO
   {
+    //! Item attributes known without module opening
+    struct ContainerItemAttributes
+    {
+      typedef std::shared_ptr<const ContainerItemAttributes> Ptr;
+
+      ContainerItemAttributes()
+        : Checksum()
+        , CoreChecksum()
+        , Size()
+      {
+      }
+
+      String Type;
+      String DisplayName;
+      String Author;
+      String Title;
+      String Comment;
+      Time::MillisecondsDuration Duration;
+      uint32_t Checksum;
+      uint32_t CoreChecksum;
+      std::size_t Size;
+    };
+
     struct ContainerItem
     {
       String Path;
       Parameters::Accessor::Ptr AdjustedParameters;
+      //optional, used until module is really required
+      ContainerItemAttributes::Ptr Attributes;
     };
 
     struct ContainerItems : std::vector<ContainerItem>
@@ -32,8 +58,23 @@ namespace Playlist
       typedef std::shared_ptr<ContainerItems> RWPtr;
     };
 
+    //! Items storage parsing each item only when it's really required
+    class ContainerItemsSource
+    {
+    public:
+      typedef std::shared_ptr<const ContainerItemsSource> Ptr;
+      virtual ~ContainerItemsSource() = default;
+
+      virtual std::size_t GetCount() const = 0;
+      virtual ContainerItem GetItem(std::size_t idx) const = 0;
+    };
+
     Container::Ptr CreateContainer(Item::DataProvider::Ptr provider,
       Parameters::Accessor::Ptr properties,
       ContainerItems::Ptr items);
+
+    Container::Ptr CreateContainer(Item::DataProvider::Ptr provider,
+      Parameters::Accessor::Ptr properties,
+      ContainerItemsSource::Ptr items);
   }
 }
@@ -30,5 +30,7 @@ namespace Playlist
     typedef uint_t ExportFlags;
 
     void SaveXSPF(Container::Ptr container, const QString& filename, Log::ProgressCallback& cb, ExportFlags flags);
+    //! Binary snapshot with all the items attributes to be opened without modules loading
+    void SaveSnapshot(Container::Ptr container, const QString& filename, Log::ProgressCallback& cb);
   }
 }
@@ -0,0 +1,185 @@
+/**
+* 
+* @file
+*
+* @brief Implementation of playlist binary snapshot exporting
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "export.h"
+#include "snapshot.h"
+#include "ui/utils.h"
+//common includes
+#include <byteorder.h>
+#include <error_tools.h>
+#include <pointers.h>
+//library includes
+#include <debug/log.h>
+#include <parameters/serialize.h>
+//std includes
+#include <cstring>
+#include <map>
+#include <vector>
+//qt includes
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#define FILE_TAG 5B3C9F1E
+
+namespace
+{
+  const Debug::Stream Dbg("Playlist::IO::Snapshot");
+
+  class StringsTable
+  {
+  public:
+    uint32_t Add(const String& str)
+    {
+      const std::map<String, uint32_t>::const_iterator it = Offsets.find(str);
+      if (it != Offsets.end())
+      {
+        return it->second;
+      }
+      const QByteArray& utf8 = ToQString(str).toUtf8();
+      const uint32_t offset = static_cast<uint32_t>(Data.size());
+      const uint32_t size = fromLE(static_cast<uint32_t>(utf8.size()));
+      Data.append(safe_ptr_cast<const char*>(&size), sizeof(size));
+      Data.append(utf8);
+      Offsets.insert(std::make_pair(str, offset));
+      return offset;
+    }
+
+    uint32_t Add(const Parameters::Accessor& params)
+    {
+      Strings::Map strings;
+      Parameters::Convert(params, strings);
+      String packed;
+      for (Strings::Map::const_iterator it = strings.begin(), lim = strings.end(); it != lim; ++it)
+      {
+        packed += it->first;
+        packed += Char(0);
+        packed += it->second;
+        packed += Char(0);
+      }
+      return Add(packed);
+    }
+
+    const QByteArray& GetData() const
+    {
+      return Data;
+    }
+  private:
+    std::map<String, uint32_t> Offsets;
+    QByteArray Data;
+  };
+
+  class SnapshotWriter
+  {
+  public:
+    SnapshotWriter()
+      : Properties()
+    {
+    }
+
+    void WriteProperties(const Parameters::Accessor& props)
+    {
+      Properties = Strings.Add(props);
+    }
+
+    void WriteItems(const Playlist::IO::Container& container, Log::ProgressCallback& cb)
+    {
+      const uint64_t PERCENTS = 100;
+      const uint_t totalItems = container.GetItemsCount();
+      uint_t doneItems = 0;
+      Items.reserve(totalItems);
+      for (Playlist::Item::Collection::Ptr items = container.GetItems(); items->IsValid(); items->Next())
+      {
+        const Playlist::Item::Data::Ptr item = items->Get();
+        WriteItem(*item);
+        cb.OnProgress((PERCENTS * ++doneItems / totalItems));
+      }
+    }
+
+    void Flush(QFile& device) const
+    {
+      using namespace Playlist::IO::Snapshot;
+      const QByteArray& strings = Strings.GetData();
+      Header hdr;
+      std::memcpy(hdr.Signature, SIGNATURE, sizeof(SIGNATURE));
+      hdr.Version = fromLE(VERSION);
+      hdr.ItemsCount = fromLE(static_cast<uint32_t>(Items.size()));
+      hdr.StringsSize = fromLE(static_cast<uint32_t>(strings.size()));
+      hdr.Properties = fromLE(Properties);
+      Write(device, &hdr, sizeof(hdr));
+      if (!Items.empty())
+      {
+        Write(device, &Items.front(), Items.size() * sizeof(Items.front()));
+      }
+      Write(device, strings.constData(), strings.size());
+    }
+  private:
+    void WriteItem(const Playlist::Item::Data& item)
+    {
+      using namespace Playlist::IO::Snapshot;
+      Dbg("Save playitem");
+      Item res;
+      std::memset(&res, 0, sizeof(res));
+      res.Path = fromLE(Strings.Add(item.GetFullPath()));
+      const Parameters::Accessor::Ptr adjustedParams = item.GetAdjustedParameters();
+      res.Parameters = fromLE(Strings.Add(*adjustedParams));
+      //invalid items are stored as a path only to be reopened later
+      if (!item.GetState())
+      {
+        const Time::MillisecondsDuration duration = item.GetDuration();
+        res.Flags = fromLE<uint32_t>(HAS_ATTRIBUTES);
+        res.Type = fromLE(Strings.Add(item.GetType()));
+        res.DisplayName = fromLE(Strings.Add(item.GetDisplayName()));
+        res.Author = fromLE(Strings.Add(item.GetAuthor()));
+        res.Title = fromLE(Strings.Add(item.GetTitle()));
+        res.Comment = fromLE(Strings.Add(item.GetComment()));
+        res.Frames = fromLE<uint32_t>(duration.GetCount());
+        res.FrameDuration = fromLE<uint32_t>(duration.GetPeriod().Get());
+        res.Checksum = fromLE(item.GetChecksum());
+        res.CoreChecksum = fromLE(item.GetCoreChecksum());
+        res.Size = fromLE<uint64_t>(item.GetSize());
+      }
+      Items.push_back(res);
+    }
+
+    static void Write(QFile& device, const void* data, std::size_t size)
+    {
+      if (device.write(static_cast<const char*>(data), size) != qint64(size))
+      {
+        throw Error(THIS_LINE, FromQString(QFile::tr("Failed to write %1").arg(device.fileName())));
+      }
+    }
+  private:
+    StringsTable Strings;
+    uint32_t Properties;
+    std::vector<Playlist::IO::Snapshot::Item> Items;
+  };
+}
+
+namespace Playlist
+{
+  namespace IO
+  {
+    void SaveSnapshot(Container::Ptr container, const QString& filename, Log::ProgressCallback& cb)
+    {
+      QFile device(filename);
+      if (!device.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      {
+        throw Error(THIS_LINE, FromQString(QFile::tr("Cannot create %1 for output").arg(filename)));
+      }
+      SnapshotWriter writer;
+      const Parameters::Accessor::Ptr playlistProperties = container->GetProperties();
+      writer.WriteProperties(*playlistProperties);
+      writer.WriteItems(*container, cb);
+      writer.Flush(device);
+    }
+  }
+}
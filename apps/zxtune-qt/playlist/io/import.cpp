@@ -42,6 +42,10 @@ namespace Playlist
       {
         return xspf;
       }
+      else if (const Container::Ptr snapshot = OpenSnapshot(provider, filename, cb))
+      {
+        return snapshot;
+      }
       return Container::Ptr();
     }
 
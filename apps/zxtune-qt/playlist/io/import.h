@@ -28,6 +28,7 @@ namespace Playlist
     //specific
     Container::Ptr OpenAYL(Item::DataProvider::Ptr provider, const QString& filename, Log::ProgressCallback& cb);
     Container::Ptr OpenXSPF(Item::DataProvider::Ptr provider, const QString& filename, Log::ProgressCallback& cb);
+    Container::Ptr OpenSnapshot(Item::DataProvider::Ptr provider, const QString& filename, Log::ProgressCallback& cb);
 
     Container::Ptr OpenPlainList(Item::DataProvider::Ptr provider, const QStringList& uris);
   }
@@ -0,0 +1,188 @@
+/**
+* 
+* @file
+*
+* @brief Import playlist binary snapshot implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "import.h"
+#include "container_impl.h"
+#include "snapshot.h"
+#include "ui/utils.h"
+//common includes
+#include <byteorder.h>
+#include <contract.h>
+#include <make_ptr.h>
+#include <pointers.h>
+//library includes
+#include <debug/log.h>
+#include <parameters/serialize.h>
+//std includes
+#include <cstring>
+//qt includes
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+
+namespace
+{
+  const Debug::Stream Dbg("Playlist::IO::Snapshot");
+
+  //items are parsed from the stored content only when requested
+  class SnapshotItems : public Playlist::IO::ContainerItemsSource
+  {
+  public:
+    //whole content is kept since session snapshot is rewritten while playlist items are still alive
+    explicit SnapshotItems(QByteArray content)
+      : Content(std::move(content))
+      , Size(Content.size())
+      , Hdr(Size >= sizeof(*Hdr) ? safe_ptr_cast<const Playlist::IO::Snapshot::Header*>(Content.constData()) : nullptr)
+      , ItemsCount(Hdr ? fromLE(Hdr->ItemsCount) : 0)
+      , Items(Hdr ? safe_ptr_cast<const Playlist::IO::Snapshot::Item*>(Hdr + 1) : nullptr)
+      , Strings(Hdr ? safe_ptr_cast<const uint8_t*>(Items + ItemsCount) : nullptr)
+      , StringsSize(Hdr ? fromLE(Hdr->StringsSize) : 0)
+    {
+    }
+
+    bool Check() const
+    {
+      using namespace Playlist::IO::Snapshot;
+      return Hdr
+          && 0 == std::memcmp(Hdr->Signature, SIGNATURE, sizeof(SIGNATURE))
+          && fromLE(Hdr->Version) == VERSION
+          && uint64_t(ItemsCount) * sizeof(Item) + StringsSize + sizeof(Header) == Size
+      ;
+    }
+
+    Parameters::Accessor::Ptr GetProperties() const
+    {
+      const Parameters::Container::Ptr res = GetParameters(fromLE(Hdr->Properties));
+      res->SetValue(Playlist::ATTRIBUTE_ITEMS, ItemsCount);
+      return res;
+    }
+
+    std::size_t GetCount() const override
+    {
+      return ItemsCount;
+    }
+
+    Playlist::IO::ContainerItem GetItem(std::size_t idx) const override
+    {
+      using namespace Playlist::IO::Snapshot;
+      Require(idx < ItemsCount);
+      const Item& in = Items[idx];
+      Playlist::IO::ContainerItem out;
+      out.Path = GetString(fromLE(in.Path));
+      out.AdjustedParameters = GetParameters(fromLE(in.Parameters));
+      if (0 != (fromLE(in.Flags) & HAS_ATTRIBUTES))
+      {
+        const std::shared_ptr<Playlist::IO::ContainerItemAttributes> attrs = std::make_shared<Playlist::IO::ContainerItemAttributes>();
+        attrs->Type = GetString(fromLE(in.Type));
+        attrs->DisplayName = GetString(fromLE(in.DisplayName));
+        attrs->Author = GetString(fromLE(in.Author));
+        attrs->Title = GetString(fromLE(in.Title));
+        attrs->Comment = GetString(fromLE(in.Comment));
+        attrs->Duration = Time::MillisecondsDuration(fromLE(in.Frames), Time::Milliseconds(fromLE(in.FrameDuration)));
+        attrs->Checksum = fromLE(in.Checksum);
+        attrs->CoreChecksum = fromLE(in.CoreChecksum);
+        attrs->Size = static_cast<std::size_t>(fromLE(in.Size));
+        out.Attributes = attrs;
+      }
+      return out;
+    }
+  private:
+    String GetString(uint32_t offset) const
+    {
+      uint32_t size = 0;
+      if (offset > StringsSize || StringsSize - offset < sizeof(size))
+      {
+        Dbg("Invalid string offset %1%", offset);
+        return String();
+      }
+      std::memcpy(&size, Strings + offset, sizeof(size));
+      size = fromLE(size);
+      const std::size_t start = offset + sizeof(size);
+      if (StringsSize - start < size)
+      {
+        Dbg("Invalid string size %1% at %2%", size, offset);
+        return String();
+      }
+      return FromQString(QString::fromUtf8(safe_ptr_cast<const char*>(Strings + start), static_cast<int>(size)));
+    }
+
+    Parameters::Container::Ptr GetParameters(uint32_t offset) const
+    {
+      const String packed = GetString(offset);
+      Strings::Map strings;
+      for (String::size_type pos = 0; pos < packed.size(); )
+      {
+        const String::size_type nameEnd = packed.find(Char(0), pos);
+        const String::size_type valueEnd = packed.find(Char(0), nameEnd + 1);
+        if (valueEnd == String::npos)
+        {
+          break;
+        }
+        strings[packed.substr(pos, nameEnd - pos)] = packed.substr(nameEnd + 1, valueEnd - nameEnd - 1);
+        pos = valueEnd + 1;
+      }
+      const Parameters::Container::Ptr res = Parameters::Container::Create();
+      Parameters::Convert(strings, *res);
+      return res;
+    }
+  private:
+    const QByteArray Content;
+    const std::size_t Size;
+    const Playlist::IO::Snapshot::Header* const Hdr;
+    const uint_t ItemsCount;
+    const Playlist::IO::Snapshot::Item* const Items;
+    const uint8_t* const Strings;
+    const std::size_t StringsSize;
+  };
+
+  Playlist::IO::Container::Ptr CreateSnapshotPlaylist(Playlist::Item::DataProvider::Ptr provider, const QFileInfo& fileInfo)
+  {
+    QFile device(fileInfo.absoluteFilePath());
+    if (!device.open(QIODevice::ReadOnly))
+    {
+      assert(!"Failed to open playlist");
+      return Playlist::IO::Container::Ptr();
+    }
+    const std::shared_ptr<const SnapshotItems> items = std::make_shared<SnapshotItems>(device.readAll());
+    if (!items->Check())
+    {
+      Dbg("Invalid snapshot");
+      return Playlist::IO::Container::Ptr();
+    }
+    const Parameters::Accessor::Ptr properties = items->GetProperties();
+    Dbg("Opened %1% items", items->GetCount());
+    return Playlist::IO::CreateContainer(provider, properties, items);
+  }
+
+  bool CheckSnapshotByName(const QString& filename)
+  {
+    static const QLatin1String SNAPSHOT_SUFFIX(Playlist::IO::Snapshot::SUFFIX);
+    return filename.endsWith(SNAPSHOT_SUFFIX, Qt::CaseInsensitive);
+  }
+}
+
+namespace Playlist
+{
+  namespace IO
+  {
+    Container::Ptr OpenSnapshot(Item::DataProvider::Ptr provider, const QString& filename, Log::ProgressCallback& /*cb*/)
+    {
+      const QFileInfo info(filename);
+      if (!info.isFile() || !info.isReadable() ||
+          !CheckSnapshotByName(info.fileName()))
+      {
+        return Container::Ptr();
+      }
+      return CreateSnapshotPlaylist(provider, info);
+    }
+  }
+}
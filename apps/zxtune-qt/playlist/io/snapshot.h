@@ -0,0 +1,78 @@
+/**
+* 
+* @file
+*
+* @brief Playlist binary snapshot format
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//common includes
+#include <types.h>
+
+namespace Playlist
+{
+  namespace IO
+  {
+    namespace Snapshot
+    {
+      /*
+        Layout (all the values are little-endian):
+        Header
+        Item[Header.ItemsCount]
+        Strings[Header.StringsSize]
+
+        Strings are referenced by offset from the strings table start.
+        Each string is stored as uint32_t size followed by utf-8 encoded data.
+        Parameters are stored as a single string of zero-separated name/value pairs.
+      */
+      const uint8_t SIGNATURE[] = {'Z', 'X', 'T', 'u', 'n', 'e', 'P', 'L'};
+      const uint32_t VERSION = 2;
+
+      const char SUFFIX[] = ".zxpl";
+
+      enum ItemFlags
+      {
+        HAS_ATTRIBUTES = 1
+      };
+
+#ifdef USE_PRAGMA_PACK
+#pragma pack(push,1)
+#endif
+      PACK_PRE struct Header
+      {
+        uint8_t Signature[8];
+        uint32_t Version;
+        uint32_t ItemsCount;
+        uint32_t StringsSize;
+        uint32_t Properties;
+      } PACK_POST;
+
+      PACK_PRE struct Item
+      {
+        uint32_t Flags;
+        uint32_t Path;
+        uint32_t Parameters;
+        uint32_t Type;
+        uint32_t DisplayName;
+        uint32_t Author;
+        uint32_t Title;
+        uint32_t Comment;
+        uint32_t Frames;
+        uint32_t FrameDuration;
+        uint32_t Checksum;
+        uint32_t CoreChecksum;
+        uint64_t Size;
+      } PACK_POST;
+#ifdef USE_PRAGMA_PACK
+#pragma pack(pop)
+#endif
+
+      static_assert(sizeof(Header) == 24, "Invalid layout");
+      static_assert(sizeof(Item) == 56, "Invalid layout");
+    }
+  }
+}
@@ -92,6 +92,32 @@ namespace
     const Playlist::IO::ExportFlags Flags;
   };
 
+  class SaveSnapshotOperation : public Playlist::Item::StorageAccessOperation
+  {
+  public:
+    SaveSnapshotOperation(const QString& name, const QString& filename)
+      : Name(FromQString(name))
+      , Filename(filename)
+    {
+    }
+
+    void Execute(const Playlist::Item::Storage& storage, Log::ProgressCallback& cb) override
+    {
+      const Playlist::IO::Container::Ptr container = MakePtr<ContainerImpl>(Name, storage);
+      try
+      {
+        Playlist::IO::SaveSnapshot(container, Filename, cb);
+      }
+      catch (const Error& e)
+      {
+        ShowErrorMessage(QString(), e);
+      }
+    }
+  private:
+    const String Name;
+    const QString Filename;
+  };
+
   class LoadPlaylistOperation : public Playlist::Item::StorageModifyOperation
   {
   public:
@@ -164,4 +190,11 @@ namespace Playlist
     const Playlist::Item::StorageAccessOperation::Ptr op = MakePtr<SavePlaylistOperation>(name, filename, flags);
     ctrl->GetModel()->PerformOperation(op);
   }
+
+  void SaveSnapshot(Controller::Ptr ctrl, const QString& filename)
+  {
+    const QString name = ctrl->GetName();
+    const Playlist::Item::StorageAccessOperation::Ptr op = MakePtr<SaveSnapshotOperation>(name, filename);
+    ctrl->GetModel()->PerformOperation(op);
+  }
 }
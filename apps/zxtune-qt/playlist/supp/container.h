@@ -35,4 +35,5 @@ namespace Playlist
   };
 
   void Save(Controller::Ptr ctrl, const QString& filename, uint_t flags);
+  void SaveSnapshot(Controller::Ptr ctrl, const QString& filename);
 }
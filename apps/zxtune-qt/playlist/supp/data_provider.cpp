@@ -20,6 +20,7 @@
 //library includes
 #include <core/module_detect.h>
 #include <core/module_open.h>
+#include <core/module_registry.h>
 #include <core/plugin.h>
 #include <core/plugin_attrs.h>
 #include <debug/log.h>
@@ -411,8 +412,8 @@ namespace
     Module::Holder::Ptr GetModule(Parameters::Accessor::Ptr adjustedParams) const
     {
       const Binary::Container::Ptr data = Source->GetData();
-      const ZXTune::DataLocation::Ptr location = ZXTune::OpenLocation(*CoreParams, data, ToLocal(ModuleId->Subpath()));
-      const Module::Holder::Ptr module = Module::Open(*CoreParams, location);
+      //the same module in several playlists or items is shared
+      const Module::Holder::Ptr module = Module::Registry::Instance().Open(*CoreParams, data, ToLocal(ModuleId->Subpath()));
       const Parameters::Accessor::Ptr moduleProps = MakePtr<RecodeStringsAdapter>(module->GetModuleProperties());
       const Parameters::Accessor::Ptr pathParams = Module::CreatePathProperties(ModuleId);
       const Parameters::Accessor::Ptr moduleParams = Parameters::CreateMergedAccessor(pathParams, adjustedParams, moduleProps);
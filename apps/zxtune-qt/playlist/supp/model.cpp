@@ -10,6 +10,7 @@
 
 //local includes
 #include "model.h"
+#include "operations_helpers.h"
 #include "storage.h"
 #include "ui/utils.h"
 //common includes
@@ -20,8 +21,11 @@
 #include <math/bitops.h>
 #include <parameters/template.h>
 //std includes
+#include <algorithm>
 #include <atomic>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 //qt includes
 #include <QtCore/QMimeData>
 #include <QtCore/QSet>
@@ -115,106 +119,132 @@ namespace
     const DummyDataProvider Dummy;
   };
 
+  typedef std::unordered_map<const Playlist::Item::Data*, std::size_t> ItemsRanks;
+
+  class RanksComparer : public Playlist::Item::Comparer
+  {
+  public:
+    explicit RanksComparer(const ItemsRanks& ranks)
+      : Ranks(ranks)
+    {
+    }
+
+    bool CompareItems(const Playlist::Item::Data& lh, const Playlist::Item::Data& rh) const override
+    {
+      return Ranks.find(&lh)->second < Ranks.find(&rh)->second;
+    }
+  private:
+    const ItemsRanks& Ranks;
+  };
+
+  class ComparisonsCounter
+  {
+  public:
+    ComparisonsCounter(Log::ProgressCallback& cb, uint_t done)
+      : Callback(cb)
+      , Done(done)
+    {
+    }
+
+    void operator()()
+    {
+      Callback.OnProgress(++Done);
+    }
+  private:
+    Log::ProgressCallback& Callback;
+    uint_t Done;
+  };
+
+  //sort keys are acquired only once per item simultaneously for several items
   template<class T>
-  class TypedPlayitemsComparer : public Playlist::Item::Comparer
+  class SortOperation : public Playlist::Item::StorageModifyOperation
+                      , private Playlist::Item::ParallelVisitor<T>
   {
   public:
     typedef T (Playlist::Item::Data::*Functor)() const;
-    TypedPlayitemsComparer(Functor fn, bool ascending)
+
+    SortOperation(Functor fn, bool ascending)
       : Getter(fn)
       , Ascending(ascending)
     {
     }
 
-    bool CompareItems(const Playlist::Item::Data& lh, const Playlist::Item::Data& rh) const override
+    void Execute(Playlist::Item::Storage& storage, Log::ProgressCallback& cb) override
+    {
+      const Playlist::Item::IndexedItems items = Playlist::Item::CollectItems(storage, nullptr);
+      const uint_t totalItems = static_cast<uint_t>(items.size());
+      //according to STL spec: The number of comparisons is approximately N log N, where N is the list's size. Assume that log is binary.
+      const Log::ProgressCallback::Ptr progress = Log::CreatePercentProgressCallback(totalItems + totalItems * Math::Log2(totalItems), cb);
+      Keys.reserve(totalItems);
+      {
+        Playlist::Item::ProgressParallelVisitor<T> progressed(*this, *progress);
+        Playlist::Item::VisitItemsParallel(items, progressed);
+      }
+      ComparisonsCounter counter(*progress, totalItems);
+      const bool ascending = Ascending;
+      std::stable_sort(Keys.begin(), Keys.end(),
+        [&counter, ascending](const KeyType& lh, const KeyType& rh) {counter(); return ascending ? lh.first < rh.first : rh.first < lh.first;});
+      ItemsRanks ranks(Keys.size());
+      for (std::size_t idx = 0, lim = Keys.size(); idx != lim; ++idx)
+      {
+        ranks.insert(ItemsRanks::value_type(Keys[idx].second, idx));
+      }
+      Keys.clear();
+      storage.Sort(RanksComparer(ranks));
+    }
+  private:
+    typedef std::pair<T, const Playlist::Item::Data*> KeyType;
+
+    T Prepare(const Playlist::Item::Data& data) const override
     {
-      const T val1 = (lh.*Getter)();
-      const T val2 = (rh.*Getter)();
-      return Ascending
-        ? val1 < val2
-        : val2 < val1;
+      return (data.*Getter)();
+    }
+
+    void OnItem(Playlist::Model::IndexType /*index*/, Playlist::Item::Data::Ptr data, T prepared) override
+    {
+      Keys.push_back(KeyType(std::move(prepared), data.get()));
     }
   private:
     const Functor Getter;
     const bool Ascending;
+    std::vector<KeyType> Keys;
   };
 
   template<class R>
-  Playlist::Item::Comparer::Ptr CreateComparer(R (Playlist::Item::Data::*func)() const, bool ascending)
+  Playlist::Item::StorageModifyOperation::Ptr CreateSortOperation(R (Playlist::Item::Data::*func)() const, bool ascending)
   {
-    return MakePtr<TypedPlayitemsComparer<R> >(func, ascending);
+    return MakePtr<SortOperation<R> >(func, ascending);
   }
 
-  Playlist::Item::Comparer::Ptr CreateComparerByColumn(int column, bool ascending)
+  Playlist::Item::StorageModifyOperation::Ptr CreateSortOperationByColumn(int column, bool ascending)
   {
     switch (column)
     {
     case Playlist::Model::COLUMN_TYPE:
-      return CreateComparer(&Playlist::Item::Data::GetType, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetType, ascending);
     case Playlist::Model::COLUMN_DISPLAY_NAME:
-      return CreateComparer(&Playlist::Item::Data::GetDisplayName, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetDisplayName, ascending);
     case Playlist::Model::COLUMN_DURATION:
-      return CreateComparer(&Playlist::Item::Data::GetDuration, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetDuration, ascending);
     case Playlist::Model::COLUMN_AUTHOR:
-      return CreateComparer(&Playlist::Item::Data::GetAuthor, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetAuthor, ascending);
     case Playlist::Model::COLUMN_TITLE:
-      return CreateComparer(&Playlist::Item::Data::GetTitle, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetTitle, ascending);
     case Playlist::Model::COLUMN_COMMENT:
-      return CreateComparer(&Playlist::Item::Data::GetComment, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetComment, ascending);
     case Playlist::Model::COLUMN_PATH:
-      return CreateComparer(&Playlist::Item::Data::GetFullPath, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetFullPath, ascending);
     case Playlist::Model::COLUMN_SIZE:
-      return CreateComparer(&Playlist::Item::Data::GetSize, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetSize, ascending);
     case Playlist::Model::COLUMN_CRC:
-      return CreateComparer(&Playlist::Item::Data::GetChecksum, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetChecksum, ascending);
     case Playlist::Model::COLUMN_FIXEDCRC:
-      return CreateComparer(&Playlist::Item::Data::GetCoreChecksum, ascending);
+      return CreateSortOperation(&Playlist::Item::Data::GetCoreChecksum, ascending);
     default:
-      return Playlist::Item::Comparer::Ptr();
+      return Playlist::Item::StorageModifyOperation::Ptr();
     }
   }
 
-  class ComparisonsCounter : public Playlist::Item::Comparer
-  {
-  public:
-    ComparisonsCounter(const Playlist::Item::Comparer& delegate, Log::ProgressCallback& cb)
-      : Delegate(delegate)
-      , Callback(cb)
-      , Done(0)
-    {
-    }
-
-    bool CompareItems(const Playlist::Item::Data& lh, const Playlist::Item::Data& rh) const override
-    {
-      Callback.OnProgress(++Done);
-      return Delegate.CompareItems(lh, rh);
-    }
-  private:
-    const Playlist::Item::Comparer& Delegate;
-    Log::ProgressCallback& Callback;
-    mutable uint_t Done;
-  };
-
-  class SortOperation : public Playlist::Item::StorageModifyOperation
-  {
-  public:
-    explicit SortOperation(Playlist::Item::Comparer::Ptr comparer)
-      : Comparer(std::move(comparer))
-    {
-    }
-
-    void Execute(Playlist::Item::Storage& storage, Log::ProgressCallback& cb) override
-    {
-      const uint_t totalItems = storage.CountItems();
-      //according to STL spec: The number of comparisons is approximately N log N, where N is the list's size. Assume that log is binary.
-      const Log::ProgressCallback::Ptr progress = Log::CreatePercentProgressCallback(totalItems * Math::Log2(totalItems), cb);
-      const ComparisonsCounter countingComparer(*Comparer, *progress);
-      storage.Sort(countingComparer);
-    }
-  private:
-    const Playlist::Item::Comparer::Ptr Comparer;
-  };
-
   const QLatin1String INDICES_MIMETYPE("application/playlist.indices");
 
   template<class OpType>
@@ -622,9 +652,8 @@ namespace
     {
       Dbg("Sort data in column=%1% by order=%2%", column, order);
       const bool ascending = order == Qt::AscendingOrder;
-      if (Playlist::Item::Comparer::Ptr comparer = CreateComparerByColumn(column, ascending))
+      if (const Playlist::Item::StorageModifyOperation::Ptr op = CreateSortOperationByColumn(column, ascending))
       {
-        const Playlist::Item::StorageModifyOperation::Ptr op = MakePtr<SortOperation>(comparer);
         PerformOperation(op);
       }
     }
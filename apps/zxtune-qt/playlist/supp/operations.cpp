@@ -43,10 +43,12 @@ namespace
   }; 
 
   template<class T>
-  class VisitorAdapter : public Playlist::Item::Visitor
+  class VisitorAdapter : public Playlist::Item::ParallelVisitor<std::pair<bool, T> >
   {
   public:
     typedef T (Playlist::Item::Data::*GetFunctionType)() const;
+    //invalid items are skipped
+    typedef std::pair<bool, T> PreparedType;
 
     VisitorAdapter(const GetFunctionType getter, typename PropertyModel<T>::Visitor& delegate)
       : Getter(getter)
@@ -54,14 +56,21 @@ namespace
     {
     }
 
-    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr data) override
+    PreparedType Prepare(const Playlist::Item::Data& data) const override
     {
-      if (data->GetState())
+      if (data.GetState())
       {
-        return;
+        return PreparedType(false, T());
+      }
+      return PreparedType(true, (data.*Getter)());
+    }
+
+    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr /*data*/, PreparedType prepared) override
+    {
+      if (prepared.first)
+      {
+        Delegate.OnItem(index, prepared.second);
       }
-      const T val = ((*data).*Getter)();
-      Delegate.OnItem(index, val);
     }
 
   private:
@@ -87,14 +96,14 @@ namespace
     void ForAllItems(typename PropertyModel<T>::Visitor& visitor) const override
     {
       VisitorAdapter<T> adapter(Getter, visitor);
-      Model.ForAllItems(adapter);
+      Playlist::Item::VisitItemsParallel(Playlist::Item::CollectItems(Model, nullptr), adapter);
     }
 
     void ForSpecifiedItems(const Playlist::Model::IndexSet& items, typename PropertyModel<T>::Visitor& visitor) const override
     {
       assert(!items.empty());
       VisitorAdapter<T> adapter(Getter, visitor);
-      Model.ForSpecifiedItems(items, adapter);
+      Playlist::Item::VisitItemsParallel(Playlist::Item::CollectItems(Model, &items), adapter);
     }
   private:
     const Playlist::Item::Storage& Model;
@@ -462,7 +471,7 @@ namespace
     const Playlist::Model::IndexSet::Ptr SelectedItems;
   };
 
-  class InvalidModulesCollection : public Playlist::Item::Visitor
+  class InvalidModulesCollection : public Playlist::Item::ParallelVisitor<bool>
   {
   public:
     InvalidModulesCollection()
@@ -470,10 +479,14 @@ namespace
     {
     }
 
-    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr data) override
+    bool Prepare(const Playlist::Item::Data& data) const override
+    {
+      return !!data.GetState();
+    }
+
+    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr /*data*/, bool invalid) override
     {
-      //check for the data first to define is data valid or not
-      if (data->GetState())
+      if (invalid)
       {
         Result->insert(index);
       }
@@ -22,6 +22,7 @@
 #include <async/src/event.h>
 #include <io/api.h>
 #include <io/template.h>
+#include <module/players/end_detector.h>
 #include <parameters/merged_accessor.h>
 #include <parameters/template.h>
 #include <sound/backends_parameters.h>
@@ -129,7 +130,8 @@ namespace
         const Module::Information::Ptr info = item->GetModuleInformation();
         const Log::ProgressCallback::Ptr framesProgress = Log::CreatePercentProgressCallback(info->FramesCount(), *curItemProgress);
         ConvertCallback cb(*framesProgress);
-        const Sound::Backend::Ptr backend = Service->CreateBackend(Type, item, Sound::BackendCallback::Ptr(&cb, NullDeleter<Sound::BackendCallback>()));
+        const Module::Holder::Ptr holder = Module::CreateEndDetectingHolder(item);
+        const Sound::Backend::Ptr backend = Service->CreateBackend(Type, holder, Sound::BackendCallback::Ptr(&cb, NullDeleter<Sound::BackendCallback>()));
         const Sound::PlaybackControl::Ptr control = backend->GetPlaybackControl();
         control->Play();
         cb.WaitForFinish();
@@ -186,7 +188,7 @@ namespace
 
   // Exporting
   class ExportOperation : public Playlist::Item::TextResultOperation
-                        , private Playlist::Item::Visitor
+                        , private Playlist::Item::ParallelVisitor<Module::Holder::Ptr>
   {
   public:
     ExportOperation(const String& nameTemplate, Parameters::Accessor::Ptr params, Playlist::Item::ConversionResultNotification::Ptr result)
@@ -211,10 +213,16 @@ namespace
       emit ResultAcquired(Result);
     }
   private:
-    void OnItem(Playlist::Model::IndexType /*index*/, Playlist::Item::Data::Ptr data) override
+    //opening module loads delay-loaded item completely
+    Module::Holder::Ptr Prepare(const Playlist::Item::Data& data) const override
+    {
+      return data.GetModule();
+    }
+
+    void OnItem(Playlist::Model::IndexType /*index*/, Playlist::Item::Data::Ptr data, Module::Holder::Ptr holder) override
     {
       const String path = data->GetFullPath();
-      if (const Module::Holder::Ptr holder = data->GetModule())
+      if (holder)
       {
         ExportItem(path, *holder, *data->GetModuleData());
       }
@@ -1,5 +1,5 @@
 /**
-* 
+*
 * @file
 *
 * @brief Playlist operations helpers implementation
@@ -11,9 +11,37 @@
 //local includes
 #include "operations_helpers.h"
 #include "storage.h"
+//library includes
+#include <async/shared_workers.h>
+//std includes
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 
 namespace
 {
+  class ItemsCollector : public Playlist::Item::Visitor
+  {
+  public:
+    explicit ItemsCollector(std::size_t count)
+    {
+      Items.reserve(count);
+    }
+
+    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr data) override
+    {
+      Items.push_back(Playlist::Item::IndexedItems::value_type(index, data));
+    }
+
+    Playlist::Item::IndexedItems CaptureResult()
+    {
+      return std::move(Items);
+    }
+  private:
+    Playlist::Item::IndexedItems Items;
+  };
+
   class ProgressModelVisitor : public Playlist::Item::Visitor
   {
   public:
@@ -34,12 +62,112 @@ namespace
     Log::ProgressCallback& Callback;
     uint_t Done;
   };
+
+  //indices are claimed one by one by workers and calling thread, so late workers do not delay the batch.
+  //Batch may outlive the calling function while late workers find nothing to process.
+  class Batch
+  {
+  public:
+    typedef std::shared_ptr<Batch> Ptr;
+
+    Batch(std::size_t count, const std::function<void(std::size_t)>& task)
+      : Count(count)
+      , Task(&task)
+      , Next(0)
+      , Done(0)
+    {
+    }
+
+    void Process()
+    {
+      std::size_t processed = 0;
+      for (std::size_t idx; (idx = Next++) < Count; ++processed)
+      {
+        try
+        {
+          (*Task)(idx);
+        }
+        catch (...)
+        {
+          const std::lock_guard<std::mutex> lock(Mutex);
+          if (!Failure)
+          {
+            Failure = std::current_exception();
+          }
+        }
+      }
+      if (processed)
+      {
+        const std::lock_guard<std::mutex> lock(Mutex);
+        Done += processed;
+        if (Done == Count)
+        {
+          Condition.notify_all();
+        }
+      }
+    }
+
+    void Wait()
+    {
+      std::unique_lock<std::mutex> lock(Mutex);
+      Condition.wait(lock, [this] () {return Done == Count;});
+      if (Failure)
+      {
+        std::rethrow_exception(Failure);
+      }
+    }
+  private:
+    const std::size_t Count;
+    const std::function<void(std::size_t)>* const Task;
+    std::atomic<std::size_t> Next;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::size_t Done;
+    std::exception_ptr Failure;
+  };
 }
 
 namespace Playlist
 {
   namespace Item
   {
+    IndexedItems CollectItems(const Storage& stor, const Model::IndexSet* selectedItems)
+    {
+      if (selectedItems)
+      {
+        ItemsCollector items(selectedItems->size());
+        stor.ForSpecifiedItems(*selectedItems, items);
+        return items.CaptureResult();
+      }
+      else
+      {
+        ItemsCollector items(stor.CountItems());
+        stor.ForAllItems(items);
+        return items.CaptureResult();
+      }
+    }
+
+    void ExecuteParallel(std::size_t count, const std::function<void(std::size_t)>& task)
+    {
+      Async::SharedWorkers& workers = Async::SharedWorkers::Instance();
+      const std::size_t helpers = std::min(workers.Size(), count ? count - 1 : 0);
+      if (!helpers)
+      {
+        for (std::size_t idx = 0; idx != count; ++idx)
+        {
+          task(idx);
+        }
+        return;
+      }
+      const Batch::Ptr batch = std::make_shared<Batch>(count, task);
+      for (std::size_t idx = 0; idx != helpers; ++idx)
+      {
+        workers.Execute([batch] () {batch->Process();});
+      }
+      batch->Process();
+      batch->Wait();
+    }
+
     void ExecuteOperation(const Storage& stor, Model::IndexSet::Ptr selectedItems, Visitor& visitor, Log::ProgressCallback& cb)
     {
       const std::size_t totalItems = selectedItems ? selectedItems->size() : stor.CountItems();
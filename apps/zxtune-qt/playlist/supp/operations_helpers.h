@@ -1,5 +1,5 @@
 /**
-* 
+*
 * @file
 *
 * @brief Playlist operations helpers interface
@@ -12,11 +12,97 @@
 
 //local includes
 #include "model.h"
+//std includes
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 namespace Playlist
 {
   namespace Item
   {
     void ExecuteOperation(const class Storage& stor, Model::IndexSet::Ptr selectedItems, class Visitor& visitor, Log::ProgressCallback& cb);
+
+    //! Visitor with per-item work which can be performed for several items simultaneously
+    template<class T>
+    class ParallelVisitor
+    {
+    public:
+      virtual ~ParallelVisitor() = default;
+
+      //! Called simultaneously from several threads
+      virtual T Prepare(const Data& data) const = 0;
+      //! Called sequentially in items order from the calling thread
+      virtual void OnItem(Model::IndexType index, Data::Ptr data, T prepared) = 0;
+    };
+
+    template<class T>
+    class ProgressParallelVisitor : public ParallelVisitor<T>
+    {
+    public:
+      ProgressParallelVisitor(ParallelVisitor<T>& delegate, Log::ProgressCallback& cb)
+        : Delegate(delegate)
+        , Callback(cb)
+        , Done(0)
+      {
+      }
+
+      T Prepare(const Data& data) const override
+      {
+        return Delegate.Prepare(data);
+      }
+
+      void OnItem(Model::IndexType index, Data::Ptr data, T prepared) override
+      {
+        Delegate.OnItem(index, std::move(data), std::move(prepared));
+        Callback.OnProgress(++Done);
+      }
+    private:
+      ParallelVisitor<T>& Delegate;
+      Log::ProgressCallback& Callback;
+      uint_t Done;
+    };
+
+    typedef std::vector<std::pair<Model::IndexType, Data::Ptr> > IndexedItems;
+
+    //! @return selected items or all the items if no selection specified
+    IndexedItems CollectItems(const Storage& stor, const Model::IndexSet* selectedItems);
+
+    //! Calls task for each index in [0, count) using shared threads pool and the calling thread
+    void ExecuteParallel(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    //! Items count prepared simultaneously before passing to visitor
+    const std::size_t PARALLEL_CHUNK_SIZE = 1024;
+
+    template<class T>
+    void VisitItemsParallel(const IndexedItems& items, ParallelVisitor<T>& visitor)
+    {
+      //wrapped to avoid std::vector<bool> specialization
+      struct PreparedValue
+      {
+        T Value;
+      };
+      std::vector<PreparedValue> prepared;
+      for (std::size_t start = 0, total = items.size(); start < total; start += PARALLEL_CHUNK_SIZE)
+      {
+        const std::size_t count = std::min(PARALLEL_CHUNK_SIZE, total - start);
+        prepared.resize(count);
+        ExecuteParallel(count, [&](std::size_t idx) {prepared[idx].Value = visitor.Prepare(*items[start + idx].second);});
+        for (std::size_t idx = 0; idx != count; ++idx)
+        {
+          const auto& item = items[start + idx];
+          visitor.OnItem(item.first, item.second, std::move(prepared[idx].Value));
+        }
+      }
+    }
+
+    template<class T>
+    void ExecuteOperation(const Storage& stor, Model::IndexSet::Ptr selectedItems, ParallelVisitor<T>& visitor, Log::ProgressCallback& cb)
+    {
+      const IndexedItems items = CollectItems(stor, selectedItems.get());
+      const Log::ProgressCallback::Ptr progress = Log::CreatePercentProgressCallback(static_cast<uint_t>(items.size()), cb);
+      ProgressParallelVisitor<T> progressed(visitor, *progress);
+      VisitItemsParallel(items, progressed);
+    }
   }
 }
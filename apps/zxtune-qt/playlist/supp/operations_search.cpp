@@ -10,6 +10,7 @@
 
 //local includes
 #include "operations_search.h"
+#include "operations_helpers.h"
 #include "storage.h"
 #include "ui/utils.h"
 //common includes
@@ -29,24 +30,26 @@ namespace
     virtual bool Match(const Playlist::Item::Data& data) const = 0;
   };
 
-  class SearchVisitor : public Playlist::Item::Visitor
+  class SearchVisitor : public Playlist::Item::ParallelVisitor<bool>
   {
   public:
-    SearchVisitor(Predicate::Ptr pred, Log::ProgressCallback& cb)
-      : Callback(cb)
-      , Pred(std::move(pred))
+    explicit SearchVisitor(Predicate::Ptr pred)
+      : Pred(std::move(pred))
       , Result(MakeRWPtr<Playlist::Model::IndexSet>())
-      , Done(0)
     {
     }
 
-    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr data) override
+    bool Prepare(const Playlist::Item::Data& data) const override
+    {
+      return Pred->Match(data);
+    }
+
+    void OnItem(Playlist::Model::IndexType index, Playlist::Item::Data::Ptr /*data*/, bool matched) override
     {
-      if (Pred->Match(*data))
+      if (matched)
       {
         Result->insert(index);
       }
-      Callback.OnProgress(++Done);
     }
 
     Playlist::Model::IndexSet::Ptr GetResult() const
@@ -54,10 +57,8 @@ namespace
       return Result;
     }
   private:
-    Log::ProgressCallback& Callback;
     const Predicate::Ptr Pred;
     const Playlist::Model::IndexSet::RWPtr Result;
-    uint_t Done;
   };
 
   class SearchOperation : public Playlist::Item::SelectionOperation
@@ -78,17 +79,8 @@ namespace
 
     void Execute(const Playlist::Item::Storage& stor, Log::ProgressCallback& cb) override
     {
-      const std::size_t totalItems = SelectedItems ? SelectedItems->size() : stor.CountItems();
-      const Log::ProgressCallback::Ptr progress = Log::CreatePercentProgressCallback(totalItems, cb);
-      SearchVisitor visitor(Pred, *progress);
-      if (SelectedItems)
-      {
-        stor.ForSpecifiedItems(*SelectedItems, visitor);
-      }
-      else
-      {
-        stor.ForAllItems(visitor);
-      }
+      SearchVisitor visitor(Pred);
+      ExecuteOperation(stor, SelectedItems, visitor, cb);
       emit ResultAcquired(visitor.GetResult());
     }
   private:
@@ -62,6 +62,12 @@ namespace
 
   template<class T>
   QString BuildPlaylistFileName(const T& val)
+  {
+    return QString::fromAscii("%1.zxpl").arg(val);
+  }
+
+  template<class T>
+  QString BuildLegacyPlaylistFileName(const T& val)
   {
     return QString::fromAscii("%1.xspf").arg(val);
   }
@@ -76,6 +82,11 @@ namespace
       Require(Directory.mkpath(dirPath));
       Require(Directory.cd(dirPath));
       Files = Directory.entryList(QStringList(BuildPlaylistFileName('*')), QDir::Files | QDir::Readable, QDir::Name);
+      if (Files.empty())
+      {
+        //stored by previous versions, will be replaced by snapshots at next save
+        Files = Directory.entryList(QStringList(BuildLegacyPlaylistFileName('*')), QDir::Files | QDir::Readable, QDir::Name);
+      }
       Dbg("%1% stored playlists", Files.size());
     }
 
@@ -113,7 +124,7 @@ namespace
         const Playlist::Controller::Ptr ctrl = it->Get();
         const QString& fileName = BuildPlaylistFileName(idx);
         const QString& fullPath = Directory.absoluteFilePath(fileName);
-        Playlist::Save(ctrl, fullPath, 0);
+        Playlist::SaveSnapshot(ctrl, fullPath);
         tasks.Add(ctrl);
         newFiles.push_back(fileName);
       }
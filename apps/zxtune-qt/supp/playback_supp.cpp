@@ -17,6 +17,7 @@
 #include <error.h>
 #include <pointers.h>
 //library includes
+#include <module/players/end_detector.h>
 #include <parameters/merged_accessor.h>
 #include <sound/service.h>
 //qt includes
@@ -214,9 +215,10 @@ namespace
       return false;
     }
 
-    Sound::Backend::Ptr CreateBackend(Module::Holder::Ptr module)
+    Sound::Backend::Ptr CreateBackend(Module::Holder::Ptr holder)
     {
       //create backend
+      const Module::Holder::Ptr module = Module::CreateEndDetectingHolder(std::move(holder));
       const Sound::BackendCallback::Ptr cb(static_cast<Sound::BackendCallback*>(this), NullDeleter<Sound::BackendCallback>());
       std::list<Error> errors;
       const Strings::Array systemBackends = Service->GetAvailableBackends();
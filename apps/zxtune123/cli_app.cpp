@@ -13,10 +13,12 @@
 #include "console.h"
 #include "display.h"
 #include "information.h"
+#include "pcm_digest.h"
 #include "sound.h"
 #include "source.h"
 //common includes
 #include <error_tools.h>
+#include <make_ptr.h>
 #include <progress_callback.h>
 //library includes
 #include <async/data_receiver.h>
@@ -29,19 +31,26 @@
 #include <module/attributes.h>
 #include <module/conversion/api.h>
 #include <module/conversion/types.h>
+#include <module/players/end_detector.h>
 #include <parameters/merged_accessor.h>
 #include <parameters/template.h>
 #include <platform/application.h>
 #include <platform/version/api.h>
+#include <sound/render_params.h>
 #include <sound/sound_parameters.h>
+#include <strings/template.h>
 #include <time/duration.h>
 #include <time/timer.h>
 //std includes
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <mutex>
 #include <numeric>
+#include <thread>
 //boost includes
 #include <boost/program_options.hpp>
 //text includes
@@ -299,6 +308,225 @@ namespace
     DisplayComponent& Display;
   };
 
+  class DurationProber : public OnItemCallback
+  {
+  public:
+    DurationProber(Parameters::Accessor::Ptr params, DisplayComponent& display)
+      : Params(std::move(params))
+      , Display(display)
+    {
+    }
+
+    void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
+    {
+      const Module::Information::Ptr info = holder->GetModuleInformation();
+      const Parameters::Accessor::Ptr props = holder->GetModuleProperties();
+      String path, type;
+      props->FindValue(Module::ATTR_FULLPATH, path);
+      props->FindValue(Module::ATTR_TYPE, type);
+
+      const Parameters::Accessor::Ptr params = Parameters::CreateMergedAccessor(props, Params);
+      //no sound is required, so fast-forward chips state where possible
+      Module::Renderer::Ptr renderer = Module::CreateFastForwardEndDetectingRenderer(*holder, params);
+      if (!renderer)
+      {
+        renderer = Module::CreateEndDetectingRenderer(*holder, params, Sound::Receiver::CreateStub());
+      }
+      uint_t frames = 1;
+      while (renderer->RenderFrame())
+      {
+        ++frames;
+      }
+      const Time::Microseconds frameDuration = Sound::GetFrameDuration(*params);
+      Display.Message(Strings::Format(Text::PROBE_DURATION_RESULT, path, type,
+        Time::MicrosecondsDuration(info->FramesCount(), frameDuration).ToString(),
+        Time::MicrosecondsDuration(frames, frameDuration).ToString()));
+    }
+  private:
+    const Parameters::Accessor::Ptr Params;
+    DisplayComponent& Display;
+  };
+
+  //renders modules simultaneously using own thread of each backend
+  class BatchRenderer : public OnItemCallback
+  {
+  public:
+    BatchRenderer(uint_t threads, SoundComponent& sound, DisplayComponent& display)
+      : Threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+      , Sounder(sound)
+      , Display(display)
+      , Failed()
+    {
+    }
+
+    void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
+    {
+      WaitForActive(Threads - 1);
+      Job job;
+      job.Id = GetModuleId(*holder->GetModuleProperties());
+      job.Callback = MakePtr<JobCallback>(Guard, Event);
+      try
+      {
+        job.Backend = Sounder.CreateBackend(holder, String(), job.Callback);
+        job.Backend->GetPlaybackControl()->Play();
+      }
+      catch (const Error& e)
+      {
+        //keep processing the rest of modules in container
+        Display.Message(Strings::Format(Text::BATCH_FAILED, job.Id));
+        Display.Message(e.ToString());
+        ++Failed;
+        return;
+      }
+      Active.push_back(std::move(job));
+    }
+
+    //! @throw Error if any of modules failed to render
+    void Finish()
+    {
+      WaitForActive(0);
+      if (Failed)
+      {
+        throw MakeFormattedError(THIS_LINE, Text::BATCH_ERROR_FAILED, Failed);
+      }
+    }
+  private:
+    class JobCallback : public Sound::BackendCallback
+    {
+    public:
+      typedef std::shared_ptr<JobCallback> Ptr;
+
+      JobCallback(std::mutex& guard, std::condition_variable& event)
+        : Guard(guard)
+        , Event(event)
+        , Done(false)
+        , Finished(false)
+      {
+      }
+
+      void OnStart() override
+      {
+      }
+
+      void OnFrame(const Module::TrackState& /*state*/) override
+      {
+      }
+
+      //called at the end of playback in any case, including rendering errors
+      void OnStop() override
+      {
+        {
+          const std::lock_guard<std::mutex> lock(Guard);
+          Done = true;
+        }
+        Event.notify_one();
+      }
+
+      void OnPause() override
+      {
+      }
+
+      void OnResume() override
+      {
+      }
+
+      //called only when module is rendered till the end, before OnStop
+      void OnFinish() override
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        Finished = true;
+      }
+
+      //called under lock
+      bool IsDone() const
+      {
+        return Done;
+      }
+
+      //called under lock
+      bool IsFinished() const
+      {
+        return Finished;
+      }
+    private:
+      std::mutex& Guard;
+      std::condition_variable& Event;
+      bool Done;
+      bool Finished;
+    };
+
+    struct Job
+    {
+      String Id;
+      JobCallback::Ptr Callback;
+      Sound::Backend::Ptr Backend;
+    };
+
+    void WaitForActive(std::size_t limit)
+    {
+      while (Active.size() > limit)
+      {
+        std::vector<Job> done;
+        {
+          std::unique_lock<std::mutex> lock(Guard);
+          const auto isDone = [](const Job& job) {return job.Callback->IsDone();};
+          Event.wait(lock, [this, &isDone]() {return std::any_of(Active.begin(), Active.end(), isDone);});
+          const auto firstActive = std::stable_partition(Active.begin(), Active.end(), isDone);
+          std::move(Active.begin(), firstActive, std::back_inserter(done));
+          Active.erase(Active.begin(), firstActive);
+          for (const auto& job : done)
+          {
+            Display.Message(Strings::Format(job.Callback->IsFinished() ? Text::BATCH_DONE : Text::BATCH_FAILED, job.Id));
+            Failed += !job.Callback->IsFinished();
+          }
+        }
+        //finished backends are destroyed outside of lock since it waits for playback threads taking the lock in callbacks
+      }
+    }
+  private:
+    const std::size_t Threads;
+    SoundComponent& Sounder;
+    DisplayComponent& Display;
+    std::mutex Guard;
+    std::condition_variable Event;
+    std::vector<Job> Active;
+    std::size_t Failed;
+  };
+
+  class Prober : public OnProbeCallback
+  {
+  public:
+    Prober(const String& outputTemplate, DisplayComponent& display)
+      : OutputTemplate(Strings::Template::Create(outputTemplate))
+      , Display(display)
+    {
+    }
+
+    void ProcessItem(Module::Information::Ptr info, Parameters::Accessor::Ptr props) override
+    {
+      const String& fields = OutputTemplate->Instantiate(Parameters::FieldsSourceAdapter<Strings::FillFieldsSource>(*props));
+      const uint_t frames = info->FramesCount();
+      //module's properties may override global frame duration
+      const String& duration = Time::MicrosecondsDuration(frames, Sound::GetFrameDuration(*props)).ToString();
+      Message(Strings::Format(Text::PROBE_RESULT, fields, duration, frames));
+    }
+
+    void ProcessError(const Error& err) override
+    {
+      Message(err.ToString());
+    }
+  private:
+    void Message(const String& msg)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Display.Message(msg);
+    }
+  private:
+    const Strings::Template::Ptr OutputTemplate;
+    DisplayComponent& Display;
+    std::mutex Guard;
+  };
+
   class CLIApplication : public Platform::Application
                        , private OnItemCallback
   {
@@ -311,6 +539,12 @@ namespace
       , Display(DisplayComponent::Create())
       , SeekStep(10)
       , BenchmarkIterations(0)
+      , ProbeMode(false)
+      , ProbeTemplate(Text::PROBE_DEFAULT_TEMPLATE)
+      , ProbeThreads(0)
+      , ProbeDuration(false)
+      , BatchMode(false)
+      , BatchThreads(0)
     {
     }
 
@@ -334,11 +568,36 @@ namespace
           Convertor cnv(*mergedParams, *Display);
           Sourcer->ProcessItems(cnv);
         }
+        else if (!PcmDigestParams.empty())
+        {
+          const Parameters::Container::Ptr digestParams = Parameters::Container::Create();
+          ParseParametersString(Parameters::NameType(), PcmDigestParams, *digestParams);
+          const PcmDigestComponent::Ptr digest = PcmDigestComponent::Create(*digestParams, ConfigParams, *Display);
+          Sourcer->ProcessItems(*digest);
+          digest->Finish();
+        }
         else if (0 != BenchmarkIterations)
         {
           Benchmark benchmark(BenchmarkIterations, *Sounder, *Display);
           Sourcer->ProcessItems(benchmark);
         }
+        else if (ProbeMode)
+        {
+          Prober prober(ProbeTemplate, *Display);
+          Sourcer->ProbeItems(prober, ProbeThreads);
+        }
+        else if (ProbeDuration)
+        {
+          DurationProber prober(ConfigParams, *Display);
+          Sourcer->ProcessItems(prober);
+        }
+        else if (BatchMode)
+        {
+          Sounder->Initialize();
+          BatchRenderer batch(BatchThreads, *Sounder, *Display);
+          Sourcer->ProcessItems(batch);
+          batch.Finish();
+        }
         else
         {
           Sounder->Initialize();
@@ -366,6 +625,13 @@ namespace
           (Text::CONFIG_KEY, boost::program_options::value<String>(&configFile), Text::CONFIG_DESC)
           (Text::CONVERT_KEY, boost::program_options::value<String>(&ConvertParams), Text::CONVERT_DESC)
           (Text::BENCHMARK_KEY, boost::program_options::value<uint_t>(&BenchmarkIterations), Text::BENCHMARK_DESC)
+          (Text::PROBE_KEY, boost::program_options::bool_switch(&ProbeMode), Text::PROBE_DESC)
+          (Text::PROBE_TEMPLATE_KEY, boost::program_options::value<String>(&ProbeTemplate), Text::PROBE_TEMPLATE_DESC)
+          (Text::PROBE_THREADS_KEY, boost::program_options::value<uint_t>(&ProbeThreads), Text::PROBE_THREADS_DESC)
+          (Text::PROBE_DURATION_KEY, boost::program_options::bool_switch(&ProbeDuration), Text::PROBE_DURATION_DESC)
+          (Text::PCM_DIGEST_KEY, boost::program_options::value<String>(&PcmDigestParams), Text::PCM_DIGEST_DESC)
+          (Text::BATCH_KEY, boost::program_options::bool_switch(&BatchMode), Text::BATCH_DESC)
+          (Text::BATCH_THREADS_KEY, boost::program_options::value<uint_t>(&BatchThreads), Text::BATCH_THREADS_DESC)
         ;
 
         options.add(Informer->GetOptionsDescription());
@@ -509,6 +775,13 @@ namespace
     std::unique_ptr<DisplayComponent> Display;
     uint_t SeekStep;
     uint_t BenchmarkIterations;
+    bool ProbeMode;
+    String ProbeTemplate;
+    uint_t ProbeThreads;
+    bool ProbeDuration;
+    String PcmDigestParams;
+    bool BatchMode;
+    uint_t BatchThreads;
   };
 }
 
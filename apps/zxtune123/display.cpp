@@ -154,9 +154,9 @@ namespace
         ShowPlaybackStatus(curFrame, state);
         if (Analyzer)
         {
-          const auto& curAnalyze = Analyzer->GetState();
+          Analyzer->GetState(0, AnalyzerState);
           AnalyzerData.resize(ScrSize.first);
-          UpdateAnalyzer(curAnalyze, 10);
+          UpdateAnalyzer(AnalyzerState, 10);
           ShowAnalyzer(spectrumHeight);
         }
       }
@@ -228,6 +228,7 @@ namespace
     Time::Microseconds FrameDuration;
     Module::TrackState::Ptr TrackState;
     Module::Analyzer::Ptr Analyzer;
+    std::vector<Module::Analyzer::ChannelState> AnalyzerState;
     std::vector<int_t> AnalyzerData;
   };
 }
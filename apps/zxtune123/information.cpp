@@ -288,6 +288,12 @@ namespace
       OptionDesc(Parameters::ZXTune::Sound::LOOPED,
                  Text::INFO_OPTIONS_SOUND_LOOPED,
                  EMPTY),
+      OptionDesc(Parameters::ZXTune::Sound::SILENCE_LIMIT,
+                 Text::INFO_OPTIONS_SOUND_SILENCE_LIMIT,
+                 Parameters::ZXTune::Sound::SILENCE_LIMIT_DEFAULT),
+      OptionDesc(Parameters::ZXTune::Sound::REPEAT_LIMIT,
+                 Text::INFO_OPTIONS_SOUND_REPEAT_LIMIT,
+                 Parameters::ZXTune::Sound::REPEAT_LIMIT_DEFAULT),
       //Mixer parameters
       OptionDesc(Text::INFO_OPTIONS_SOUND_MIXER_TITLE, EMPTY, 0),
       OptionDesc(Parameters::ZXTune::Sound::Mixer::PREFIX + Text::INFO_OPTIONS_SOUND_MIXER_TEMPLATE,
@@ -381,6 +387,9 @@ namespace
       OptionDesc(Parameters::ZXTune::Core::AYM::LAYOUT,
                  Text::INFO_OPTIONS_CORE_AYM_LAYOUT,
                  EMPTY),
+      OptionDesc(Parameters::ZXTune::Core::AYM::CACHE,
+                 Text::INFO_OPTIONS_CORE_AYM_CACHE,
+                 Parameters::ZXTune::Core::AYM::CACHE_DEFAULT),
       OptionDesc(Parameters::ZXTune::Core::DAC::INTERPOLATION,
                  Text::INFO_OPTIONS_CORE_DAC_INTERPOLATION,
                  Parameters::ZXTune::Core::DAC::INTERPOLATION_DEFAULT),
@@ -393,6 +402,9 @@ namespace
       OptionDesc(Parameters::ZXTune::Core::FM::CLOCKRATE,
                  Text::INFO_OPTIONS_CORE_FM_CLOCKRATE,
                  Parameters::ZXTune::Core::FM::CLOCKRATE_DEFAULT),
+      OptionDesc(Parameters::ZXTune::Core::FM::ENGINE,
+                 Text::INFO_OPTIONS_CORE_FM_ENGINE,
+                 Parameters::ZXTune::Core::FM::ENGINE_DEFAULT),
       OptionDesc(Parameters::ZXTune::Core::SAA::CLOCKRATE,
                  Text::INFO_OPTIONS_CORE_SAA_CLOCKRATE,
                  Parameters::ZXTune::Core::SAA::CLOCKRATE_DEFAULT),
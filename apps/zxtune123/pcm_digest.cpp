@@ -0,0 +1,332 @@
+/**
+*
+* @file
+*
+* @brief Rendered sound regression checking implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "display.h"
+#include "pcm_digest.h"
+//common includes
+#include <crc.h>
+#include <error_tools.h>
+#include <make_ptr.h>
+#include <pointers.h>
+#include <progress_callback.h>
+//library includes
+#include <binary/container_factories.h>
+#include <io/api.h>
+#include <io/template.h>
+#include <module/attributes.h>
+#include <parameters/merged_accessor.h>
+#include <parameters/template.h>
+#include <sound/render_params.h>
+#include <strings/format.h>
+#include <time/timer.h>
+//std includes
+#include <cmath>
+#include <sstream>
+//text includes
+#include "text/text.h"
+
+#define FILE_TAG 2F6D1A43
+
+namespace
+{
+  const std::size_t DEFAULT_BLOCK_SIZE = 16384;
+
+  /*
+    Compact description of rendered sound: exact checksum and rms level for every block of samples plus rendering speed.
+    Checksums are used for bit-exact comparison, levels - for approximate one.
+  */
+  struct PcmDigest
+  {
+    struct Block
+    {
+      Block()
+        : Crc()
+        , Level()
+      {
+      }
+
+      uint32_t Crc;
+      uint_t Level;
+    };
+
+    PcmDigest()
+      : Frequency()
+      , BlockSize()
+      , Samples()
+      , Speed()
+    {
+    }
+
+    uint_t Frequency;
+    std::size_t BlockSize;
+    std::size_t Samples;
+    //relative to realtime
+    double Speed;
+    std::vector<Block> Blocks;
+
+    String Serialize() const
+    {
+      std::ostringstream str;
+      str << Frequency << ' ' << BlockSize << ' ' << Samples << ' ' << Speed << '\n';
+      str << std::hex;
+      for (const auto& blk : Blocks)
+      {
+        str << blk.Crc << ' ' << blk.Level << '\n';
+      }
+      return str.str();
+    }
+
+    static bool Parse(const Binary::Data& data, PcmDigest& result)
+    {
+      std::istringstream str(String(static_cast<const char*>(data.Start()), data.Size()));
+      if (!(str >> result.Frequency >> result.BlockSize >> result.Samples >> result.Speed))
+      {
+        return false;
+      }
+      str >> std::hex;
+      Block blk;
+      while (str >> blk.Crc >> blk.Level)
+      {
+        result.Blocks.push_back(blk);
+      }
+      return str.eof();
+    }
+  };
+
+  class DigestReceiver : public Sound::Receiver
+  {
+  public:
+    typedef std::shared_ptr<DigestReceiver> Ptr;
+
+    DigestReceiver(std::size_t blockSize, PcmDigest& result)
+      : BlockSize(blockSize)
+      , Result(result)
+      , Filled()
+      , Crc()
+      , Squares()
+    {
+    }
+
+    void ApplyData(Sound::Chunk::Ptr data) override
+    {
+      for (const Sound::Sample* it = data->data(), *lim = it + data->size(); it != lim; )
+      {
+        const std::size_t toProcess = std::min<std::size_t>(lim - it, BlockSize - Filled);
+        Crc = Crc32(safe_ptr_cast<const uint8_t*>(it), toProcess * sizeof(*it), Crc);
+        for (const Sound::Sample* const end = it + toProcess; it != end; ++it)
+        {
+          const int64_t left = it->Left();
+          const int64_t right = it->Right();
+          Squares += left * left + right * right;
+        }
+        Result.Samples += toProcess;
+        if ((Filled += toProcess) == BlockSize)
+        {
+          Finish();
+        }
+      }
+    }
+
+    void Flush() override
+    {
+    }
+
+    //called after rendering to store last incomplete block
+    void Finish()
+    {
+      if (Filled)
+      {
+        PcmDigest::Block blk;
+        blk.Crc = Crc;
+        blk.Level = static_cast<uint_t>(std::sqrt(double(Squares) / (Filled * Sound::Sample::CHANNELS)) + 0.5);
+        Result.Blocks.push_back(blk);
+        Filled = 0;
+        Crc = 0;
+        Squares = 0;
+      }
+    }
+  private:
+    const std::size_t BlockSize;
+    PcmDigest& Result;
+    std::size_t Filled;
+    uint32_t Crc;
+    uint64_t Squares;
+  };
+
+  template<class T>
+  T GetModeParameter(const Parameters::Accessor& params, const Char* name, T defVal)
+  {
+    Parameters::IntType val = defVal;
+    params.FindValue(ToStdString(name), val);
+    if (val < 0)
+    {
+      throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_INVALID_PARAMETER, name);
+    }
+    return static_cast<T>(val);
+  }
+
+  String GetFilenameTemplate(const Parameters::Accessor& params)
+  {
+    String nameTemplate;
+    if (!params.FindValue(ToStdString(Text::CONVERSION_PARAM_FILENAME), nameTemplate))
+    {
+      throw Error(THIS_LINE, Text::CONVERT_ERROR_NO_FILENAME);
+    }
+    return nameTemplate;
+  }
+
+  class PcmDigestComponentImpl : public PcmDigestComponent
+  {
+  public:
+    PcmDigestComponentImpl(const Parameters::Accessor& modeParams, Parameters::Accessor::Ptr configParams, DisplayComponent& display)
+      : Params(std::move(configParams))
+      , Display(display)
+      , FileNameTemplate(IO::CreateFilenameTemplate(GetFilenameTemplate(modeParams)))
+      , BlockSize(GetModeParameter<std::size_t>(modeParams, Text::PCM_DIGEST_PARAM_BLOCK, DEFAULT_BLOCK_SIZE))
+      , Tolerance(GetModeParameter<uint_t>(modeParams, Text::PCM_DIGEST_PARAM_TOLERANCE, 0))
+      , Slowdown(GetModeParameter<uint_t>(modeParams, Text::PCM_DIGEST_PARAM_SLOWDOWN, 0))
+      , Processed()
+      , Failed()
+    {
+      if (!BlockSize)
+      {
+        throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_INVALID_PARAMETER, Text::PCM_DIGEST_PARAM_BLOCK);
+      }
+    }
+
+    void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
+    {
+      const Parameters::Accessor::Ptr props = holder->GetModuleProperties();
+      String id;
+      props->FindValue(Module::ATTR_FULLPATH, id);
+      const String& filename = FileNameTemplate->Instantiate(Parameters::FieldsSourceAdapter<Strings::SkipFieldsSource>(*props));
+      ++Processed;
+      try
+      {
+        const PcmDigest& digest = Render(*holder);
+        PcmDigest reference;
+        if (!LoadReference(filename, reference))
+        {
+          Store(filename, digest);
+          Display.Message(Strings::Format(Text::PCM_DIGEST_STORED, id, digest.Blocks.size(), digest.Speed));
+        }
+        else
+        {
+          Display.Message(Compare(id, digest, reference));
+        }
+      }
+      catch (const Error& e)
+      {
+        ++Failed;
+        Display.Message(e.ToString());
+      }
+    }
+
+    void Finish() override
+    {
+      if (Failed)
+      {
+        throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_FAILED, Failed, Processed);
+      }
+    }
+  private:
+    PcmDigest Render(const Module::Holder& holder) const
+    {
+      const Parameters::Accessor::Ptr params = Parameters::CreateMergedAccessor(holder.GetModuleProperties(), Params);
+      PcmDigest result;
+      result.Frequency = Sound::RenderParameters::Create(params)->SoundFreq();
+      result.BlockSize = BlockSize;
+      const DigestReceiver::Ptr target = MakePtr<DigestReceiver>(BlockSize, result);
+      const Module::Renderer::Ptr renderer = holder.CreateRenderer(params, target);
+      const Time::Timer timer;
+      while (renderer->RenderFrame())
+      {
+      }
+      const double elapsed = double(timer.Elapsed().Get()) / Time::Timer::NativeStamp::PER_SECOND;
+      target->Finish();
+      const double duration = double(result.Samples) / result.Frequency;
+      result.Speed = duration / std::max(elapsed, 1e-6);
+      return result;
+    }
+
+    bool LoadReference(const String& filename, PcmDigest& result) const
+    {
+      Binary::Container::Ptr data;
+      try
+      {
+        data = IO::OpenData(filename, *Params, Log::ProgressCallback::Stub());
+      }
+      catch (const Error&)
+      {
+        return false;
+      }
+      if (!PcmDigest::Parse(*data, result))
+      {
+        throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_INVALID_REFERENCE, filename);
+      }
+      return true;
+    }
+
+    void Store(const String& filename, const PcmDigest& digest) const
+    {
+      const String& content = digest.Serialize();
+      const Binary::OutputStream::Ptr stream = IO::CreateStream(filename, *Params, Log::ProgressCallback::Stub());
+      stream->ApplyData(*Binary::CreateContainer(content.data(), content.size()));
+    }
+
+    String Compare(const String& id, const PcmDigest& digest, const PcmDigest& reference)
+    {
+      if (digest.Frequency != reference.Frequency || digest.BlockSize != reference.BlockSize)
+      {
+        throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_SETUP, id, reference.Frequency, reference.BlockSize);
+      }
+      if (digest.Samples != reference.Samples || digest.Blocks.size() != reference.Blocks.size())
+      {
+        throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_LENGTH, id, digest.Samples, reference.Samples);
+      }
+      std::size_t approximate = 0;
+      for (std::size_t idx = 0, lim = digest.Blocks.size(); idx != lim; ++idx)
+      {
+        const PcmDigest::Block& cur = digest.Blocks[idx];
+        const PcmDigest::Block& ref = reference.Blocks[idx];
+        if (cur.Crc == ref.Crc)
+        {
+          continue;
+        }
+        const uint_t diff = cur.Level > ref.Level ? cur.Level - ref.Level : ref.Level - cur.Level;
+        if (diff > Tolerance)
+        {
+          throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_BLOCK, id, idx, cur.Level, ref.Level);
+        }
+        ++approximate;
+      }
+      if (Slowdown && digest.Speed * 100 < reference.Speed * (100 - std::min<uint_t>(Slowdown, 100)))
+      {
+        throw MakeFormattedError(THIS_LINE, Text::PCM_DIGEST_ERROR_SPEED, id, digest.Speed, reference.Speed);
+      }
+      return Strings::Format(Text::PCM_DIGEST_PASSED, id, approximate, digest.Blocks.size(), digest.Speed, reference.Speed);
+    }
+  private:
+    const Parameters::Accessor::Ptr Params;
+    DisplayComponent& Display;
+    const Strings::Template::Ptr FileNameTemplate;
+    const std::size_t BlockSize;
+    const uint_t Tolerance;
+    const uint_t Slowdown;
+    std::size_t Processed;
+    std::size_t Failed;
+  };
+}
+
+PcmDigestComponent::Ptr PcmDigestComponent::Create(const Parameters::Accessor& modeParams, Parameters::Accessor::Ptr configParams, DisplayComponent& display)
+{
+  return PcmDigestComponent::Ptr(new PcmDigestComponentImpl(modeParams, std::move(configParams), display));
+}
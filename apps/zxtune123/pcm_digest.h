@@ -0,0 +1,31 @@
+/**
+*
+* @file
+*
+* @brief Rendered sound regression checking interface
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//local includes
+#include "source.h"
+//std includes
+#include <memory>
+
+class DisplayComponent;
+
+class PcmDigestComponent : public OnItemCallback
+{
+public:
+  typedef std::unique_ptr<PcmDigestComponent> Ptr;
+
+  //! @throw Error if any of processed modules failed the check
+  virtual void Finish() = 0;
+
+  //! @param modeParams Digest mode parameters (filename template, block size, tolerances)
+  //! @param configParams Rendering parameters
+  static Ptr Create(const Parameters::Accessor& modeParams, Parameters::Accessor::Ptr configParams, DisplayComponent& display);
+};
@@ -17,6 +17,7 @@
 #include <core/core_parameters.h>
 #include <debug/log.h>
 #include <math/numeric.h>
+#include <module/players/end_detector.h>
 #include <parameters/merged_accessor.h>
 #include <parameters/serialize.h>
 #include <platform/application.h>
@@ -143,6 +144,8 @@ namespace
         (Text::FRAMEDURATION_KEY, value<String>(&SoundOptions[Parameters::ZXTune::Sound::FRAMEDURATION.FullPath()]), Text::FRAMEDURATION_DESC)
         (Text::FREQTABLE_KEY, value<String>(&SoundOptions[Parameters::ZXTune::Core::AYM::TABLE.FullPath()]), Text::FREQTABLE_DESC)
         (Text::LOOP_KEY, bool_switch(&Looped), Text::LOOP_DESC)
+        (Text::SILENCE_LIMIT_KEY, value<String>(&SoundOptions[Parameters::ZXTune::Sound::SILENCE_LIMIT.FullPath()]), Text::SILENCE_LIMIT_DESC)
+        (Text::REPEAT_LIMIT_KEY, value<String>(&SoundOptions[Parameters::ZXTune::Sound::REPEAT_LIMIT.FullPath()]), Text::REPEAT_LIMIT_DESC)
       ;
     }
 
@@ -181,8 +184,9 @@ namespace
     {
     }
 
-    Sound::Backend::Ptr CreateBackend(Module::Holder::Ptr module, const String& typeHint, Sound::BackendCallback::Ptr callback) override
+    Sound::Backend::Ptr CreateBackend(Module::Holder::Ptr holder, const String& typeHint, Sound::BackendCallback::Ptr callback) override
     {
+      const Module::Holder::Ptr module = Module::CreateEndDetectingHolder(std::move(holder));
       if (!typeHint.empty())
       {
         return Service->CreateBackend(typeHint, module, callback);
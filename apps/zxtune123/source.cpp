@@ -19,18 +19,24 @@
 #include <core/core_parameters.h>
 #include <core/module_detect.h>
 #include <core/module_open.h>
+#include <core/module_probe.h>
 #include <core/plugin.h>
 #include <core/plugin_attrs.h>
 #include <io/api.h>
 #include <io/providers_parameters.h>
 #include <module/properties/path.h>
 #include <parameters/merged_accessor.h>
+#include <parameters/snapshot.h>
 #include <platform/application.h>
 #include <strings/array.h>
 #include <time/elapsed.h>
 //std includes
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <iostream>
+#include <thread>
+#include <vector>
 //boost includes
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -137,6 +143,35 @@ namespace
     const Log::ProgressCallback::Ptr ProgressCallback;
   };
 
+  //used for the data not probed directly (containers, multitrack modules, formats without prober)
+  class ProbeDetectCallback : public Module::DetectCallback
+  {
+  public:
+    ProbeDetectCallback(Parameters::Accessor::Ptr params, IO::Identifier::Ptr id, OnProbeCallback& callback)
+      : Params(std::move(params))
+      , Id(std::move(id))
+      , Callback(callback)
+    {
+    }
+
+    void ProcessModule(ZXTune::DataLocation::Ptr location, ZXTune::Plugin::Ptr /*decoder*/, Module::Holder::Ptr holder) const override
+    {
+      const IO::Identifier::Ptr subId = Id->WithSubpath(location->GetPath()->AsString());
+      const Parameters::Accessor::Ptr pathProps = Module::CreatePathProperties(subId);
+      Callback.ProcessItem(holder->GetModuleInformation(), Parameters::CreateMergedAccessor(pathProps, holder->GetModuleProperties(), Params));
+    }
+
+    Log::ProgressCallback* GetProgress() const override
+    {
+      //console is shared with other probing threads
+      return nullptr;
+    }
+  private:
+    const Parameters::Accessor::Ptr Params;
+    const IO::Identifier::Ptr Id;
+    OnProbeCallback& Callback;
+  };
+
   class Source : public SourceComponent
   {
   public:
@@ -202,26 +237,51 @@ namespace
         ProcessItem(*it, callback);
       }
     }
+
+    void ProbeItems(OnProbeCallback& callback, uint_t threads) override
+    {
+      const std::size_t workersCount = std::min<std::size_t>(Files.size(), threads ? threads : std::max(1u, std::thread::hardware_concurrency()));
+      std::atomic<std::size_t> nextFile(0);
+      const auto worker = [this, &nextFile, &callback]()
+      {
+        for (std::size_t idx = nextFile++; idx < Files.size(); idx = nextFile++)
+        {
+          ProbeItem(Files[idx], callback);
+        }
+      };
+      std::vector<std::thread> workers;
+      for (std::size_t idx = 1; idx < workersCount; ++idx)
+      {
+        workers.emplace_back(worker);
+      }
+      worker();
+      for (auto& thr : workers)
+      {
+        thr.join();
+      }
+    }
   private:
     void ProcessItem(const String& uri, OnItemCallback& callback) const
     {
       try
       {
         const IO::Identifier::Ptr id = IO::ResolveUri(uri);
+        //parameters are not changed while item is processed, so all the lookups are performed in flat copy
+        const Parameters::Accessor::Ptr params = Parameters::CreateSnapshot(*Params);
 
-        const DetectCallback detectCallback(Params, id, callback, ShowProgress);
-        const Binary::Container::Ptr data = IO::OpenData(id->Path(), *Params, Log::ProgressCallback::Stub());
+        const DetectCallback detectCallback(params, id, callback, ShowProgress);
+        const Binary::Container::Ptr data = IO::OpenData(id->Path(), *params, Log::ProgressCallback::Stub());
 
         const String subpath = id->Subpath();
         if (subpath.empty())
         {
           const ZXTune::DataLocation::Ptr location = ZXTune::CreateLocation(data);
-          Module::Detect(*Params, location, detectCallback);
+          Module::Detect(*params, location, detectCallback);
         }
         else
         {
-          const ZXTune::DataLocation::Ptr location = ZXTune::OpenLocation(*Params, data, subpath);
-          Module::Open(*Params, location, detectCallback);
+          const ZXTune::DataLocation::Ptr location = ZXTune::OpenLocation(*params, data, subpath);
+          Module::Open(*params, location, detectCallback);
         }
       }
       catch (const Error& e)
@@ -229,6 +289,44 @@ namespace
         StdOut << e.ToString();
       }
     }
+
+    void ProbeItem(const String& uri, OnProbeCallback& callback) const
+    {
+      try
+      {
+        const IO::Identifier::Ptr id = IO::ResolveUri(uri);
+        const Parameters::Accessor::Ptr params = Parameters::CreateSnapshot(*Params);
+        const Binary::Container::Ptr data = IO::OpenData(id->Path(), *params, Log::ProgressCallback::Stub());
+        const String subpath = id->Subpath();
+        const ZXTune::DataLocation::Ptr location = subpath.empty()
+          ? ZXTune::CreateLocation(data)
+          : ZXTune::OpenLocation(*params, data, subpath);
+        const Parameters::Container::Ptr moduleProps = Parameters::Container::Create();
+        if (const Module::Information::Ptr info = Module::Probe(*params, *location->GetData(), *moduleProps))
+        {
+          const Parameters::Accessor::Ptr pathProps = Module::CreatePathProperties(id);
+          callback.ProcessItem(info, Parameters::CreateMergedAccessor(pathProps, moduleProps, params));
+        }
+        else
+        {
+          //fallback to regular detection
+          const ProbeDetectCallback detectCallback(params, id, callback);
+          if (subpath.empty())
+          {
+            Module::Detect(*params, location, detectCallback);
+          }
+          else
+          {
+            Module::Open(*params, location, detectCallback);
+          }
+        }
+      }
+      catch (const Error& e)
+      {
+        //output is shared with other probing threads
+        callback.ProcessError(e);
+      }
+    }
   private:
     const Parameters::Container::Ptr Params;
     boost::program_options::options_description OptionsDescription;
@@ -10,8 +10,11 @@
 
 #pragma once
 
+//common includes
+#include <error.h>
 //library includes
 #include <module/holder.h>
+#include <module/information.h>
 #include <parameters/container.h>
 //std includes
 #include <memory>
@@ -36,6 +39,17 @@ public:
   virtual void ProcessItem(Binary::Data::Ptr data, Module::Holder::Ptr holder) = 0;
 };
 
+class OnProbeCallback
+{
+public:
+  virtual ~OnProbeCallback() = default;
+
+  //! @note Called concurrently from probing threads
+  virtual void ProcessItem(Module::Information::Ptr info, Parameters::Accessor::Ptr props) = 0;
+  //! @note Called concurrently from probing threads
+  virtual void ProcessError(const Error& err) = 0;
+};
+
 class SourceComponent
 {
 public:
@@ -46,6 +60,8 @@ public:
   // throw
   virtual void Initialize() = 0;
   virtual void ProcessItems(OnItemCallback& callback) = 0;
+  //! @param threads Probing threads count, 0 to use all the hardware threads
+  virtual void ProbeItems(OnProbeCallback& callback, uint_t threads) = 0;
 
   static std::unique_ptr<SourceComponent> Create(Parameters::Container::Ptr configParams);
 };
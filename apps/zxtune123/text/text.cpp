@@ -28,6 +28,37 @@ extern const Char ANALYZER_DESC[] = {
 extern const Char ANALYZER_KEY[] = {
   'a','n','a','l','y','z','e','r',0
 };
+extern const Char BATCH_DESC[] = {
+  'S','w','i','t','c','h',' ','o','n',' ','b','a','t','c','h',' ','r','e','n','d','e','r','i','n','g',' ','m',
+  'o','d','e','.',' ','M','o','d','u','l','e','s',' ','a','r','e',' ','r','e','n','d','e','r','e','d',' ','s',
+  'i','m','u','l','t','a','n','e','o','u','s','l','y',' ','t','o',' ','s','e','l','e','c','t','e','d',' ','b',
+  'a','c','k','e','n','d',' ','w','i','t','h','o','u','t',' ','i','n','t','e','r','a','c','t','i','o','n',',',
+  ' ','e','.','g','.',' ','e','a','c','h',' ','s','u','b','s','o','n','g',' ','o','f',' ','m','u','l','t','i',
+  't','r','a','c','k',' ','m','o','d','u','l','e',' ','t','o',' ','i','t','s',' ','o','w','n',' ','f','i','l',
+  'e','.','\n',0
+};
+extern const Char BATCH_DONE[] = {
+  'R','e','n','d','e','r','e','d',' ','\'','%','1','%','\'',0
+};
+extern const Char BATCH_ERROR_FAILED[] = {
+  '%','1','%',' ','m','o','d','u','l','e','s',' ','f','a','i','l','e','d',' ','t','o',' ','r','e','n','d','e',
+  'r','.',0
+};
+extern const Char BATCH_FAILED[] = {
+  'F','a','i','l','e','d',' ','t','o',' ','r','e','n','d','e','r',' ','\'','%','1','%','\'',0
+};
+extern const Char BATCH_KEY[] = {
+  'b','a','t','c','h',0
+};
+extern const Char BATCH_THREADS_DESC[] = {
+  'S','i','m','u','l','t','a','n','e','o','u','s','l','y',' ','r','e','n','d','e','r','e','d',' ','m','o','d',
+  'u','l','e','s',' ','c','o','u','n','t',' ','i','n',' ','b','a','t','c','h',' ','m','o','d','e','.',' ','D',
+  'e','f','a','u','l','t',' ','i','s',' ','h','a','r','d','w','a','r','e',' ','t','h','r','e','a','d','s',' ',
+  'c','o','u','n','t','.','\n',0
+};
+extern const Char BATCH_THREADS_KEY[] = {
+  'b','a','t','c','h','-','t','h','r','e','a','d','s',0
+};
 extern const Char BENCHMARK_DESC[] = {
   'S','w','i','t','c','h',' ','o','n',' ','b','e','n','c','h','m','a','r','k',' ','m','o','d','e',' ','w','i',
   't','h',' ','s','p','e','c','i','f','i','e','d',' ','i','t','e','r','a','t','i','o','n','s',' ','c','o','u',
@@ -447,6 +478,11 @@ extern const Char INFO_MOD_STREAM[] = {
 extern const Char INFO_MOD_TRACK[] = {
   'm','o','d','_','t','r','a','c','k',0
 };
+extern const Char INFO_OPTIONS_CORE_AYM_CACHE[] = {
+  'c','a','c','h','e',' ','r','e','g','i','s','t','e','r','s',' ','o','u','t','p','u','t',' ','o','f',' ','t',
+  'r','a','c','k','e','r',' ','m','o','d','u','l','e','s',' ','f','o','r',' ','f','a','s','t','e','r',' ','r',
+  'e','p','l','a','y','i','n','g',' ','a','n','d',' ','s','e','e','k','i','n','g',0
+};
 extern const Char INFO_OPTIONS_CORE_AYM_CLOCKRATE[] = {
   'c','l','o','c','k',' ','r','a','t','e',' ','f','o','r',' ','A','Y','M',' ','i','n',' ','H','z',0
 };
@@ -489,6 +525,10 @@ extern const Char INFO_OPTIONS_CORE_DAC_INTERPOLATION[] = {
 extern const Char INFO_OPTIONS_CORE_FM_CLOCKRATE[] = {
   'c','l','o','c','k',' ','r','a','t','e',' ','f','o','r',' ','F','M',' ','i','n',' ','H','z',0
 };
+extern const Char INFO_OPTIONS_CORE_FM_ENGINE[] = {
+  'F','M',' ','e','m','u','l','a','t','i','o','n',' ','e','n','g','i','n','e',' ','(','0','-',' ','r','e','f',
+  'e','r','e','n','c','e',',',' ','1','-',' ','b','a','t','c','h',')',0
+};
 extern const Char INFO_OPTIONS_CORE_PLUGINS_HRIP_IGNORE_CORRUPTED[] = {
   'i','g','n','o','r','e',' ','c','o','r','r','u','p','t','e','d',' ','b','l','o','c','k','s',' ','i','n',' ',
   'H','R','i','P',' ','a','r','c','h','i','v','e',0
@@ -662,6 +702,17 @@ extern const Char INFO_OPTIONS_SOUND_MIXER_TEMPLATE[] = {
 extern const Char INFO_OPTIONS_SOUND_MIXER_TITLE[] = {
   ' ','M','i','x','e','r',' ','o','p','t','i','o','n','s',':',0
 };
+extern const Char INFO_OPTIONS_SOUND_REPEAT_LIMIT[] = {
+  's','t','o','p',' ','n','o','n','-','l','o','o','p','e','d',' ','p','l','a','y','b','a','c','k',' ','a','f',
+  't','e','r',' ','e','x','a','c','t','l','y',' ','r','e','p','e','a','t','e','d',' ','o','u','t','p','u','t',
+  ' ','o','f',' ','s','p','e','c','i','f','i','e','d',' ','d','u','r','a','t','i','o','n',' ','i','n',' ','m',
+  'i','c','r','o','s','e','c','o','n','d','s',0
+};
+extern const Char INFO_OPTIONS_SOUND_SILENCE_LIMIT[] = {
+  's','t','o','p',' ','p','l','a','y','b','a','c','k',' ','a','f','t','e','r',' ','s','i','l','e','n','c','e',
+  ' ','o','f',' ','s','p','e','c','i','f','i','e','d',' ','d','u','r','a','t','i','o','n',' ','i','n',' ','m',
+  'i','c','r','o','s','e','c','o','n','d','s',0
+};
 extern const Char INFO_OPTIONS_SOUND_TITLE[] = {
   ' ','S','o','u','n','d',' ','o','p','t','i','o','n','s',':',0
 };
@@ -742,11 +793,127 @@ extern const Char LOOP_DESC[] = {
 extern const Char LOOP_KEY[] = {
   'l','o','o','p',0
 };
+extern const Char PCM_DIGEST_DESC[] = {
+  'S','w','i','t','c','h',' ','o','n',' ','r','e','n','d','e','r','e','d',' ','s','o','u','n','d',' ','c','h',
+  'e','c','k','i','n','g',' ','m','o','d','e','.',' ','P','a','r','a','m','e','t','e','r',' ','i','s',' ','m',
+  'a','p',' ','w','i','t','h',' ','t','h','e',' ','n','e','x','t',' ','p','a','r','a','m','e','t','e','r','s',
+  ':','\n',' ','f','i','l','e','n','a','m','e',' ','-',' ','d','i','g','e','s','t',' ','f','i','l','e','n','a',
+  'm','e',' ','t','e','m','p','l','a','t','e',' ','w','i','t','h',' ','a','n','y',' ','m','o','d','u','l','e',
+  '\'','s',' ','a','t','t','r','i','b','u','t','e','s','.',' ','D','i','g','e','s','t',' ','i','s',' ','s','t',
+  'o','r','e','d',' ','i','f',' ','f','i','l','e',' ','d','o','e','s',' ','n','o','t',' ','e','x','i','s','t',
+  ',',' ','e','l','s','e',' ','c','o','m','p','a','r','e','d',' ','w','i','t','h','\n',' ','b','l','o','c','k',
+  ' ','-',' ','s','a','m','p','l','e','s',' ','c','o','u','n','t',' ','p','e','r',' ','c','h','e','c','k','s',
+  'u','m',',',' ','1','6','3','8','4',' ','b','y',' ','d','e','f','a','u','l','t','\n',' ','t','o','l','e','r',
+  'a','n','c','e',' ','-',' ','a','l','l','o','w','e','d',' ','r','m','s',' ','l','e','v','e','l',' ','d','i',
+  'f','f','e','r','e','n','c','e',' ','o','f',' ','b','l','o','c','k','s',' ','w','i','t','h',' ','d','i','f',
+  'f','e','r','e','n','t',' ','c','h','e','c','k','s','u','m','s',',',' ','0',' ','(','b','i','t','-','e','x',
+  'a','c','t',')',' ','b','y',' ','d','e','f','a','u','l','t','\n',' ','s','l','o','w','d','o','w','n',' ','-',
+  ' ','a','l','l','o','w','e','d',' ','r','e','n','d','e','r','i','n','g',' ','s','p','e','e','d',' ','d','r',
+  'o','p',' ','i','n',' ','p','e','r','c','e','n','t','s',',',' ','0',' ','(','n','o','t',' ','c','h','e','c',
+  'k','e','d',')',' ','b','y',' ','d','e','f','a','u','l','t','\n',0
+};
+extern const Char PCM_DIGEST_ERROR_BLOCK[] = {
+  '%','1','%',':',' ','b','l','o','c','k',' ','%','2','%',' ','d','i','f','f','e','r','s',',',' ','r','m','s',
+  ' ','l','e','v','e','l',' ','%','3','%',' ','i','n','s','t','e','a','d',' ','o','f',' ','%','4','%','.',0
+};
+extern const Char PCM_DIGEST_ERROR_FAILED[] = {
+  '%','1','%',' ','o','f',' ','%','2','%',' ','m','o','d','u','l','e','s',' ','f','a','i','l','e','d',' ','r',
+  'e','n','d','e','r','e','d',' ','s','o','u','n','d',' ','c','h','e','c','k','.',0
+};
+extern const Char PCM_DIGEST_ERROR_INVALID_PARAMETER[] = {
+  'I','n','v','a','l','i','d',' ','v','a','l','u','e',' ','o','f',' ','\'','%','1','%','\'',' ','d','i','g','e',
+  's','t',' ','p','a','r','a','m','e','t','e','r','.',0
+};
+extern const Char PCM_DIGEST_ERROR_INVALID_REFERENCE[] = {
+  'I','n','v','a','l','i','d',' ','r','e','f','e','r','e','n','c','e',' ','d','i','g','e','s','t',' ','\'','%',
+  '1','%','\'','.',0
+};
+extern const Char PCM_DIGEST_ERROR_LENGTH[] = {
+  '%','1','%',':',' ','r','e','n','d','e','r','e','d',' ','%','2','%',' ','s','a','m','p','l','e','s',' ','i',
+  'n','s','t','e','a','d',' ','o','f',' ','%','3','%','.',0
+};
+extern const Char PCM_DIGEST_ERROR_SETUP[] = {
+  '%','1','%',':',' ','r','e','n','d','e','r','i','n','g',' ','s','e','t','u','p',' ','d','i','f','f','e','r',
+  's',' ','f','r','o','m',' ','r','e','f','e','r','e','n','c','e',' ','(','f','r','e','q','u','e','n','c','y',
+  ' ','%','2','%',',',' ','b','l','o','c','k',' ','%','3','%',')','.',0
+};
+extern const Char PCM_DIGEST_ERROR_SPEED[] = {
+  '%','1','%',':',' ','r','e','n','d','e','r','i','n','g',' ','i','s',' ','t','o','o',' ','s','l','o','w',',',
+  ' ','x','%','|','2','$','.','2','f','|',' ','i','n','s','t','e','a','d',' ','o','f',' ','x','%','|','3','$',
+  '.','2','f','|','.',0
+};
+extern const Char PCM_DIGEST_KEY[] = {
+  'p','c','m','-','d','i','g','e','s','t',0
+};
+extern const Char PCM_DIGEST_PARAM_BLOCK[] = {
+  'b','l','o','c','k',0
+};
+extern const Char PCM_DIGEST_PARAM_SLOWDOWN[] = {
+  's','l','o','w','d','o','w','n',0
+};
+extern const Char PCM_DIGEST_PARAM_TOLERANCE[] = {
+  't','o','l','e','r','a','n','c','e',0
+};
+extern const Char PCM_DIGEST_PASSED[] = {
+  '%','1','%',':',' ','p','a','s','s','e','d',',',' ','%','2','%',' ','o','f',' ','%','3','%',' ','b','l','o',
+  'c','k','s',' ','a','p','p','r','o','x','i','m','a','t','e',',',' ','x','%','|','4','$','.','2','f','|',' ',
+  '(','r','e','f','e','r','e','n','c','e',' ','x','%','|','5','$','.','2','f','|',')',0
+};
+extern const Char PCM_DIGEST_STORED[] = {
+  '%','1','%',':',' ','s','t','o','r','e','d',' ','%','2','%',' ','b','l','o','c','k','s',',',' ','x','%','|',
+  '3','$','.','2','f','|',0
+};
 extern const Char PLAYBACK_STATUS[] = {
   '[','%','1','%',']',' ','[','%','2','%',']','\n',
   '\n',
   0
 };
+extern const Char PROBE_DEFAULT_TEMPLATE[] = {
+  '[','F','u','l','l','p','a','t','h',']','\t','[','T','y','p','e',']','\t','[','T','i','t','l','e',']','\t',
+  '[','A','u','t','h','o','r',']','\t','[','C','R','C',']',0
+};
+extern const Char PROBE_DESC[] = {
+  'S','w','i','t','c','h',' ','o','n',' ','m','e','t','a','d','a','t','a',' ','p','r','o','b','i','n','g',' ',
+  'm','o','d','e','.',' ','M','o','d','u','l','e','s',' ','a','r','e',' ','n','o','t',' ','p','l','a','y','e',
+  'd',' ','b','u','t',' ','o','n','l','y',' ','t','h','e','i','r',' ','i','n','f','o','r','m','a','t','i','o',
+  'n',' ','i','s',' ','p','r','i','n','t','e','d','.','\n',0
+};
+extern const Char PROBE_DURATION_DESC[] = {
+  'S','w','i','t','c','h',' ','o','n',' ','d','u','r','a','t','i','o','n',' ','p','r','o','b','i','n','g',' ',
+  'm','o','d','e','.',' ','M','o','d','u','l','e','s',' ','a','r','e',' ','r','e','n','d','e','r','e','d',' ',
+  'w','i','t','h','o','u','t',' ','o','u','t','p','u','t',' ','t','o',' ','d','e','t','e','c','t',' ','r','e',
+  'a','l',' ','d','u','r','a','t','i','o','n',' ','u','s','i','n','g',' ','s','i','l','e','n','c','e',' ','a',
+  'n','d',' ','r','e','p','e','a','t',' ','l','i','m','i','t','s','.','\n',0
+};
+extern const Char PROBE_DURATION_KEY[] = {
+  'p','r','o','b','e','-','d','u','r','a','t','i','o','n',0
+};
+extern const Char PROBE_DURATION_RESULT[] = {
+  '%','1','%','\t','%','2','%','\t','%','3','%','\t','%','4','%',0
+};
+extern const Char PROBE_KEY[] = {
+  'p','r','o','b','e',0
+};
+extern const Char PROBE_RESULT[] = {
+  '%','1','%','\t','%','2','%','\t','%','3','%',0
+};
+extern const Char PROBE_TEMPLATE_DESC[] = {
+  'T','e','m','p','l','a','t','e',' ','o','f',' ','p','r','o','b','i','n','g',' ','m','o','d','e',' ','o','u',
+  't','p','u','t',' ','w','i','t','h',' ','a','n','y',' ','m','o','d','u','l','e','\'','s',' ','a','t','t','r',
+  'i','b','u','t','e','s','.',' ','D','u','r','a','t','i','o','n',' ','a','n','d',' ','f','r','a','m','e','s',
+  ' ','c','o','u','n','t',' ','a','r','e',' ','a','p','p','e','n','d','e','d','.','\n',0
+};
+extern const Char PROBE_TEMPLATE_KEY[] = {
+  'p','r','o','b','e','-','t','e','m','p','l','a','t','e',0
+};
+extern const Char PROBE_THREADS_DESC[] = {
+  'P','r','o','b','i','n','g',' ','t','h','r','e','a','d','s',' ','c','o','u','n','t','.',' ','D','e','f','a',
+  'u','l','t',' ','i','s',' ','h','a','r','d','w','a','r','e',' ','t','h','r','e','a','d','s',' ','c','o','u',
+  'n','t','.','\n',0
+};
+extern const Char PROBE_THREADS_KEY[] = {
+  'p','r','o','b','e','-','t','h','r','e','a','d','s',0
+};
 extern const Char PROGRAM_NAME[] = {
   'z','x','t','u','n','e','1','2','3',0
 };
@@ -759,12 +926,28 @@ extern const Char QUIET_DESC[] = {
 extern const Char QUIET_KEY[] = {
   'q','u','i','e','t',0
 };
+extern const Char REPEAT_LIMIT_DESC[] = {
+  's','t','o','p',' ','p','l','a','y','b','a','c','k',' ','a','f','t','e','r',' ','e','x','a','c','t','l','y',
+  ' ','r','e','p','e','a','t','e','d',' ','o','u','t','p','u','t',' ','o','f',' ','s','p','e','c','i','f','i',
+  'e','d',' ','d','u','r','a','t','i','o','n',' ','i','n',' ','u','S',0
+};
+extern const Char REPEAT_LIMIT_KEY[] = {
+  'r','e','p','e','a','t','-','l','i','m','i','t',0
+};
 extern const Char SEEKSTEP_DESC[] = {
   's','e','e','k','i','n','g',' ','s','t','e','p',' ','i','n',' ','p','e','r','c','e','n','t','s',0
 };
 extern const Char SEEKSTEP_KEY[] = {
   's','e','e','k','s','t','e','p',0
 };
+extern const Char SILENCE_LIMIT_DESC[] = {
+  's','t','o','p',' ','p','l','a','y','b','a','c','k',' ','a','f','t','e','r',' ','s','i','l','e','n','c','e',
+  ' ','o','f',' ','s','p','e','c','i','f','i','e','d',' ','d','u','r','a','t','i','o','n',' ','i','n',' ','u',
+  'S',0
+};
+extern const Char SILENCE_LIMIT_KEY[] = {
+  's','i','l','e','n','c','e','-','l','i','m','i','t',0
+};
 extern const Char SILENT_DESC[] = {
   'd','i','s','a','b','l','e',' ','a','l','l',' ','o','u','t','p','u','t',0
 };
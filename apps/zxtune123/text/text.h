@@ -8,6 +8,13 @@ extern const Char ABOUT_KEY[];
 extern const Char ABOUT_SECTION[];
 extern const Char ANALYZER_DESC[];
 extern const Char ANALYZER_KEY[];
+extern const Char BATCH_DESC[];
+extern const Char BATCH_DONE[];
+extern const Char BATCH_ERROR_FAILED[];
+extern const Char BATCH_FAILED[];
+extern const Char BATCH_KEY[];
+extern const Char BATCH_THREADS_DESC[];
+extern const Char BATCH_THREADS_KEY[];
 extern const Char BENCHMARK_DESC[];
 extern const Char BENCHMARK_KEY[];
 extern const Char BENCHMARK_RESULT[];
@@ -131,6 +138,7 @@ extern const Char INFO_MOD_MEMORYDUMP[];
 extern const Char INFO_MOD_MULTI[];
 extern const Char INFO_MOD_STREAM[];
 extern const Char INFO_MOD_TRACK[];
+extern const Char INFO_OPTIONS_CORE_AYM_CACHE[];
 extern const Char INFO_OPTIONS_CORE_AYM_CLOCKRATE[];
 extern const Char INFO_OPTIONS_CORE_AYM_DUTY_CYCLE[];
 extern const Char INFO_OPTIONS_CORE_AYM_DUTY_CYCLE_MASK[];
@@ -140,6 +148,7 @@ extern const Char INFO_OPTIONS_CORE_AYM_TABLE[];
 extern const Char INFO_OPTIONS_CORE_AYM_TYPE[];
 extern const Char INFO_OPTIONS_CORE_DAC_INTERPOLATION[];
 extern const Char INFO_OPTIONS_CORE_FM_CLOCKRATE[];
+extern const Char INFO_OPTIONS_CORE_FM_ENGINE[];
 extern const Char INFO_OPTIONS_CORE_PLUGINS_HRIP_IGNORE_CORRUPTED[];
 extern const Char INFO_OPTIONS_CORE_PLUGINS_RAW_MIN_SIZE[];
 extern const Char INFO_OPTIONS_CORE_PLUGINS_RAW_PLAIN_DOUBLE_ANALYSIS[];
@@ -181,6 +190,8 @@ extern const Char INFO_OPTIONS_SOUND_LOOPED[];
 extern const Char INFO_OPTIONS_SOUND_MIXER[];
 extern const Char INFO_OPTIONS_SOUND_MIXER_TEMPLATE[];
 extern const Char INFO_OPTIONS_SOUND_MIXER_TITLE[];
+extern const Char INFO_OPTIONS_SOUND_REPEAT_LIMIT[];
+extern const Char INFO_OPTIONS_SOUND_SILENCE_LIMIT[];
 extern const Char INFO_OPTIONS_SOUND_TITLE[];
 extern const Char INFO_OPTION_INFO[];
 extern const Char INFO_OPTION_INFO_DEFAULTS[];
@@ -199,13 +210,42 @@ extern const Char ITEM_INFO[];
 extern const Char ITEM_INFO_ADDON[];
 extern const Char LOOP_DESC[];
 extern const Char LOOP_KEY[];
+extern const Char PCM_DIGEST_DESC[];
+extern const Char PCM_DIGEST_ERROR_BLOCK[];
+extern const Char PCM_DIGEST_ERROR_FAILED[];
+extern const Char PCM_DIGEST_ERROR_INVALID_PARAMETER[];
+extern const Char PCM_DIGEST_ERROR_INVALID_REFERENCE[];
+extern const Char PCM_DIGEST_ERROR_LENGTH[];
+extern const Char PCM_DIGEST_ERROR_SETUP[];
+extern const Char PCM_DIGEST_ERROR_SPEED[];
+extern const Char PCM_DIGEST_KEY[];
+extern const Char PCM_DIGEST_PARAM_BLOCK[];
+extern const Char PCM_DIGEST_PARAM_SLOWDOWN[];
+extern const Char PCM_DIGEST_PARAM_TOLERANCE[];
+extern const Char PCM_DIGEST_PASSED[];
+extern const Char PCM_DIGEST_STORED[];
 extern const Char PLAYBACK_STATUS[];
+extern const Char PROBE_DEFAULT_TEMPLATE[];
+extern const Char PROBE_DESC[];
+extern const Char PROBE_DURATION_DESC[];
+extern const Char PROBE_DURATION_KEY[];
+extern const Char PROBE_DURATION_RESULT[];
+extern const Char PROBE_KEY[];
+extern const Char PROBE_RESULT[];
+extern const Char PROBE_TEMPLATE_DESC[];
+extern const Char PROBE_TEMPLATE_KEY[];
+extern const Char PROBE_THREADS_DESC[];
+extern const Char PROBE_THREADS_KEY[];
 extern const Char PROGRAM_NAME[];
 extern const Char PROGRESS_FORMAT[];
 extern const Char QUIET_DESC[];
 extern const Char QUIET_KEY[];
+extern const Char REPEAT_LIMIT_DESC[];
+extern const Char REPEAT_LIMIT_KEY[];
 extern const Char SEEKSTEP_DESC[];
 extern const Char SEEKSTEP_KEY[];
+extern const Char SILENCE_LIMIT_DESC[];
+extern const Char SILENCE_LIMIT_KEY[];
 extern const Char SILENT_DESC[];
 extern const Char SILENT_KEY[];
 extern const Char SOUND_BACKEND_PARAMS[];
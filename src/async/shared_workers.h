@@ -0,0 +1,32 @@
+/**
+* 
+* @file
+*
+* @brief Interface of process-wide worker threads pool
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//std includes
+#include <functional>
+
+namespace Async
+{
+  //! Threads are started on first access and shared by all the clients in process
+  class SharedWorkers
+  {
+  public:
+    typedef std::function<void()> Task;
+    virtual ~SharedWorkers() = default;
+
+    //! @return pooled threads count, calling thread is not included
+    virtual std::size_t Size() const = 0;
+    //! Queues task to be executed by any free pooled thread
+    virtual void Execute(Task task) = 0;
+
+    static SharedWorkers& Instance();
+  };
+}
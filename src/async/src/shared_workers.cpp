@@ -0,0 +1,93 @@
+/**
+* 
+* @file
+*
+* @brief Process-wide worker threads pool implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//library includes
+#include <async/shared_workers.h>
+//std includes
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Async
+{
+  class SharedWorkersImpl : public SharedWorkers
+  {
+  public:
+    explicit SharedWorkersImpl(std::size_t hwThreads)
+      : Stopping()
+    {
+      //calling thread takes part in processing too
+      for (std::size_t idx = 1; idx < hwThreads; ++idx)
+      {
+        Workers.emplace_back(&SharedWorkersImpl::WorkProc, this);
+      }
+    }
+
+    ~SharedWorkersImpl() override
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Mutex);
+        Stopping = true;
+      }
+      Condition.notify_all();
+      for (auto& worker : Workers)
+      {
+        worker.join();
+      }
+    }
+
+    std::size_t Size() const override
+    {
+      return Workers.size();
+    }
+
+    void Execute(Task task) override
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Mutex);
+        Tasks.push_back(std::move(task));
+      }
+      Condition.notify_one();
+    }
+  private:
+    void WorkProc()
+    {
+      for (;;)
+      {
+        Task task;
+        {
+          std::unique_lock<std::mutex> lock(Mutex);
+          Condition.wait(lock, [this] () {return Stopping || !Tasks.empty();});
+          if (Stopping)
+          {
+            return;
+          }
+          task = std::move(Tasks.front());
+          Tasks.pop_front();
+        }
+        task();
+      }
+    }
+  private:
+    std::vector<std::thread> Workers;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+    std::deque<Task> Tasks;
+    bool Stopping;
+  };
+
+  SharedWorkers& SharedWorkers::Instance()
+  {
+    static SharedWorkersImpl instance(std::thread::hardware_concurrency());
+    return instance;
+  }
+}
@@ -65,6 +65,14 @@ namespace Parameters
         //! @details String- table name or dump @see freq_tables.h
         extern const NameType TABLE;
 
+        //@{
+        //! @name Cache registers output of tracker-based modules for faster replaying and seeking
+        //! Default is off
+        const IntType CACHE_DEFAULT = 0;
+        //! Parameter name
+        extern const NameType CACHE;
+        //@}
+
         //@{
         //! @name Duty cycle in percents
         const IntType DUTY_CYCLE_MIN = 1;
@@ -163,6 +171,16 @@ namespace Parameters
         //! Parameter name
         extern const NameType CLOCKRATE;
         //@}
+
+        //@{
+        //! @name Emulation engine
+        const IntType ENGINE_REFERENCE = 0;
+        const IntType ENGINE_BATCH = 1;
+        //! Default is batch, output is the same
+        const IntType ENGINE_DEFAULT = ENGINE_BATCH;
+        //! Parameter name
+        extern const NameType ENGINE;
+        //@}
       }
 
       //! @brief SAA-related parameters namespace
@@ -0,0 +1,28 @@
+/**
+*
+* @file
+*
+* @brief  Modules metadata probing functionality
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <binary/container.h>
+#include <module/information.h>
+#include <parameters/accessor.h>
+#include <parameters/modifier.h>
+
+namespace Module
+{
+  //! @brief Extracts module metadata without creating playback objects where supported by plugin
+  //! @param params Parameters for plugins
+  //! @param data Source data
+  //! @param properties Target for module properties
+  //! @return Module information or empty pointer if no module detected
+  //! @note Can be called concurrently for different data
+  Information::Ptr Probe(const Parameters::Accessor& params, const Binary::Container& data, Parameters::Modifier& properties);
+}
@@ -0,0 +1,63 @@
+/**
+*
+* @file
+*
+* @brief  Process-wide registry of shared modules
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <binary/container.h>
+#include <module/holder.h>
+//std includes
+#include <vector>
+
+namespace Module
+{
+  //! @brief Storage of opened modules shared between independent playback sessions
+  //! @note Modules are identified by their own data content and subpath in source. Registry does not own modules, so entries are released
+  //!       with the last holder reference
+  class Registry
+  {
+  public:
+    virtual ~Registry() = default;
+
+    //! @brief Memory accounting of single shared module
+    struct Usage
+    {
+      Usage()
+        : Checksum()
+        , SourceSize()
+        , Users()
+        , Hits()
+      {
+      }
+
+      uint32_t Checksum;
+      //! Size of module data. Memory allocated by module itself is not accounted
+      std::size_t SourceSize;
+      String Subpath;
+      //! Currently alive references to module
+      std::size_t Users;
+      //! Opens served by already existing module
+      std::size_t Hits;
+    };
+
+    //! @brief Returns already opened module with the same content or opens new one
+    //! @param params Parameters for plugins. Not a part of identity, so expected to be the same for all the callers
+    //! @param data Source data
+    //! @param subpath Subpath in source data
+    //! @throw Error if no module detected
+    //! @note Thread-safe. Module properties are shared, so session-specific ones should be passed to Holder::CreateRenderer
+    virtual Holder::Ptr Open(const Parameters::Accessor& params, Binary::Container::Ptr data, const String& subpath) = 0;
+
+    //! @return Accounting for all the alive modules
+    virtual std::vector<Usage> GetUsage() const = 0;
+
+    static Registry& Instance();
+  };
+}
@@ -40,11 +40,21 @@ namespace ZXTune
     return component.substr(ARCHIVE_PLUGIN_PREFIX.size());
   }
 
+  //decoding attempts at arbitrary offsets are limited by installed budget if any
+  Formats::Packed::Container::Ptr DecodeSpeculatively(const Formats::Packed::Decoder& decoder, const Binary::Container& rawData)
+  {
+    if (Formats::Packed::DecodeBudget* const budget = Formats::Packed::DecodeBudget::Installed())
+    {
+      return budget->Decode(decoder, rawData);
+    }
+    return decoder.Decode(rawData);
+  }
+
   Analysis::Result::Ptr DetectModulesInArchive(const Parameters::Accessor& params, Plugin::Ptr plugin, const Formats::Packed::Decoder& decoder, 
     DataLocation::Ptr inputData, const Module::DetectCallback& callback)
   {
     const Binary::Container::Ptr rawData = inputData->GetData();
-    if (Formats::Packed::Container::Ptr subData = decoder.Decode(*rawData))
+    if (Formats::Packed::Container::Ptr subData = DecodeSpeculatively(decoder, *rawData))
     {
       const Module::CustomProgressDetectCallbackAdapter noProgressCallback(callback);
       const String subPlugin = plugin->Id();
@@ -25,7 +25,9 @@
 #include <core/plugin_attrs.h>
 #include <core/plugins_parameters.h>
 #include <debug/log.h>
+#include <formats/packed.h>
 #include <l10n/api.h>
+#include <strings/format.h>
 #include <time/duration.h>
 #include <time/timer.h>
 //std includes
@@ -126,6 +128,8 @@ namespace ZXTune
       Dbg("Useful detected: %1% (%2% archived + %3% modules)", useful, ArchivedData, ModulesData);
       Dbg("Coverage: %1%%%", useful * 100 / TotalData);
       Dbg("Speed: %1% b/s", spent.Get() ? (TotalData * Stamp::PER_SECOND / spent.Get()) : TotalData);
+      Dbg("Speculative decodings: %1% completed, %2% failed, %3% aborted. Wasted %4% bytes in %5% steps",
+        Decodings.Completed, Decodings.Failed, Decodings.Aborted, Decodings.WastedOutput, Decodings.WastedWork);
       StatisticBuilder<7> builder;
       builder.Add(MakeStatLine(), 0);
       StatItem total;
@@ -154,6 +158,15 @@ namespace ZXTune
       ModulesData += size;
     }
 
+    void AddDecodings(const Formats::Packed::DecodeBudget::Statistic& stat)
+    {
+      Decodings.Completed += stat.Completed;
+      Decodings.Failed += stat.Failed;
+      Decodings.Aborted += stat.Aborted;
+      Decodings.WastedOutput += stat.WastedOutput;
+      Decodings.WastedWork += stat.WastedWork;
+    }
+
     template<class PluginType>
     void AddAimed(const PluginType& plug, const Time::Timer& scanTimer)
     {
@@ -270,6 +283,7 @@ namespace ZXTune
     uint64_t TotalData;
     uint64_t ArchivedData;
     uint64_t ModulesData;
+    Formats::Packed::DecodeBudget::Statistic Decodings;
     typedef std::map<const void*, StatItem> DetectMap;
     DetectMap Detection;
   };
@@ -285,6 +299,8 @@ namespace ZXTune
 
   const std::size_t SCAN_STEP = 1;
   const std::size_t MIN_MINIMAL_RAW_SIZE = 128;
+  //decoding limits are applied to each window of scanned data separately
+  const std::size_t DECODE_BUDGET_WINDOW = 1024 * 1024;
 
   const IndexPathComponent RawPath(Text::RAW_PLUGIN_PREFIX);
 
@@ -314,6 +330,20 @@ namespace ZXTune
       Accessor.FindValue(Parameters::ZXTune::Core::Plugins::Raw::PLAIN_DOUBLE_ANALYSIS, doubleAnalysis);
       return doubleAnalysis != 0;
     }
+
+    uint64_t GetDecodeOutputLimit() const
+    {
+      Parameters::IntType limit = Parameters::ZXTune::Core::Plugins::Raw::DECODE_OUTPUT_LIMIT_DEFAULT;
+      Accessor.FindValue(Parameters::ZXTune::Core::Plugins::Raw::DECODE_OUTPUT_LIMIT, limit);
+      return static_cast<uint64_t>(std::max<Parameters::IntType>(limit, 0));
+    }
+
+    uint64_t GetDecodeWorkLimit() const
+    {
+      Parameters::IntType limit = Parameters::ZXTune::Core::Plugins::Raw::DECODE_WORK_LIMIT_DEFAULT;
+      Accessor.FindValue(Parameters::ZXTune::Core::Plugins::Raw::DECODE_WORK_LIMIT, limit);
+      return static_cast<uint64_t>(std::max<Parameters::IntType>(limit, 0));
+    }
   private:
     const Parameters::Accessor& Accessor;
   };
@@ -762,15 +792,40 @@ namespace ZXTune
         : availableArchives;
       RawDetectionPlugins usedPlugins(params, PlayerPluginsEnumerator::Create()->Enumerate(), usedArchives, *this);
 
+      //bound time spent on false positive matches of depackers at arbitrary offsets
+      Formats::Packed::DecodeBudget budget(scanParams.GetDecodeOutputLimit(), scanParams.GetDecodeWorkLimit());
+      std::size_t budgetWindowEnd = DECODE_BUDGET_WINDOW;
+      std::size_t windowAborts = 0;
+      //shown instead of regular progress message till the end of window
+      String budgetWarning;
       ScanDataLocation::Ptr subLocation = MakePtr<ScanDataLocation>(input, Description->Id(), 0);
 
       while (subLocation->HasToScan(minRawSize))
       {
         const std::size_t offset = subLocation->GetOffset();
-        progress->OnProgress(static_cast<uint_t>(offset));
+        if (offset >= budgetWindowEnd)
+        {
+          budget.StartWindow();
+          budgetWindowEnd = offset + DECODE_BUDGET_WINDOW;
+          windowAborts = budget.GetStatistic().Aborted;
+          budgetWarning.clear();
+        }
+        if (budgetWarning.empty())
+        {
+          progress->OnProgress(static_cast<uint_t>(offset));
+        }
+        else
+        {
+          progress->OnProgress(static_cast<uint_t>(offset), budgetWarning);
+        }
         usedPlugins.SetOffset(offset);
         const Module::DetectCallback& curCallback = offset ? noProgressCallback : callback;
         const std::size_t bytesToSkip = usedPlugins.Detect(subLocation, curCallback);
+        if (budgetWarning.empty() && budget.GetStatistic().Aborted != windowAborts)
+        {
+          Dbg("Decoding budget is exhausted at offset %1%", offset);
+          budgetWarning = Strings::Format(translate("Decoding limits are exceeded at %1%, packed data may be skipped up to %2%"), offset, budgetWindowEnd);
+        }
         if (!subLocation.unique())
         {
           Dbg("Sublocation is captured. Duplicate.");
@@ -778,6 +833,10 @@ namespace ZXTune
         }
         subLocation->Move(std::max(bytesToSkip, SCAN_STEP));
       }
+      const Formats::Packed::DecodeBudget::Statistic& decodings = budget.GetStatistic();
+      Dbg("Speculative decodings: %1% completed, %2% failed, %3% aborted. Wasted %4% bytes in %5% steps",
+        decodings.Completed, decodings.Failed, decodings.Aborted, decodings.WastedOutput, decodings.WastedWork);
+      Statistic::Self().AddDecodings(decodings);
       return Analysis::CreateMatchedResult(size);
     }
 
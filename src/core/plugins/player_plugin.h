@@ -16,6 +16,8 @@
 #include <analysis/result.h>
 #include <core/module_detect.h>
 #include <core/plugin.h>
+#include <module/information.h>
+#include <parameters/modifier.h>
 
 namespace ZXTune
 {
@@ -33,5 +35,9 @@ namespace ZXTune
     virtual Analysis::Result::Ptr Detect(const Parameters::Accessor& params, DataLocation::Ptr inputData, const Module::DetectCallback& callback) const = 0;
 
     virtual Module::Holder::Ptr Open(const Parameters::Accessor& params, const Binary::Container& data) const = 0;
+
+    //! @brief Extract module metadata without creating playback objects if possible
+    //! @return Module information or empty pointer if not matched. Module properties are stored to properties
+    virtual Module::Information::Ptr Probe(const Parameters::Accessor& params, const Binary::Container& data, Parameters::Modifier& properties) const = 0;
   };
 }
@@ -22,14 +22,16 @@ namespace ZXTune
       const Char ID[] = {'A', 'S', '0', 0};
       const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder = Formats::Chiptune::ASCSoundMaster::Ver0::CreateDecoder();
       const Module::AYM::Factory::Ptr factory = Module::ASCSoundMaster::CreateFactory(decoder);
-      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+      const Module::Prober::Ptr prober = Module::ASCSoundMaster::CreateProber(decoder);
+      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, prober);
       registrator.RegisterPlugin(plugin);
     }
     {
       const Char ID[] = {'A', 'S', 'C', 0};
       const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder = Formats::Chiptune::ASCSoundMaster::Ver1::CreateDecoder();
       const Module::AYM::Factory::Ptr factory = Module::ASCSoundMaster::CreateFactory(decoder);
-      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+      const Module::Prober::Ptr prober = Module::ASCSoundMaster::CreateProber(decoder);
+      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, prober);
       registrator.RegisterPlugin(plugin);
     }
   }
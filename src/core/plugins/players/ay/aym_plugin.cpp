@@ -51,9 +51,7 @@ namespace ZXTune
 {
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder, Module::AYM::Factory::Ptr factory)
   {
-    const Module::Factory::Ptr modFactory = MakePtr<Module::AYMFactory>(factory);
-    const uint_t ayCaps = Capabilities::Module::Device::AY38910 | Module::AYM::GetSupportedFormatConvertors();
-    return CreatePlayerPlugin(id, caps | ayCaps, decoder, modFactory);
+    return CreatePlayerPlugin(id, caps, decoder, factory, Module::Prober::Ptr());
   }
 
   PlayerPlugin::Ptr CreateTrackPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder, Module::AYM::Factory::Ptr factory)
@@ -65,4 +63,21 @@ namespace ZXTune
   {
     return CreatePlayerPlugin(id, Capabilities::Module::Type::STREAM, decoder, factory);
   }
+
+  PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder, Module::AYM::Factory::Ptr factory, Module::Prober::Ptr prober)
+  {
+    const Module::Factory::Ptr modFactory = MakePtr<Module::AYMFactory>(factory);
+    const uint_t ayCaps = Capabilities::Module::Device::AY38910 | Module::AYM::GetSupportedFormatConvertors();
+    return CreatePlayerPlugin(id, caps | ayCaps, decoder, modFactory, prober);
+  }
+
+  PlayerPlugin::Ptr CreateTrackPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder, Module::AYM::Factory::Ptr factory, Module::Prober::Ptr prober)
+  {
+    return CreatePlayerPlugin(id, Capabilities::Module::Type::TRACK, decoder, factory, prober);
+  }
+
+  PlayerPlugin::Ptr CreateStreamPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder, Module::AYM::Factory::Ptr factory, Module::Prober::Ptr prober)
+  {
+    return CreatePlayerPlugin(id, Capabilities::Module::Type::STREAM, decoder, factory, prober);
+  }
 }
@@ -24,7 +24,8 @@ namespace ZXTune
 
     const Formats::Chiptune::Decoder::Ptr decoder = Formats::Chiptune::CreatePSGDecoder();
     const Module::AYM::Factory::Ptr factory = Module::PSG::CreateFactory();
-    const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory);;
+    const Module::Prober::Ptr prober = Module::PSG::CreateProber();
+    const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory, prober);
     registrator.RegisterPlugin(plugin);
   }
 }
@@ -24,7 +24,8 @@ namespace ZXTune
 
     const Formats::Chiptune::Decoder::Ptr decoder = Formats::Chiptune::CreateProTracker2Decoder();
     const Module::AYM::Factory::Ptr factory = Module::ProTracker2::CreateFactory();
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);;
+    const Module::Prober::Ptr prober = Module::ProTracker2::CreateProber();
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, prober);
     registrator.RegisterPlugin(plugin);
   }
 }
@@ -26,7 +26,8 @@ namespace ZXTune
 
     const Formats::Chiptune::ProTracker3::Decoder::Ptr decoder = Formats::Chiptune::ProTracker3::CreateDecoder();
     const Module::Factory::Ptr factory = Module::ProTracker3::CreateFactory(decoder);
-    const PlayerPlugin::Ptr plugin = CreatePlayerPlugin(ID, CAPS, decoder, factory);
+    const Module::Prober::Ptr prober = Module::ProTracker3::CreateProber(decoder);
+    const PlayerPlugin::Ptr plugin = CreatePlayerPlugin(ID, CAPS, decoder, factory, prober);
     registrator.RegisterPlugin(plugin);
   }
 
@@ -39,7 +40,8 @@ namespace ZXTune
 
     const Formats::Chiptune::ProTracker3::Decoder::Ptr decoder = Formats::Chiptune::ProTracker3::VortexTracker2::CreateDecoder();
     const Module::Factory::Ptr factory = Module::ProTracker3::CreateFactory(decoder);
-    const PlayerPlugin::Ptr plugin = CreatePlayerPlugin(ID, CAPS, decoder, factory);
+    const Module::Prober::Ptr prober = Module::ProTracker3::CreateProber(decoder);
+    const PlayerPlugin::Ptr plugin = CreatePlayerPlugin(ID, CAPS, decoder, factory, prober);
     registrator.RegisterPlugin(plugin);
   }
 }
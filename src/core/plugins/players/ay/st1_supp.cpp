@@ -24,7 +24,8 @@ namespace ZXTune
 
     const Formats::Chiptune::SoundTracker::Decoder::Ptr decoder = Formats::Chiptune::SoundTracker::Ver1::CreateUncompiledDecoder();
     const Module::AYM::Factory::Ptr factory = Module::SoundTracker::CreateFactory(decoder);
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+    const Module::Prober::Ptr prober = Module::SoundTracker::CreateProber(decoder);
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, prober);
     registrator.RegisterPlugin(plugin);
   }
 }
@@ -23,7 +23,8 @@ namespace ZXTune
 
     const Formats::Chiptune::YM::Decoder::Ptr decoder = Formats::Chiptune::YM::CreateVTXDecoder();
     const Module::AYM::Factory::Ptr factory = Module::YMVTX::CreateFactory(decoder);
-    const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory);;
+    const Module::Prober::Ptr prober = Module::YMVTX::CreateProber(decoder);
+    const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory, prober);
     registrator.RegisterPlugin(plugin);
   }
 
@@ -34,13 +35,15 @@ namespace ZXTune
     {
       const Formats::Chiptune::YM::Decoder::Ptr decoder = Formats::Chiptune::YM::CreatePackedYMDecoder();
       const Module::AYM::Factory::Ptr factory = Module::YMVTX::CreateFactory(decoder);
-      const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory);
+      const Module::Prober::Ptr prober = Module::YMVTX::CreateProber(decoder);
+      const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory, prober);
       registrator.RegisterPlugin(plugin);
     }
     {
       const Formats::Chiptune::YM::Decoder::Ptr decoder = Formats::Chiptune::YM::CreateYMDecoder();
       const Module::AYM::Factory::Ptr factory = Module::YMVTX::CreateFactory(decoder);
-      const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory);;
+      const Module::Prober::Ptr prober = Module::YMVTX::CreateProber(decoder);
+      const PlayerPlugin::Ptr plugin = CreateStreamPlayerPlugin(ID, decoder, factory, prober);
       registrator.RegisterPlugin(plugin);
     }
   }
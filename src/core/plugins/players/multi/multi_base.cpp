@@ -14,6 +14,7 @@
 #include <contract.h>
 #include <make_ptr.h>
 //library includes
+#include <async/shared_workers.h>
 #include <parameters/merged_accessor.h>
 #include <parameters/tracking_helper.h>
 #include <parameters/visitor.h>
@@ -21,7 +22,12 @@
 #include <sound/sound_parameters.h>
 //std includes
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 //boost includes
 #include <boost/bind.hpp>
 
@@ -52,6 +58,17 @@ namespace Module
       MaxBands = std::max(MaxBands, result.size());
       return result;
     }
+
+    void GetState(uint_t lag, std::vector<ChannelState>& state) const override
+    {
+      static thread_local std::vector<ChannelState> portion;
+      state.clear();
+      for (const auto& delegate : Delegates)
+      {
+        delegate->GetState(lag, portion);
+        state.insert(state.end(), portion.begin(), portion.end());
+      }
+    }
     
     static Ptr Create(const RenderersArray& renderers)
     {
@@ -120,31 +137,25 @@ namespace Module
     const uint_t TotalChannelsCount;
   };
 
-  class CompositeReceiver : public Sound::Receiver
+  //collects chunks of all the delegates separately so they may be rendered concurrently, mixes them in the same order
+  class CompositeReceiver
   {
   public:
     typedef std::shared_ptr<CompositeReceiver> Ptr;
     
-    explicit CompositeReceiver(Sound::Receiver::Ptr delegate)
+    CompositeReceiver(Sound::Receiver::Ptr delegate, std::size_t streams)
       : Delegate(std::move(delegate))
-      , DoneStreams()
+      , Streams(streams)
     {
-    }
-    
-    void ApplyData(Sound::Chunk::Ptr data) override
-    {
-      if (DoneStreams++)
-      {
-        Buffer.Mix(*data);
-      }
-      else
+      for (auto& stream : Streams)
       {
-        Buffer.Fill(*data);
+        stream = std::make_shared<ChunksArray>();
       }
     }
     
-    void Flush() override
+    Sound::Receiver::Ptr GetStream(std::size_t idx)
     {
+      return MakePtr<StreamReceiver>(Streams.at(idx));
     }
 
     void SetBufferSize(uint_t size)
@@ -154,11 +165,48 @@ namespace Module
     
     void FinishFrame()
     {
-      Delegate->ApplyData(Buffer.Convert(DoneStreams));
+      uint_t doneStreams = 0;
+      for (const auto& stream : Streams)
+      {
+        for (const auto& chunk : *stream)
+        {
+          if (doneStreams++)
+          {
+            Buffer.Mix(*chunk);
+          }
+          else
+          {
+            Buffer.Fill(*chunk);
+          }
+        }
+        stream->clear();
+      }
+      Delegate->ApplyData(Buffer.Convert(doneStreams));
       Delegate->Flush();
-      DoneStreams = 0;
     }
   private:
+    typedef std::vector<Sound::Chunk::Ptr> ChunksArray;
+
+    class StreamReceiver : public Sound::Receiver
+    {
+    public:
+      explicit StreamReceiver(std::shared_ptr<ChunksArray> chunks)
+        : Chunks(std::move(chunks))
+      {
+      }
+
+      void ApplyData(Sound::Chunk::Ptr data) override
+      {
+        Chunks->push_back(std::move(data));
+      }
+
+      void Flush() override
+      {
+      }
+    private:
+      const std::shared_ptr<ChunksArray> Chunks;
+    };
+
     class WideSample
     {
     public:
@@ -244,8 +292,118 @@ namespace Module
     };
   private:
     const Sound::Receiver::Ptr Delegate;
+    std::vector<std::shared_ptr<ChunksArray>> Streams;
     CumulativeChunk Buffer;
-    uint_t DoneStreams;
+  };
+
+  //renders frame of all the delegates split to parts executed by shared workers and calling thread.
+  //Calling thread renders all the parts not started yet by workers, so busy workers do not delay frame.
+  class FrameWorkers
+  {
+  public:
+    FrameWorkers(const RenderersArray& delegates, std::size_t parts)
+      : Delegates(delegates)
+      , Parts(parts)
+      , Results(delegates.size())
+    {
+      Require(parts > 1);
+    }
+
+    bool RenderFrame()
+    {
+      //workers may take task after frame is done, so state is not shared between frames
+      const auto frame = std::make_shared<Frame>(*this);
+      for (std::size_t part = 1; part != Parts; ++part)
+      {
+        Async::SharedWorkers::Instance().Execute(std::bind(&Frame::Render, frame));
+      }
+      frame->Render();
+      frame->Wait();
+      return std::all_of(Results.begin(), Results.end(), [] (char res) {return res != 0;});
+    }
+
+    static std::size_t GetPartsCount(std::size_t delegates)
+    {
+      return std::min<std::size_t>(delegates, Async::SharedWorkers::Instance().Size() + 1);
+    }
+  private:
+    class Frame
+    {
+    public:
+      explicit Frame(FrameWorkers& owner)
+        : Owner(owner)
+        , Parts(owner.Parts)
+        , Errors(Parts)
+        , NextPart()
+        , Done()
+      {
+      }
+
+      void Render()
+      {
+        for (;;)
+        {
+          const std::size_t part = NextPart++;
+          if (part >= Parts)
+          {
+            return;
+          }
+          RenderPart(part);
+          {
+            const std::lock_guard<std::mutex> lock(Mutex);
+            if (++Done != Parts)
+            {
+              continue;
+            }
+          }
+          Condition.notify_one();
+        }
+      }
+
+      void Wait()
+      {
+        {
+          std::unique_lock<std::mutex> lock(Mutex);
+          Condition.wait(lock, [this] () {return Done == Parts;});
+        }
+        for (const auto& err : Errors)
+        {
+          if (err)
+          {
+            std::rethrow_exception(err);
+          }
+        }
+      }
+    private:
+      void RenderPart(std::size_t part)
+      {
+        try
+        {
+          for (std::size_t idx = part, lim = Owner.Delegates.size(); idx < lim; idx += Parts)
+          {
+            Owner.Results[idx] = Owner.Delegates[idx]->RenderFrame();
+          }
+        }
+        catch (...)
+        {
+          Errors[part] = std::current_exception();
+        }
+      }
+    private:
+      //not accessed after all the parts are done
+      FrameWorkers& Owner;
+      const std::size_t Parts;
+      std::vector<std::exception_ptr> Errors;
+      std::atomic<std::size_t> NextPart;
+      std::mutex Mutex;
+      std::condition_variable Condition;
+      std::size_t Done;
+    };
+  private:
+    const RenderersArray& Delegates;
+    const std::size_t Parts;
+    //not vector<bool> to be modified concurrently
+    std::vector<char> Results;
   };
   
   class ForcedLoopParam : public Parameters::Accessor
@@ -353,6 +511,11 @@ namespace Module
       , State(MultiTrackState::Create(Delegates))
       , Analysis(MultiAnalyzer::Create(Delegates))
     {
+      const auto parts = FrameWorkers::GetPartsCount(Delegates.size());
+      if (parts > 1)
+      {
+        Workers.reset(new FrameWorkers(Delegates, parts));
+      }
       ApplyParameters();
     }
 
@@ -370,9 +533,16 @@ namespace Module
     {
       ApplyParameters();
       bool result = true;
-      for (std::size_t idx = 0, lim = Delegates.size(); idx != lim; ++idx)
+      if (Workers)
       {
-        result &= Delegates[idx]->RenderFrame();
+        result = Workers->RenderFrame();
+      }
+      else
+      {
+        for (std::size_t idx = 0, lim = Delegates.size(); idx != lim; ++idx)
+        {
+          result &= Delegates[idx]->RenderFrame();
+        }
       }
       if (result)
       {
@@ -396,7 +566,7 @@ namespace Module
     {
       const auto count = holders.size();
       Require(count > 1);
-      const CompositeReceiver::Ptr receiver = MakePtr<CompositeReceiver>(target);
+      const CompositeReceiver::Ptr receiver = MakePtr<CompositeReceiver>(target, count);
       const Parameters::Accessor::Ptr forcedLoop = MakePtr<ForcedLoopParam>();
       RenderersArray delegates(count);
       for (std::size_t idx = 0; idx != count; ++idx)
@@ -405,7 +575,7 @@ namespace Module
         auto delegateParams = idx == 0
           ? params
           : Parameters::CreateMergedAccessor(forcedLoop, params);
-        delegates[idx] = holder->CreateRenderer(std::move(delegateParams), receiver);
+        delegates[idx] = holder->CreateRenderer(std::move(delegateParams), receiver->GetStream(idx));
       }
       auto renderParams = Sound::RenderParameters::Create(std::move(params));
       return MakePtr<MultiRenderer>(std::move(delegates), std::move(renderParams), receiver);
@@ -425,6 +595,7 @@ namespace Module
     const CompositeReceiver::Ptr Target;
     const TrackState::Ptr State;
     const Analyzer::Ptr Analysis;
+    std::unique_ptr<FrameWorkers> Workers;
   };
   
   class MultiHolder : public Holder
@@ -26,10 +26,11 @@ namespace ZXTune
   class CommonPlayerPlugin : public PlayerPlugin
   {
   public:
-    CommonPlayerPlugin(Plugin::Ptr descr, Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory)
+    CommonPlayerPlugin(Plugin::Ptr descr, Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory, Module::Prober::Ptr prober)
       : Description(std::move(descr))
       , Decoder(std::move(decoder))
       , Factory(std::move(factory))
+      , Prober(std::move(prober))
     {
     }
 
@@ -74,16 +75,49 @@ namespace ZXTune
       }
       return Module::Holder::Ptr();
     }
+
+    Module::Information::Ptr Probe(const Parameters::Accessor& params, const Binary::Container& data, Parameters::Modifier& properties) const override
+    {
+      if (!Decoder->Check(data))
+      {
+        return Module::Information::Ptr();
+      }
+      else if (Prober)
+      {
+        Module::PropertiesHelper(properties)
+          .SetType(Description->Id());
+        return Prober->Probe(data, properties);
+      }
+      else
+      {
+        const Parameters::Container::Ptr moduleProperties = Parameters::Container::Create();
+        Module::PropertiesHelper(*moduleProperties)
+          .SetType(Description->Id());
+        if (const Module::Holder::Ptr holder = Factory->CreateModule(params, data, moduleProperties))
+        {
+          holder->GetModuleProperties()->Process(properties);
+          return holder->GetModuleInformation();
+        }
+        return Module::Information::Ptr();
+      }
+    }
   private:
     const Plugin::Ptr Description;
     const Formats::Chiptune::Decoder::Ptr Decoder;
     const Module::Factory::Ptr Factory;
+    const Module::Prober::Ptr Prober;
   };
 
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps,
     Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory)
+  {
+    return CreatePlayerPlugin(id, caps, std::move(decoder), std::move(factory), Module::Prober::Ptr());
+  }
+
+  PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps,
+    Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory, Module::Prober::Ptr prober)
   {
     const Plugin::Ptr description = CreatePluginDescription(id, decoder->GetDescription(), caps | Capabilities::Category::MODULE);
-    return MakePtr<CommonPlayerPlugin>(description, decoder, factory);
+    return MakePtr<CommonPlayerPlugin>(description, decoder, factory, prober);
   }
 }
@@ -15,8 +15,11 @@
 //library includes
 #include <formats/chiptune.h>
 #include <module/players/factory.h>
+#include <module/players/prober.h>
 
 namespace ZXTune
 {
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory);
+  //! @param prober Optional lightweight metadata extractor, factory is used if not specified
+  PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory, Module::Prober::Ptr prober);
 }
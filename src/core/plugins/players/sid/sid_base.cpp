@@ -32,6 +32,8 @@
 #include <sound/chunk_builder.h>
 #include <sound/render_params.h>
 #include <sound/sound_parameters.h>
+//std includes
+#include <mutex>
 //3rdparty includes
 #include <3rdparty/sidplayfp/sidplayfp/sidplayfp.h>
 #include <3rdparty/sidplayfp/sidplayfp/SidInfo.h>
@@ -311,10 +313,7 @@ namespace Sid
 
     uint_t FramesCount() const override
     {
-      if (!Frames)
-      {
-        Frames = GetFramesCount();
-      }
+      std::call_once(FramesCalculated, [this]() {Frames = GetFramesCount();});
       return Frames;
     }
 
@@ -346,6 +345,7 @@ namespace Sid
     const TunePtr Tune;
     const uint_t Fps;
     const uint_t SongIdx;
+    mutable std::once_flag FramesCalculated;
     mutable uint_t Frames;
   };
 
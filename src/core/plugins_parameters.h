@@ -55,6 +55,24 @@ namespace Parameters
           //! Parameter name
           extern const NameType MIN_SIZE;
           //@}
+
+          //@{
+          //! @name Limit of data size in bytes decoded by unsuccessful depackers attempts per each megabyte of scanned data
+
+          //! Default value (about thousand of false positive matches decoded up to maximal size)
+          const IntType DECODE_OUTPUT_LIMIT_DEFAULT = 64 * 1024 * 1024;
+          //! Parameter name
+          extern const NameType DECODE_OUTPUT_LIMIT;
+          //@}
+
+          //@{
+          //! @name Limit of steps (tokens, blocks etc) performed by unsuccessful depackers attempts per each megabyte of scanned data
+
+          //! Default value
+          const IntType DECODE_WORK_LIMIT_DEFAULT = 16 * 1024 * 1024;
+          //! Parameter name
+          extern const NameType DECODE_WORK_LIMIT;
+          //@}
         }
 
         //! @brief HRIP container parameters namespace
@@ -0,0 +1,39 @@
+/**
+*
+* @file
+*
+* @brief  Modules metadata probing implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "core/plugins/player_plugins_enumerator.h"
+//library includes
+#include <core/module_probe.h>
+#include <debug/log.h>
+#include <parameters/container.h>
+
+namespace Module
+{
+  const Debug::Stream Dbg("Core::Probe");
+
+  Information::Ptr Probe(const Parameters::Accessor& params, const Binary::Container& data, Parameters::Modifier& properties)
+  {
+    using namespace ZXTune;
+    for (PlayerPlugin::Iterator::Ptr usedPlugins = PlayerPluginsEnumerator::Create()->Enumerate(); usedPlugins->IsValid(); usedPlugins->Next())
+    {
+      const PlayerPlugin::Ptr plugin = usedPlugins->Get();
+      //do not pollute target with properties of partially matched data
+      const Parameters::Container::Ptr moduleProperties = Parameters::Container::Create();
+      if (const Information::Ptr info = plugin->Probe(params, data, *moduleProperties))
+      {
+        Dbg("Probed %1%", plugin->GetDescription()->Id());
+        moduleProperties->Process(properties);
+        return info;
+      }
+    }
+    return Information::Ptr();
+  }
+}
@@ -0,0 +1,263 @@
+/**
+*
+* @file
+*
+* @brief  Process-wide registry of shared modules implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//common includes
+#include <crc.h>
+#include <make_ptr.h>
+//library includes
+#include <core/module_open.h>
+#include <core/module_registry.h>
+#include <debug/log.h>
+#include <module/players/aym/aym_base.h>
+//std includes
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace Module
+{
+  const Debug::Stream Dbg("Core::Registry");
+
+  //Makes lazily calculated data ready before sharing and serializes renderers creation
+  //to keep plugin-specific initialization away from concurrent calls
+  template<class Base>
+  class SharedHolderBase : public Base
+  {
+  public:
+    SharedHolderBase(typename Base::Ptr delegate, Binary::Container::Ptr data)
+      : Delegate(std::move(delegate))
+      , Data(std::move(data))
+      , Info(Delegate->GetModuleInformation())
+      , Properties(Delegate->GetModuleProperties())
+    {
+      Info->FramesCount();
+      Info->LoopFrame();
+    }
+
+    Information::Ptr GetModuleInformation() const override
+    {
+      return Info;
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Properties;
+    }
+
+    Renderer::Ptr CreateRenderer(Parameters::Accessor::Ptr params, Sound::Receiver::Ptr target) const override
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Delegate->CreateRenderer(std::move(params), std::move(target));
+    }
+  protected:
+    const typename Base::Ptr Delegate;
+    const Binary::Container::Ptr Data;
+    const Information::Ptr Info;
+    const Parameters::Accessor::Ptr Properties;
+    mutable std::mutex Guard;
+  };
+
+  typedef SharedHolderBase<Holder> SharedHolder;
+
+  class SharedAYMHolder : public SharedHolderBase<AYM::Holder>
+  {
+  public:
+    SharedAYMHolder(AYM::Holder::Ptr delegate, Binary::Container::Ptr data)
+      : SharedHolderBase<AYM::Holder>(std::move(delegate), std::move(data))
+    {
+    }
+
+    using SharedHolderBase<AYM::Holder>::CreateRenderer;
+
+    Renderer::Ptr CreateRenderer(Parameters::Accessor::Ptr params, Devices::AYM::Device::Ptr chip) const override
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Delegate->CreateRenderer(std::move(params), std::move(chip));
+    }
+
+    AYM::Chiptune::Ptr GetChiptune() const override
+    {
+      return Delegate->GetChiptune();
+    }
+  };
+
+  Holder::Ptr CreateSharedHolder(Holder::Ptr delegate, Binary::Container::Ptr data)
+  {
+    if (const AYM::Holder::Ptr aym = std::dynamic_pointer_cast<const AYM::Holder>(delegate))
+    {
+      return MakePtr<SharedAYMHolder>(aym, std::move(data));
+    }
+    return MakePtr<SharedHolder>(std::move(delegate), std::move(data));
+  }
+
+  bool IsSameContent(const Binary::Data& lh, const Binary::Data& rh)
+  {
+    return lh.Size() == rh.Size()
+        && 0 == std::memcmp(lh.Start(), rh.Start(), lh.Size());
+  }
+
+  class RegistryImpl : public Registry
+  {
+  public:
+    RegistryImpl()
+      : PruneLimit(MIN_PRUNE_LIMIT)
+    {
+    }
+
+    Holder::Ptr Open(const Parameters::Accessor& params, Binary::Container::Ptr data, const String& subpath) override
+    {
+      if (subpath.empty())
+      {
+        return OpenShared(data, subpath, [&params, &data]() {return Module::Open(params, *data);});
+      }
+      //identify by module's own data, so the whole container is not hashed and compared on every open
+      const ZXTune::DataLocation::Ptr location = ZXTune::OpenLocation(params, data, subpath);
+      return OpenShared(location->GetData(), subpath, [&params, &location]() {return Module::Open(params, location);});
+    }
+
+    std::vector<Usage> GetUsage() const override
+    {
+      std::vector<Usage> result;
+      const std::lock_guard<std::mutex> lock(Guard);
+      result.reserve(Slots.size());
+      for (const auto& entry : Slots)
+      {
+        Slot& slot = *entry.second;
+        //slots being opened at the moment are not accounted
+        std::unique_lock<std::mutex> slotLock(slot.Guard, std::try_to_lock);
+        if (!slotLock.owns_lock())
+        {
+          continue;
+        }
+        if (const Holder::Ptr module = slot.Module.lock())
+        {
+          Usage usage;
+          usage.Checksum = entry.first.Checksum;
+          usage.SourceSize = entry.first.Size;
+          usage.Subpath = entry.first.Subpath;
+          //except temporary reference above
+          usage.Users = module.use_count() - 1;
+          usage.Hits = slot.Hits;
+          result.push_back(usage);
+        }
+      }
+      return result;
+    }
+  private:
+    //@param data module data used as identity
+    template<class OpenFunc>
+    Holder::Ptr OpenShared(Binary::Container::Ptr data, const String& subpath, OpenFunc open)
+    {
+      const Key key(*data, subpath);
+      const Slot::Ptr slot = GetSlot(key);
+      //concurrent opens of the same content are waiting for the first one
+      const std::lock_guard<std::mutex> lock(slot->Guard);
+      if (const Holder::Ptr existing = slot->Module.lock())
+      {
+        const Binary::Container::Ptr existingData = slot->Data.lock();
+        if (existingData && IsSameContent(*existingData, *data))
+        {
+          ++slot->Hits;
+          return existing;
+        }
+        Dbg("Checksum collision for %1% bytes with crc=%2%", key.Size, key.Checksum);
+        return CreateSharedHolder(open(), data);
+      }
+      const Holder::Ptr result = CreateSharedHolder(open(), data);
+      slot->Module = result;
+      slot->Data = data;
+      slot->Hits = 0;
+      return result;
+    }
+
+    struct Key
+    {
+      Key(const Binary::Data& data, String subpath)
+        : Checksum(Crc32(static_cast<const uint8_t*>(data.Start()), data.Size()))
+        , Size(data.Size())
+        , Subpath(std::move(subpath))
+      {
+      }
+
+      bool operator < (const Key& rh) const
+      {
+        return Checksum != rh.Checksum
+          ? Checksum < rh.Checksum
+          : (Size != rh.Size ? Size < rh.Size : Subpath < rh.Subpath);
+      }
+
+      const uint32_t Checksum;
+      const std::size_t Size;
+      const String Subpath;
+    };
+
+    struct Slot
+    {
+      typedef std::shared_ptr<Slot> Ptr;
+
+      Slot()
+        : Hits()
+      {
+      }
+
+      std::mutex Guard;
+      std::weak_ptr<const Holder> Module;
+      std::weak_ptr<const Binary::Container> Data;
+      std::size_t Hits;
+    };
+
+    Slot::Ptr GetSlot(const Key& key)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      const auto it = Slots.find(key);
+      if (it != Slots.end())
+      {
+        return it->second;
+      }
+      if (Slots.size() >= PruneLimit)
+      {
+        Prune();
+        PruneLimit = std::max(std::size_t(MIN_PRUNE_LIMIT), 2 * Slots.size());
+      }
+      const Slot::Ptr result = MakePtr<Slot>();
+      Slots.insert(std::make_pair(key, result));
+      return result;
+    }
+
+    //called under registry lock, so slots referenced only from here are not used by any opening
+    void Prune()
+    {
+      for (auto it = Slots.begin(); it != Slots.end();)
+      {
+        if (it->second.use_count() == 1 && it->second->Module.expired())
+        {
+          it = Slots.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+      Dbg("%1% modules alive after pruning", Slots.size());
+    }
+  private:
+    static const std::size_t MIN_PRUNE_LIMIT = 64;
+    mutable std::mutex Guard;
+    std::map<Key, Slot::Ptr> Slots;
+    std::size_t PruneLimit;
+  };
+
+  Registry& Registry::Instance()
+  {
+    static RegistryImpl instance;
+    return instance;
+  }
+}
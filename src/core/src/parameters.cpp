@@ -29,6 +29,7 @@ namespace Parameters
         extern const NameType TYPE = PREFIX + "type";
         extern const NameType INTERPOLATION = PREFIX + "interpolation";
         extern const NameType TABLE = PREFIX + "table";
+        extern const NameType CACHE = PREFIX + "cache";
         extern const NameType DUTY_CYCLE = PREFIX + "duty_cycle";
         extern const NameType DUTY_CYCLE_MASK = PREFIX + "duty_cycle_mask";
         extern const NameType LAYOUT = PREFIX + "layout";
@@ -56,6 +57,7 @@ namespace Parameters
         extern const NameType PREFIX = Core::PREFIX + "fm";
 
         extern const NameType CLOCKRATE = PREFIX + "clockrate";
+        extern const NameType ENGINE = PREFIX + "engine";
       }
 
       namespace SAA
@@ -86,6 +88,8 @@ namespace Parameters
 
           extern const NameType PLAIN_DOUBLE_ANALYSIS = PREFIX + "plain_double_analysis";
           extern const NameType MIN_SIZE = PREFIX + "min_size";
+          extern const NameType DECODE_OUTPUT_LIMIT = PREFIX + "decode_output_limit";
+          extern const NameType DECODE_WORK_LIMIT = PREFIX + "decode_work_limit";
         }
 
         namespace Hrip
@@ -15,6 +15,7 @@
 #include "volume_table.h"
 //library includes
 #include <devices/details/analysis_map.h>
+#include <devices/details/state_snapshots.h>
 #include <parameters/tracking_helper.h>
 
 namespace Devices
@@ -33,6 +34,7 @@ namespace AYM
       , Clock()
       , Renderers(Clock, PSG)
     {
+      State.reserve(Traits::VOICES);
       SoundChip::Reset();
     }
 
@@ -44,6 +46,7 @@ namespace AYM
         RenderTill(src.TimeStamp);
       }
       PSG.SetNewData(src.Data);
+      PublishState();
     }
 
     void RenderData(const std::vector<typename Traits::DataChunkType>& src) override
@@ -74,6 +77,7 @@ namespace AYM
           PSG.SetNewData(chunk.Data);
         }
       }
+      PublishState();
     }
 
     void Reset() override
@@ -81,20 +85,34 @@ namespace AYM
       Params.Reset();
       PSG.Reset();
       Renderers.Reset();
+      States.Reset();
     }
 
     MultiChannelState GetState() const override
     {
       MultiChannelState res;
       res.reserve(Traits::VOICES);
-      PSG.GetState(res);
-      for (auto& re : res)
+      States.Get(0, res);
+      return res;
+    }
+
+    void GetState(uint_t lag, MultiChannelState& state) const override
+    {
+      States.Get(lag, state);
+    }
+  private:
+    //called from render thread, so polling does not touch PSG state being rendered
+    void PublishState()
+    {
+      State.clear();
+      PSG.GetState(State);
+      for (auto& re : State)
       {
         re.Band = Analyser.GetBandByPeriod(re.Band);
       }
-      return res;
+      States.Publish(State);
     }
-  private:
+
     void SynchronizeParameters()
     {
       const uint_t AYM_CLOCK_DIVISOR = 8;
@@ -129,6 +147,8 @@ namespace AYM
     ClockSource Clock;
     Details::AnalysisMap Analyser;
     RenderersSet<typename Traits::PSGType> Renderers;
+    MultiChannelState State;
+    Details::StateSnapshots<Traits::VOICES> States;
   };
 }
 }
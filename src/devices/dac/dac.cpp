@@ -22,6 +22,7 @@
 #include <array>
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace Devices
 {
@@ -333,23 +334,24 @@ namespace DAC
       }
     }
 
-    Sound::Sample::Type GetNearest() const
+    //fill planar buffer, silence after sample end
+    template<class SampleGetter>
+    void Render(uint_t samples, SampleGetter getter, Sound::Sample::Type* out)
     {
-      return Enabled
-        ? Amplify(Iterator.GetNearest())
-        : Sound::Sample::MID;
-    }
-
-    Sound::Sample::Type GetInterpolated(const uint_t* lookup) const
-    {
-      return Enabled
-        ? Amplify(Iterator.GetInterpolated(lookup))
-        : Sound::Sample::MID;
+      Sound::Sample::Type* const end = out + samples;
+      for (; Enabled && out != end; ++out)
+      {
+        *out = Amplify(getter(Iterator));
+        Iterator.Next();
+        Enabled = Iterator.IsValid();
+      }
+      std::fill(out, end, Sound::Sample::MID);
     }
 
-    void Next()
+    //advance position without rendering, silence after sample end
+    void Skip(uint_t samples)
     {
-      if (Enabled)
+      for (; Enabled && samples != 0; --samples)
       {
         Iterator.Next();
         Enabled = Iterator.IsValid();
@@ -379,10 +381,10 @@ namespace DAC
   };
 
   template<unsigned Channels>
-  class LQRenderer : public Renderer
+  class BlockRenderer : public Renderer
   {
   public:
-    LQRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
+    BlockRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
       : Mixer(mixer)
       , State(state)
     {
@@ -390,47 +392,61 @@ namespace DAC
 
     void RenderData(uint_t samples, Sound::ChunkBuilder& target) override
     {
-      typename Sound::MultichannelSample<Channels>::Type result;
-      for (uint_t counter = samples; counter != 0; --counter)
+      Buffer.resize(std::max<std::size_t>(Buffer.size(), samples * Channels));
+      for (uint_t chan = 0; chan != Channels; ++chan)
       {
-        for (uint_t chan = 0; chan != Channels; ++chan)
-        {
-          ChannelState& state = State[chan];
-          result[chan] = state.GetNearest();
-          state.Next();
-        }
-        target.Add(Mixer.ApplyData(result));
+        RenderChannel(State[chan], samples, Buffer.data() + chan * samples);
       }
+      MixChannels(samples, target.Allocate(samples));
+    }
+  protected:
+    virtual void RenderChannel(ChannelState& state, uint_t samples, Sound::Sample::Type* out) const = 0;
+  private:
+    void MixChannels(uint_t samples, Sound::Sample* out) const
+    {
+      typename Sound::FixedChannelsMixer<Channels>::InBlockType planes;
+      for (uint_t chan = 0; chan != Channels; ++chan)
+      {
+        planes[chan] = Buffer.data() + chan * samples;
+      }
+      Mixer.ApplyBlock(planes, samples, out);
     }
   private:
     const Sound::FixedChannelsMixer<Channels>& Mixer;
     ChannelState* const State;
+    //planar channels data for the whole rendered block
+    std::vector<Sound::Sample::Type> Buffer;
   };
 
   template<unsigned Channels>
-  class MQRenderer : public Renderer
+  class LQRenderer : public BlockRenderer<Channels>
   {
   public:
-    MQRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
-      : Mixer(mixer)
-      , State(state)
+    LQRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
+      : BlockRenderer<Channels>(mixer, state)
+    {
+    }
+  protected:
+    void RenderChannel(ChannelState& state, uint_t samples, Sound::Sample::Type* out) const override
     {
+      state.Render(samples, [](const FastSample::Iterator& it) {return it.GetNearest();}, out);
     }
+  };
 
-    void RenderData(uint_t samples, Sound::ChunkBuilder& target) override
+  template<unsigned Channels>
+  class MQRenderer : public BlockRenderer<Channels>
+  {
+  public:
+    MQRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
+      : BlockRenderer<Channels>(mixer, state)
+    {
+    }
+  protected:
+    void RenderChannel(ChannelState& state, uint_t samples, Sound::Sample::Type* out) const override
     {
       static const CosineTable COSTABLE;
-      typename Sound::MultichannelSample<Channels>::Type result;
-      for (uint_t counter = samples; counter != 0; --counter)
-      {
-        for (uint_t chan = 0; chan != Channels; ++chan)
-        {
-          ChannelState& state = State[chan];
-          result[chan] = state.GetInterpolated(COSTABLE.Get());
-          state.Next();
-        }
-        target.Add(Mixer.ApplyData(result));
-      }
+      const uint_t* const lookup = COSTABLE.Get();
+      state.Render(samples, [lookup](const FastSample::Iterator& it) {return it.GetInterpolated(lookup);}, out);
     }
   private:
     class CosineTable
@@ -452,9 +468,6 @@ namespace DAC
     private:
       std::array<uint_t, FastSample::Position::PRECISION> Table;
     };
-  private:
-    const Sound::FixedChannelsMixer<Channels>& Mixer;
-    ChannelState* const State;
   };
 
   template<unsigned Channels>
@@ -493,9 +506,9 @@ namespace DAC
 
     void DropData(uint_t samples)
     {
-      for (uint_t count = samples; count != 0; --count)
+      for (uint_t chan = 0; chan != Channels; ++chan)
       {
-        std::for_each(State, State + Channels, std::mem_fun_ref(&ChannelState::Next));
+        State[chan].Skip(samples);
       }
     }
   private:
@@ -0,0 +1,126 @@
+/**
+*
+* @file
+*
+* @brief  Lock-free device state snapshots storage
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <devices/state.h>
+//std includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace Devices
+{
+  namespace Details
+  {
+    /*
+      Ring of compact channel states published by the single render thread.
+      Every slot is guarded by the sequence lock, so readers from any thread neither block the writer nor allocate memory
+      (if target capacity is enough) and never get partially updated state.
+    */
+    template<uint_t Channels, uint_t Depth = 16>
+    class StateSnapshots
+    {
+    public:
+      static const uint_t HISTORY_DEPTH = Depth - 1;
+
+      StateSnapshots()
+        : Published()
+      {
+        for (auto& slot : Slots)
+        {
+          slot.Sequence = 0;
+          slot.Count = 0;
+        }
+      }
+
+      void Reset()
+      {
+        Publish(MultiChannelState());
+      }
+
+      //called from render thread only
+      void Publish(const MultiChannelState& state)
+      {
+        const uint_t idx = Published.load(std::memory_order_relaxed);
+        Slot& slot = Slots[idx % Depth];
+        const uint_t seq = slot.Sequence.load(std::memory_order_relaxed);
+        slot.Sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        const std::size_t count = std::min<std::size_t>(state.size(), Channels);
+        for (std::size_t chan = 0; chan != count; ++chan)
+        {
+          slot.Data[chan].store(Pack(state[chan]), std::memory_order_relaxed);
+        }
+        slot.Count.store(static_cast<uint_t>(count), std::memory_order_relaxed);
+        slot.Sequence.store(seq + 2, std::memory_order_release);
+        Published.store(idx + 1, std::memory_order_release);
+      }
+
+      //@param lag published states count back from the most recent one, limited by HISTORY_DEPTH
+      void Get(uint_t lag, MultiChannelState& state) const
+      {
+        std::array<uint32_t, Channels> data;
+        for (;;)
+        {
+          const uint_t published = Published.load(std::memory_order_acquire);
+          if (!published)
+          {
+            state.clear();
+            return;
+          }
+          const uint_t maxLag = std::min(uint_t(HISTORY_DEPTH), published - 1);
+          const uint_t back = std::min(lag, maxLag);
+          const Slot& slot = Slots[(published - 1 - back) % Depth];
+          const uint_t seq = slot.Sequence.load(std::memory_order_acquire);
+          if (seq & 1)
+          {
+            continue;
+          }
+          const uint_t count = slot.Count.load(std::memory_order_relaxed);
+          for (uint_t chan = 0; chan != count; ++chan)
+          {
+            data[chan] = slot.Data[chan].load(std::memory_order_relaxed);
+          }
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (slot.Sequence.load(std::memory_order_relaxed) == seq)
+          {
+            state.resize(count);
+            for (uint_t chan = 0; chan != count; ++chan)
+            {
+              state[chan] = Unpack(data[chan]);
+            }
+            return;
+          }
+        }
+      }
+    private:
+      static uint32_t Pack(const ChannelState& state)
+      {
+        return (uint32_t(state.Band) << 16) | uint16_t(state.Level.Raw());
+      }
+
+      static ChannelState Unpack(uint32_t packed)
+      {
+        return ChannelState(packed >> 16, LevelType(packed & 0xffff, uint_t(LevelType::PRECISION)));
+      }
+    private:
+      struct Slot
+      {
+        std::atomic<uint_t> Sequence;
+        std::atomic<uint_t> Count;
+        std::array<std::atomic<uint32_t>, Channels> Data;
+      };
+      std::array<Slot, Depth> Slots;
+      std::atomic<uint_t> Published;
+    };
+  }
+}
@@ -86,6 +86,14 @@ namespace Devices
       typedef std::shared_ptr<Chip> Ptr;
     };
 
+    enum EngineType
+    {
+      //original per-chip emulation
+      ENGINE_REFERENCE = 0,
+      //all the chips' operators are calculated at once, same output
+      ENGINE_BATCH = 1
+    };
+
     class ChipParameters
     {
     public:
@@ -96,6 +104,7 @@ namespace Devices
       virtual uint_t Version() const = 0;
       virtual uint64_t ClockFreq() const = 0;
       virtual uint_t SoundFreq() const = 0;
+      virtual EngineType Engine() const = 0;
     };
 
     /// Virtual constructors
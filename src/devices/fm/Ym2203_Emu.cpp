@@ -24,6 +24,11 @@
 #include <stdarg.h>
 #include <math.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YM2203_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
 
 #define FREQ_SH			16  /* 16.16 fixed point (frequency calculations) */
 #define EG_SH			16  /* 16.16 fixed point (envelope generator timing) */
@@ -568,143 +573,157 @@ inline signed int op_calc1(uint32_t phase, unsigned int env, signed int pm)
 }
 
 
-inline void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
+/* output of EG circuit for current state */
+inline uint32_t eg_slot_out(const FM_SLOT *SLOT)
+{
+	unsigned int out = SLOT->tl + ((uint32_t)SLOT->volume);
+
+	if ((SLOT->ssg&0x08) && (SLOT->ssgn&2) && (SLOT->state != EG_OFF/*Alone Coder*/))	/* negate output (changes come from alternate bit, init comes from attack bit) */
+		out ^= 511/*Alone Coder*/; //((1<<ENV_BITS)-1); /* 1023 */
+	return out;
+}
+
+/* advance envelope generator of single operator, returns non-zero if phase generator should be restarted */
+inline int advance_eg_slot(uint32_t eg_cnt, FM_SLOT *SLOT)
 {
-	unsigned int out;
 	unsigned int swap_flag = 0;
-	unsigned int i;
+	int restart = 0;
 
 #define SSGEG_SCALE	4 //8 // 4,     -    ,      
 
-	i = 4; /* four operators per channel */
-	do
+	switch(SLOT->state)
 	{
-		switch(SLOT->state)
+	case EG_ATT:		/* attack phase */
+		if ( !(eg_cnt & ((1<<SLOT->eg_sh_ar)-1) ) )
 		{
-		case EG_ATT:		/* attack phase */
-			if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_ar)-1) ) )
-			{
-				SLOT->volume += (~SLOT->volume *
-                                  (eg_inc[SLOT->eg_sel_ar + ((OPN->eg_cnt>>SLOT->eg_sh_ar)&7)])
+			SLOT->volume += (~SLOT->volume *
+                                  (eg_inc[SLOT->eg_sel_ar + ((eg_cnt>>SLOT->eg_sh_ar)&7)])
                                 ) >>4;
 
-				if (SLOT->volume <= MIN_ATT_INDEX)
-				{
-					SLOT->volume = MIN_ATT_INDEX;
-					SLOT->state = EG_DEC;
-				}
+			if (SLOT->volume <= MIN_ATT_INDEX)
+			{
+				SLOT->volume = MIN_ATT_INDEX;
+				SLOT->state = EG_DEC;
 			}
-		break;
+		}
+	break;
 
-		case EG_DEC:	/* decay phase */
-			if (SLOT->ssg&0x08)	/* SSG EG type envelope selected */
+	case EG_DEC:	/* decay phase */
+		if (SLOT->ssg&0x08)	/* SSG EG type envelope selected */
+		{
+			if ( !(eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
 			{
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
-				{
-					//SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d1r + ((OPN->eg_cnt>>SLOT->eg_sh_d1r)&7)];
-					SLOT->volume += SSGEG_SCALE * eg_inc[SLOT->eg_sel_d1r + ((OPN->eg_cnt>>SLOT->eg_sh_d1r)&7)];
+				//SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d1r + ((eg_cnt>>SLOT->eg_sh_d1r)&7)];
+				SLOT->volume += SSGEG_SCALE * eg_inc[SLOT->eg_sel_d1r + ((eg_cnt>>SLOT->eg_sh_d1r)&7)];
 
-					if ( SLOT->volume >= (int32_t)(SLOT->sl) )
-						SLOT->state = EG_SUS;
-				}
+				if ( SLOT->volume >= (int32_t)(SLOT->sl) )
+					SLOT->state = EG_SUS;
 			}
-			else
+		}
+		else
+		{
+			if ( !(eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
 			{
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
-				{
-					SLOT->volume += eg_inc[SLOT->eg_sel_d1r + ((OPN->eg_cnt>>SLOT->eg_sh_d1r)&7)];
+				SLOT->volume += eg_inc[SLOT->eg_sel_d1r + ((eg_cnt>>SLOT->eg_sh_d1r)&7)];
 
-					if ( SLOT->volume >= (int32_t)(SLOT->sl) )
-						SLOT->state = EG_SUS;
-				}
+				if ( SLOT->volume >= (int32_t)(SLOT->sl) )
+					SLOT->state = EG_SUS;
 			}
-		break;
+		}
+	break;
 
-		case EG_SUS:	/* sustain phase */
-			if (SLOT->ssg&0x08)	/* SSG EG type envelope selected */
+	case EG_SUS:	/* sustain phase */
+		if (SLOT->ssg&0x08)	/* SSG EG type envelope selected */
+		{
+			if ( !(eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
 			{
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
+				//SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d2r + ((eg_cnt>>SLOT->eg_sh_d2r)&7)];
+				SLOT->volume += SSGEG_SCALE * eg_inc[SLOT->eg_sel_d2r + ((eg_cnt>>SLOT->eg_sh_d2r)&7)];
+
+				if ( SLOT->volume >= 512 /*  MAX_ATT_INDEX */ ) //Alone Coder
 				{
-					//SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d2r + ((OPN->eg_cnt>>SLOT->eg_sh_d2r)&7)];
-					SLOT->volume += SSGEG_SCALE * eg_inc[SLOT->eg_sel_d2r + ((OPN->eg_cnt>>SLOT->eg_sh_d2r)&7)];
+					SLOT->volume = MAX_ATT_INDEX;
 
-					if ( SLOT->volume >= 512 /*  MAX_ATT_INDEX */ ) //Alone Coder
+					if (SLOT->ssg&0x01)	/* bit 0 = hold */
 					{
-						SLOT->volume = MAX_ATT_INDEX;
-
-						if (SLOT->ssg&0x01)	/* bit 0 = hold */
+						if (SLOT->ssgn&1)	/* have we swapped once ??? */
 						{
-							if (SLOT->ssgn&1)	/* have we swapped once ??? */
-							{
-								/* yes, so do nothing, just hold current level */
-							}
-							else
-								swap_flag = (SLOT->ssg&0x02) | 1 ; /* bit 1 = alternate */
-
+							/* yes, so do nothing, just hold current level */
 						}
 						else
-						{
-							/* same as KEY-ON operation */
+							swap_flag = (SLOT->ssg&0x02) | 1 ; /* bit 1 = alternate */
+
+					}
+					else
+					{
+						/* same as KEY-ON operation */
 
-							/* restart of the Phase Generator should be here,
+						/* restart of the Phase Generator should be here,
                                 only if AR is not maximum ??? ALWAYS! */
-							SLOT->phase = 0; //Alone Coder
+						restart = 1; //Alone Coder
 
-							/* phase -> Attack */
-						   SLOT->volume = 511; //Alone Coder
-							SLOT->state = EG_ATT;
+						/* phase -> Attack */
+					   SLOT->volume = 511; //Alone Coder
+						SLOT->state = EG_ATT;
 
-							swap_flag = (SLOT->ssg&0x02); /* bit 1 = alternate */
-						}
+						swap_flag = (SLOT->ssg&0x02); /* bit 1 = alternate */
 					}
 				}
 			}
-			else
+		}
+		else
+		{
+			if ( !(eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
 			{
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
-				{
-					SLOT->volume += eg_inc[SLOT->eg_sel_d2r + ((OPN->eg_cnt>>SLOT->eg_sh_d2r)&7)];
+				SLOT->volume += eg_inc[SLOT->eg_sel_d2r + ((eg_cnt>>SLOT->eg_sh_d2r)&7)];
 
-					if ( SLOT->volume >= MAX_ATT_INDEX )
-					{
-						SLOT->volume = MAX_ATT_INDEX;
-						/* do not change SLOT->state (verified on real chip) */
-					}
+				if ( SLOT->volume >= MAX_ATT_INDEX )
+				{
+					SLOT->volume = MAX_ATT_INDEX;
+					/* do not change SLOT->state (verified on real chip) */
 				}
-
 			}
-		break;
 
-		case EG_REL:	/* release phase */
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_rr)-1) ) )
-				{
-					SLOT->volume += eg_inc[SLOT->eg_sel_rr + ((OPN->eg_cnt>>SLOT->eg_sh_rr)&7)];
+		}
+	break;
 
-					if ( SLOT->volume >= MAX_ATT_INDEX )
-					{
-						SLOT->volume = MAX_ATT_INDEX;
-						SLOT->state = EG_OFF;
-					}
+	case EG_REL:	/* release phase */
+			if ( !(eg_cnt & ((1<<SLOT->eg_sh_rr)-1) ) )
+			{
+				SLOT->volume += eg_inc[SLOT->eg_sel_rr + ((eg_cnt>>SLOT->eg_sh_rr)&7)];
+
+				if ( SLOT->volume >= MAX_ATT_INDEX )
+				{
+					SLOT->volume = MAX_ATT_INDEX;
+					SLOT->state = EG_OFF;
 				}
-		break;
+			}
+	break;
 
-		}
+	}
 
-		out = SLOT->tl + ((uint32_t)SLOT->volume);
+	/* we need to store the result here because we are going to change ssgn
+            in next instruction */
+	SLOT->vol_out = eg_slot_out(SLOT);
 
-		if ((SLOT->ssg&0x08) && (SLOT->ssgn&2) && (SLOT->state != EG_OFF/*Alone Coder*/))	/* negate output (changes come from alternate bit, init comes from attack bit) */
-			out ^= 511/*Alone Coder*/; //((1<<ENV_BITS)-1); /* 1023 */
+	SLOT->ssgn ^= swap_flag;
 
-		/* we need to store the result here because we are going to change ssgn
-            in next instruction */
-		SLOT->vol_out = out;
+	return restart;
+}
 
-		SLOT->ssgn ^= swap_flag;
+inline void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
+{
+	unsigned int i;
+
+	i = 4; /* four operators per channel */
+	do
+	{
+		if (advance_eg_slot(OPN->eg_cnt, SLOT))
+			SLOT->phase = 0;
 
 		SLOT++;
 		i--;
 	}while (i);
-
 }
 
 
@@ -1222,19 +1241,16 @@ typedef struct
 	FM_CH CH[3];			/* channel state     */
 } YM2203;
 
-/* Generate samples for one of the YM2203s */
-void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
+/* refresh PG and EG of all the channels */
+static void refresh_fc_eg_chip(YM2203 *F2203)
 {
-	YM2203 *F2203 = (YM2203*)chip;
 	FM_OPN *OPN =   &F2203->OPN;
-	FM_STATE *state = &F2203->State;
 	FM_CH	*cch[3];
 
 	cch[0]   = &F2203->CH[0];
 	cch[1]   = &F2203->CH[1];
 	cch[2]   = &F2203->CH[2];
 
-	/* refresh PG and EG */
 	refresh_fc_eg_chan( cch[0] );
 	refresh_fc_eg_chan( cch[1] );
 	if( (F2203->OPN.ST.mode & 0xc0) )
@@ -1248,6 +1264,22 @@ void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
 			refresh_fc_eg_slot(&cch[2]->SLOT[SLOT4] , cch[2]->fc , cch[2]->kcode );
 		}
 	}else refresh_fc_eg_chan( cch[2] );
+}
+
+/* Generate samples for one of the YM2203s */
+void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
+{
+	YM2203 *F2203 = (YM2203*)chip;
+	FM_OPN *OPN =   &F2203->OPN;
+	FM_STATE *state = &F2203->State;
+	FM_CH	*cch[3];
+
+	cch[0]   = &F2203->CH[0];
+	cch[1]   = &F2203->CH[1];
+	cch[2]   = &F2203->CH[2];
+
+	/* refresh PG and EG */
+	refresh_fc_eg_chip( F2203 );
 
 	/* buffering */
 	for (int32_t* buf = buffer, *lim = buffer + length; buf != lim; ++buf)
@@ -1275,6 +1307,396 @@ void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
 	}
 }
 
+/* -------------------- batched (structure-of-arrays) update -------------------- */
+
+/*
+  Operators of all the channels of several chips are calculated at once, channel 'c' of chip 'n' occupies
+  lane 3*n+c. Algorithm connections (see setup_connection) are replaced by routing masks, so each operator
+  stage is the same arithmetic for all the lanes and may be vectorized. Output is the same as YM2203UpdateOne's.
+*/
+#define BATCH_LANES	8
+#define BATCH_CHIPS	(BATCH_LANES/3)
+
+/* where delayed sample (MEM) and operators outputs go */
+#define ROUTE_MEM_M2	0
+#define ROUTE_MEM_C2	1
+#define ROUTE_MEM_MEM	2
+#define ROUTE_OP1_C1	3
+#define ROUTE_OP1_C2	4
+#define ROUTE_OP1_MEM	5
+#define ROUTE_OP1_OUT	6
+#define ROUTE_OP3_C2	7
+#define ROUTE_OP3_OUT	8
+#define ROUTE_OP2_MEM	9
+#define ROUTE_OP2_OUT	10
+#define ROUTES			11
+
+#define R(a) (1<<ROUTE_##a)
+static const uint_t algo_routes[8]={
+/* 0 */ R(MEM_M2)  | R(OP1_C1) | R(OP3_C2) | R(OP2_MEM),
+/* 1 */ R(MEM_M2)  | R(OP1_MEM) | R(OP3_C2) | R(OP2_MEM),
+/* 2 */ R(MEM_M2)  | R(OP1_C2) | R(OP3_C2) | R(OP2_MEM),
+/* 3 */ R(MEM_C2)  | R(OP1_C1) | R(OP3_C2) | R(OP2_MEM),
+/* 4 */ R(MEM_MEM) | R(OP1_C1) | R(OP3_C2) | R(OP2_OUT),
+/* 5 */ R(MEM_M2)  | R(OP1_C1) | R(OP1_C2) | R(OP1_MEM) | R(OP3_OUT) | R(OP2_OUT),
+/* 6 */ R(MEM_MEM) | R(OP1_C1) | R(OP3_OUT) | R(OP2_OUT),
+/* 7 */ R(MEM_MEM) | R(OP1_OUT) | R(OP3_OUT) | R(OP2_OUT)
+};
+#undef R
+
+typedef struct
+{
+	/* operators state, indexed by slot number (as in FM_CH) */
+	uint32_t	phase[4][BATCH_LANES];
+	uint32_t	Incr[4][BATCH_LANES];
+	uint32_t	vol_out[4][BATCH_LANES];
+
+	/* channels state */
+	int32_t	op1_out[2][BATCH_LANES];
+	int32_t	mem_value[BATCH_LANES];
+	int32_t	FB[BATCH_LANES];
+	int32_t	fb_mask[BATCH_LANES];	/* 0 if no feedback */
+	int32_t	route[ROUTES][BATCH_LANES];	/* -1 if connected */
+} FM_BATCH;
+
+/* op_calc1 for silent operators (vol_out >= ENV_QUIET) produces 0 due to table size check */
+inline signed int op_calc_lane(uint32_t phase, unsigned int env, signed int pm)
+{
+	return env < ENV_QUIET ? op_calc1(phase, env, pm) : 0;
+}
+
+/* envelope generator steps do not change anything, e.g. for released operators */
+inline int eg_slot_idle(const FM_SLOT *SLOT)
+{
+	const int stable = SLOT->state == EG_OFF || (SLOT->state == EG_SUS && !(SLOT->ssg&0x08) && SLOT->volume == MAX_ATT_INDEX);
+	return stable && SLOT->vol_out == eg_slot_out(SLOT);
+}
+
+/* number of envelope generator steps till the one which may change operator's state */
+inline uint32_t eg_slot_delay(uint32_t eg_cnt, const FM_SLOT *SLOT)
+{
+	uint_t sh;
+	/* e.g. ssgn is changed after vol_out calculation */
+	if (SLOT->vol_out != eg_slot_out(SLOT))
+		return 1;
+	switch(SLOT->state)
+	{
+	case EG_ATT: sh = SLOT->eg_sh_ar; break;
+	case EG_DEC: sh = SLOT->eg_sh_d1r; break;
+	case EG_SUS: sh = SLOT->eg_sh_d2r; break;
+	case EG_REL: sh = SLOT->eg_sh_rr; break;
+	default: return 1;
+	}
+	return ((eg_cnt | ((1<<sh)-1)) + 1) - eg_cnt;
+}
+
+static void batch_load(FM_BATCH *batch, int lane, const FM_CH *CH)
+{
+	for (int s = 0; s < 4; ++s)
+	{
+		batch->phase[s][lane] = CH->SLOT[s].phase;
+		batch->Incr[s][lane] = CH->SLOT[s].Incr;
+		batch->vol_out[s][lane] = CH->SLOT[s].vol_out;
+	}
+	batch->op1_out[0][lane] = CH->op1_out[0];
+	batch->op1_out[1][lane] = CH->op1_out[1];
+	batch->mem_value[lane] = CH->mem_value;
+	batch->FB[lane] = CH->FB;
+	batch->fb_mask[lane] = CH->FB ? -1 : 0;
+	const uint_t routes = algo_routes[CH->ALGO & 7];
+	for (int r = 0; r < ROUTES; ++r)
+	{
+		batch->route[r][lane] = (routes & (1 << r)) ? -1 : 0;
+	}
+}
+
+static void batch_store(const FM_BATCH *batch, int lane, FM_CH *CH)
+{
+	for (int s = 0; s < 4; ++s)
+	{
+		CH->SLOT[s].phase = batch->phase[s][lane];
+	}
+	CH->op1_out[0] = batch->op1_out[0][lane];
+	CH->op1_out[1] = batch->op1_out[1][lane];
+	CH->mem_value = batch->mem_value[lane];
+}
+
+/* same as chan_calc for 'lanes' first lanes, buffer is filled with sum of them for 'samples' samples */
+static void batch_calc(FM_BATCH *batch, int lanes, int32_t *buffer, int samples)
+{
+	memset(buffer, 0, samples * sizeof(*buffer));
+	for (int l = 0; l < lanes; ++l)
+	{
+		const int32_t route_mem_m2 = batch->route[ROUTE_MEM_M2][l];
+		const int32_t route_mem_c2 = batch->route[ROUTE_MEM_C2][l];
+		const int32_t route_mem_mem = batch->route[ROUTE_MEM_MEM][l];
+		const int32_t route_op1_c1 = batch->route[ROUTE_OP1_C1][l];
+		const int32_t route_op1_c2 = batch->route[ROUTE_OP1_C2][l];
+		const int32_t route_op1_mem = batch->route[ROUTE_OP1_MEM][l];
+		const int32_t route_op1_out = batch->route[ROUTE_OP1_OUT][l];
+		const int32_t route_op3_c2 = batch->route[ROUTE_OP3_C2][l];
+		const int32_t route_op3_out = batch->route[ROUTE_OP3_OUT][l];
+		const int32_t route_op2_mem = batch->route[ROUTE_OP2_MEM][l];
+		const int32_t route_op2_out = batch->route[ROUTE_OP2_OUT][l];
+		const int32_t FB = batch->FB[l];
+		const int32_t fb_mask = batch->fb_mask[l];
+		uint32_t phase[4], Incr[4], env[4];
+		for (int s = 0; s < 4; ++s)
+		{
+			phase[s] = batch->phase[s][l];
+			Incr[s] = batch->Incr[s][l];
+			env[s] = batch->vol_out[s][l];
+		}
+		int32_t op1_prev = batch->op1_out[0][l];
+		int32_t op1 = batch->op1_out[1][l];
+		int32_t mem_value = batch->mem_value[l];
+
+		for (int i = 0; i < samples; ++i)
+		{
+			const int32_t fb = ((op1_prev + op1) << FB) & fb_mask;
+			const int32_t out1 = op_calc_lane(phase[SLOT1], env[SLOT1], fb);
+
+			const int32_t m2 = mem_value & route_mem_m2;
+			const int32_t c1 = op1 & route_op1_c1;
+			int32_t c2 = (mem_value & route_mem_c2) + (op1 & route_op1_c2);
+			int32_t mem = (mem_value & route_mem_mem) + (op1 & route_op1_mem);
+			int32_t res = op1 & route_op1_out;
+
+			const int32_t out3 = op_calc_lane(phase[SLOT3], env[SLOT3], m2<<15);
+			c2 += out3 & route_op3_c2;
+			res += out3 & route_op3_out;
+
+			const int32_t out2 = op_calc_lane(phase[SLOT2], env[SLOT2], c1<<15);
+			mem += out2 & route_op2_mem;
+			res += out2 & route_op2_out;
+
+			res += op_calc_lane(phase[SLOT4], env[SLOT4], c2<<15);
+			buffer[i] += res;
+
+			op1_prev = op1;
+			op1 = out1;
+			mem_value = mem;
+			for (int s = 0; s < 4; ++s)
+				phase[s] += Incr[s];
+		}
+
+		for (int s = 0; s < 4; ++s)
+			batch->phase[s][l] = phase[s];
+		batch->op1_out[0][l] = op1_prev;
+		batch->op1_out[1][l] = op1;
+		batch->mem_value[l] = mem_value;
+	}
+}
+
+#ifdef YM2203_BATCH_AVX2
+#define BATCH_TARGET __attribute__((target("avx2")))
+
+/* silent operators (vol_out >= ENV_QUIET) produce 0 due to table size check, both lookups use gather */
+BATCH_TARGET inline __m256i op_calc_avx2(__m256i phase, __m256i env, __m256i pm)
+{
+	const __m256i ph = _mm256_and_si256(phase, _mm256_set1_epi32(~FREQ_MASK));
+	const __m256i idx = _mm256_and_si256(_mm256_srli_epi32(_mm256_add_epi32(ph, pm), FREQ_SH), _mm256_set1_epi32(SIN_MASK));
+	const __m256i sin = _mm256_i32gather_epi32((const int*)sin_tab, idx, 4);
+	const __m256i p = _mm256_add_epi32(_mm256_slli_epi32(env, 3), sin);
+	const __m256i valid = _mm256_cmpgt_epi32(_mm256_set1_epi32(TL_TAB_LEN), p);
+	return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)tl_tab, p, valid, 4);
+}
+
+/* same as batch_calc, all the lanes are calculated (unused ones are silent) and kept in registers */
+BATCH_TARGET static void batch_calc_avx2(FM_BATCH *batch, int /*lanes*/, int32_t *buffer, int samples)
+{
+#define LOAD(a) _mm256_loadu_si256((const __m256i*)(a))
+#define STORE(a, v) _mm256_storeu_si256((__m256i*)(a), v)
+#define ROUTE(val, r) _mm256_and_si256(val, route[r])
+	__m256i route[ROUTES];
+	for (int r = 0; r < ROUTES; ++r)
+		route[r] = LOAD(batch->route[r]);
+	const __m256i FB = LOAD(batch->FB);
+	const __m256i fb_mask = LOAD(batch->fb_mask);
+	const __m256i incr1 = LOAD(batch->Incr[SLOT1]);
+	const __m256i incr2 = LOAD(batch->Incr[SLOT2]);
+	const __m256i incr3 = LOAD(batch->Incr[SLOT3]);
+	const __m256i incr4 = LOAD(batch->Incr[SLOT4]);
+	const __m256i env1 = LOAD(batch->vol_out[SLOT1]);
+	const __m256i env2 = LOAD(batch->vol_out[SLOT2]);
+	const __m256i env3 = LOAD(batch->vol_out[SLOT3]);
+	const __m256i env4 = LOAD(batch->vol_out[SLOT4]);
+	__m256i phase1 = LOAD(batch->phase[SLOT1]);
+	__m256i phase2 = LOAD(batch->phase[SLOT2]);
+	__m256i phase3 = LOAD(batch->phase[SLOT3]);
+	__m256i phase4 = LOAD(batch->phase[SLOT4]);
+	__m256i op1_prev = LOAD(batch->op1_out[0]);
+	__m256i op1 = LOAD(batch->op1_out[1]);
+	__m256i mem_value = LOAD(batch->mem_value);
+
+	for (int i = 0; i < samples; ++i)
+	{
+		const __m256i fb = _mm256_and_si256(_mm256_sllv_epi32(_mm256_add_epi32(op1_prev, op1), FB), fb_mask);
+		const __m256i out1 = op_calc_avx2(phase1, env1, fb);
+
+		const __m256i m2 = ROUTE(mem_value, ROUTE_MEM_M2);
+		const __m256i c1 = ROUTE(op1, ROUTE_OP1_C1);
+		__m256i c2 = _mm256_add_epi32(ROUTE(mem_value, ROUTE_MEM_C2), ROUTE(op1, ROUTE_OP1_C2));
+		__m256i mem = _mm256_add_epi32(ROUTE(mem_value, ROUTE_MEM_MEM), ROUTE(op1, ROUTE_OP1_MEM));
+		__m256i res = ROUTE(op1, ROUTE_OP1_OUT);
+
+		const __m256i out3 = op_calc_avx2(phase3, env3, _mm256_slli_epi32(m2, 15));
+		c2 = _mm256_add_epi32(c2, ROUTE(out3, ROUTE_OP3_C2));
+		res = _mm256_add_epi32(res, ROUTE(out3, ROUTE_OP3_OUT));
+
+		const __m256i out2 = op_calc_avx2(phase2, env2, _mm256_slli_epi32(c1, 15));
+		mem = _mm256_add_epi32(mem, ROUTE(out2, ROUTE_OP2_MEM));
+		res = _mm256_add_epi32(res, ROUTE(out2, ROUTE_OP2_OUT));
+
+		res = _mm256_add_epi32(res, op_calc_avx2(phase4, env4, _mm256_slli_epi32(c2, 15)));
+
+		__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(res), _mm256_extracti128_si256(res, 1));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+		buffer[i] = _mm_cvtsi128_si32(sum);
+
+		op1_prev = op1;
+		op1 = out1;
+		mem_value = mem;
+		phase1 = _mm256_add_epi32(phase1, incr1);
+		phase2 = _mm256_add_epi32(phase2, incr2);
+		phase3 = _mm256_add_epi32(phase3, incr3);
+		phase4 = _mm256_add_epi32(phase4, incr4);
+	}
+
+	STORE(batch->phase[SLOT1], phase1);
+	STORE(batch->phase[SLOT2], phase2);
+	STORE(batch->phase[SLOT3], phase3);
+	STORE(batch->phase[SLOT4], phase4);
+	STORE(batch->op1_out[0], op1_prev);
+	STORE(batch->op1_out[1], op1);
+	STORE(batch->mem_value, mem_value);
+#undef ROUTE
+#undef STORE
+#undef LOAD
+}
+#undef BATCH_TARGET
+#endif
+
+typedef void (*batch_calc_func)(FM_BATCH *batch, int lanes, int32_t *buffer, int samples);
+
+static batch_calc_func select_batch_calc(void)
+{
+#ifdef YM2203_BATCH_AVX2
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return &batch_calc_avx2;
+#endif
+	return &batch_calc;
+}
+
+/* eg_cnt value when operator's state may change next time */
+inline uint32_t eg_slot_next(uint32_t eg_cnt, const FM_SLOT *SLOT)
+{
+	/* far enough to never be reached while rendering */
+	return eg_cnt + (eg_slot_idle(SLOT) ? 1u << 31 : eg_slot_delay(eg_cnt, SLOT));
+}
+
+/*
+  Generate sum of samples for several YM2203s.
+  Envelope generator steps are performed only for operators whose state may change, FM is calculated
+  for the whole spans between such steps.
+*/
+void YM2203UpdateBatch(void * const *chips, int count, int32_t *buffer, int length)
+{
+	static const batch_calc_func calc = select_batch_calc();
+	FM_BATCH batch;
+	YM2203 *F2203[BATCH_CHIPS];
+	uint32_t eg_next[BATCH_CHIPS];	/* eg_cnt value when any of chip's operators may change */
+	uint32_t slot_next[4][BATCH_LANES];
+	int n, c, s;
+
+	if (count > BATCH_CHIPS)
+	{
+		/* not supported, fallback */
+		memset(buffer, 0, length * sizeof(*buffer));
+		for (n = 0; n < count; ++n)
+			YM2203UpdateOne(chips[n], buffer, length);
+		return;
+	}
+
+	memset(&batch, 0, sizeof(batch));
+	/* unused lanes are silent */
+	for (s = 0; s < 4; ++s)
+		for (c = 3 * count; c < BATCH_LANES; ++c)
+			batch.vol_out[s][c] = MAX_ATT_INDEX;
+
+	for (n = 0; n < count; ++n)
+	{
+		F2203[n] = (YM2203*)chips[n];
+		refresh_fc_eg_chip( F2203[n] );
+		const uint32_t eg_cnt = F2203[n]->OPN.eg_cnt;
+		/* registers may be changed, so perform full step first */
+		eg_next[n] = eg_cnt + 1;
+		for (c = 0; c < 3; ++c)
+		{
+			const int lane = 3 * n + c;
+			batch_load(&batch, lane, &F2203[n]->CH[c]);
+			for (s = 0; s < 4; ++s)
+				slot_next[s][lane] = eg_slot_idle(&F2203[n]->CH[c].SLOT[s]) ? eg_cnt + (1u << 31) : eg_cnt + 1;
+		}
+	}
+
+	/* samples are rendered lazily, till the first envelope change */
+	int32_t *rendered = buffer;
+	for (int32_t* buf = buffer, *lim = buffer + length; buf != lim; ++buf)
+	{
+		/* advance envelope generators */
+		for (n = 0; n < count; ++n)
+		{
+			FM_OPN *OPN = &F2203[n]->OPN;
+			OPN->eg_timer += OPN->eg_timer_add;
+			while (OPN->eg_timer >= OPN->eg_timer_overflow)
+			{
+				OPN->eg_timer -= OPN->eg_timer_overflow;
+				const uint32_t eg_cnt = ++OPN->eg_cnt;
+
+				/* other steps are known to keep operators state */
+				if (eg_cnt != eg_next[n])
+					continue;
+
+				if (rendered != buf)
+				{
+					calc(&batch, 3 * count, rendered, buf - rendered);
+					rendered = buf;
+				}
+
+				uint32_t delay = 1u << 31;
+				for (c = 0; c < 3; ++c)
+				{
+					FM_SLOT *SLOT = F2203[n]->CH[c].SLOT;
+					const int lane = 3 * n + c;
+					for (s = 0; s < 4; ++s)
+					{
+						if (slot_next[s][lane] == eg_cnt)
+						{
+							if (advance_eg_slot(eg_cnt, &SLOT[s]))
+								batch.phase[s][lane] = 0;
+							batch.vol_out[s][lane] = SLOT[s].vol_out;
+							slot_next[s][lane] = eg_slot_next(eg_cnt, &SLOT[s]);
+						}
+						const uint32_t slot_delay = slot_next[s][lane] - eg_cnt;
+						if (slot_delay < delay)
+							delay = slot_delay;
+					}
+				}
+				eg_next[n] = eg_cnt + delay;
+			}
+		}
+	}
+	if (rendered != buffer + length)
+		calc(&batch, 3 * count, rendered, buffer + length - rendered);
+
+	for (n = 0; n < count; ++n)
+		for (c = 0; c < 3; ++c)
+			batch_store(&batch, 3 * n + c, &F2203[n]->CH[c]);
+}
+
 /* ---------- reset one of chip ---------- */
 void YM2203ResetChip(void *chip)
 {
@@ -29,6 +29,12 @@ void YM2203ResetChip(void *chip);
 */
 void YM2203UpdateOne(void *chip, int32_t *buffer, int length);
 
+/*
+** update several chips at once (batched if up to 2), buffer is filled with sum of outputs
+** result is the same as of YM2203UpdateOne calls for zeroed buffer
+*/
+void YM2203UpdateBatch(void * const *chips, int count, int32_t *buffer, int length);
+
 void YM2203WriteRegs(void *chip, int reg, unsigned char val);
 
 void YM2203GetState(void *chip, uint_t *attenuations, uint_t *periods);
@@ -94,6 +94,12 @@ namespace FM
         std::transform(inBegin, inEnd, out, &ConvertToSample);
       }
 
+      //! @param inBegin,inEnd sum of @chips outputs
+      static void ConvertSamples(const YM2203SampleType* inBegin, const YM2203SampleType* inEnd, int_t chips, Sound::Sample* out)
+      {
+        std::transform(inBegin, inEnd, out, [chips](YM2203SampleType level) {return ConvertToSample(level / chips);});
+      }
+
       void ConvertState(const uint_t* attenuations, const uint_t* periods, MultiChannelState& res) const
       {
         for (uint_t idx = 0; idx != VOICES; ++idx)
@@ -160,7 +166,7 @@ namespace FM
         {
           const uint64_t clockFreq = Params->ClockFreq();
           const uint_t sndFreq = Params->SoundFreq();
-          Adapter.SetParams(clockFreq, sndFreq);
+          Adapter.SetParams(clockFreq, sndFreq, Params->Engine());
           Clock.SetFrequency(sndFreq);
         }
       }
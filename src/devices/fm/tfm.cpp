@@ -24,8 +24,14 @@ namespace TFM
   class ChipAdapter
   {
   public:
-    void SetParams(uint64_t clock, uint_t sndFreq)
+    ChipAdapter()
+      : Engine(FM::ENGINE_REFERENCE)
     {
+    }
+
+    void SetParams(uint64_t clock, uint_t sndFreq, FM::EngineType engine)
+    {
+      Engine = engine;
       if (Helper.SetNewParams(clock, sndFreq))
       {
         Chips[0] = Helper.CreateChip();
@@ -54,10 +60,19 @@ namespace TFM
     {
       Sound::Sample* const out = tgt.Allocate(count);
       FM::Details::YM2203SampleType* const outRaw = safe_ptr_cast<FM::Details::YM2203SampleType*>(out);
-      ::YM2203UpdateOne(Chips[0].get(), outRaw, count);
-      ::YM2203UpdateOne(Chips[1].get(), outRaw, count);
-      std::transform(outRaw, outRaw + count, outRaw, std::bind2nd(std::divides<FM::Details::YM2203SampleType>(), 2));
-      Helper.ConvertSamples(outRaw, outRaw + count, out);
+      if (Engine == FM::ENGINE_BATCH)
+      {
+        void* const chips[TFM::CHIPS] = {Chips[0].get(), Chips[1].get()};
+        ::YM2203UpdateBatch(chips, TFM::CHIPS, outRaw, count);
+        Helper.ConvertSamples(outRaw, outRaw + count, TFM::CHIPS, out);
+      }
+      else
+      {
+        ::YM2203UpdateOne(Chips[0].get(), outRaw, count);
+        ::YM2203UpdateOne(Chips[1].get(), outRaw, count);
+        std::transform(outRaw, outRaw + count, outRaw, std::bind2nd(std::divides<FM::Details::YM2203SampleType>(), 2));
+        Helper.ConvertSamples(outRaw, outRaw + count, out);
+      }
     }
 
     MultiChannelState GetState() const
@@ -73,6 +88,7 @@ namespace TFM
       return res;
     }
   private:
+    FM::EngineType Engine;
     FM::Details::ChipAdapterHelper Helper;
     std::array<FM::Details::ChipPtr, TFM::CHIPS> Chips;
   };
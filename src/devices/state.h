@@ -50,5 +50,14 @@ namespace Devices
     virtual ~StateSource() = default;
 
     virtual MultiChannelState GetState() const = 0;
+
+    //! @brief Get state reusing target's memory
+    //! @param lag Published states count back from the most recent one, used only by devices with states history
+    //! @note Devices with states published at render time can be polled from any thread
+    virtual void GetState(uint_t lag, MultiChannelState& state) const
+    {
+      static_cast<void>(lag);
+      state = GetState();
+    }
   };
 }
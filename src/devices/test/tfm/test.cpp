@@ -0,0 +1,168 @@
+/**
+*
+* @file
+*
+* @brief  TFM engines test
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#include <error_tools.h>
+#include <make_ptr.h>
+#include <devices/tfm.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#define FILE_TAG 5D1E3A47
+
+namespace
+{
+  class TFMParameters : public Devices::TFM::ChipParameters
+  {
+  public:
+    TFMParameters(uint_t soundFreq, Devices::FM::EngineType engine)
+      : Sound(soundFreq)
+      , Emulation(engine)
+    {
+    }
+
+    uint_t Version() const override
+    {
+      return 1;
+    }
+
+    uint64_t ClockFreq() const override
+    {
+      return 3500000;
+    }
+
+    uint_t SoundFreq() const override
+    {
+      return Sound;
+    }
+
+    Devices::FM::EngineType Engine() const override
+    {
+      return Emulation;
+    }
+  private:
+    const uint_t Sound;
+    const Devices::FM::EngineType Emulation;
+  };
+
+  class Collector : public Sound::Receiver
+  {
+  public:
+    void ApplyData(Sound::Chunk::Ptr data) override
+    {
+      Samples.insert(Samples.end(), data->begin(), data->end());
+    }
+
+    void Flush() override
+    {
+    }
+
+    std::vector<Sound::Sample> Samples;
+  };
+
+  class RandomGenerator
+  {
+  public:
+    explicit RandomGenerator(uint_t seed)
+      : Seed(seed)
+    {
+    }
+
+    uint_t Get(uint_t limit)
+    {
+      Seed = Seed * 1103515245 + 12345;
+      return (Seed >> 16) % limit;
+    }
+  private:
+    uint_t Seed;
+  };
+
+  //random writes to operators, channels and timers/mode registers with periodic key on/off
+  void FillRandomFrame(RandomGenerator& rnd, uint_t frame, Devices::TFM::Registers& regs)
+  {
+    using namespace Devices::TFM;
+    regs.clear();
+    for (uint_t writes = rnd.Get(16); writes; --writes)
+    {
+      const uint_t chip = rnd.Get(CHIPS);
+      const uint_t reg = 0x20 + rnd.Get(0xb7 - 0x20);
+      if (reg != 0x28)
+      {
+        regs.push_back(Register(chip, reg, rnd.Get(256)));
+      }
+    }
+    if (0 == frame % 3)
+    {
+      const uint_t chip = rnd.Get(CHIPS);
+      regs.push_back(Register(chip, 0x28, (rnd.Get(16) << 4) | rnd.Get(3)));
+    }
+  }
+
+  std::vector<Sound::Sample> Render(uint_t soundFreq, Devices::FM::EngineType engine, uint_t seed)
+  {
+    using namespace Devices::TFM;
+    const std::shared_ptr<Collector> target = std::make_shared<Collector>();
+    const Chip::Ptr chip = Devices::TFM::CreateChip(MakePtr<TFMParameters>(soundFreq, engine), target);
+    RandomGenerator rnd(seed);
+    DataChunk chunk;
+    const Stamp period(20000);
+    for (uint_t frame = 0; frame != 250; ++frame)
+    {
+      FillRandomFrame(rnd, frame, chunk.Data);
+      chunk.TimeStamp += period;
+      chip->RenderData(chunk);
+    }
+    return std::move(target->Samples);
+  }
+
+  void TestEngines(uint_t soundFreq, uint_t seed)
+  {
+    std::cout << "Checking batch engine at " << soundFreq << "Hz with seed " << seed << ":";
+    const std::vector<Sound::Sample> ref = Render(soundFreq, Devices::FM::ENGINE_REFERENCE, seed);
+    const std::vector<Sound::Sample> batch = Render(soundFreq, Devices::FM::ENGINE_BATCH, seed);
+    if (ref.size() != batch.size())
+    {
+      std::cout << " failed\n";
+      throw MakeFormattedError(THIS_LINE, "Rendered %1% samples while expected %2%", batch.size(), ref.size());
+    }
+    for (std::size_t pos = 0; pos != ref.size(); ++pos)
+    {
+      if (!(ref[pos] == batch[pos]))
+      {
+        std::cout << " failed\n";
+        throw MakeFormattedError(THIS_LINE, "Value at %5%=<%1%,%2%> while expected=<%3%,%4%>",
+          batch[pos].Left(), batch[pos].Right(), ref[pos].Left(), ref[pos].Right(), pos);
+      }
+    }
+    std::cout << " passed\n";
+  }
+}
+
+int main()
+{
+  try
+  {
+    const uint_t FREQS[] = {8000, 22050, 44100, 96000};
+    for (const auto freq : FREQS)
+    {
+      for (uint_t seed = 1; seed != 4; ++seed)
+      {
+        TestEngines(freq, seed);
+      }
+    }
+    std::cout << " Succeed!" << std::endl;
+    return 0;
+  }
+  catch (const Error& e)
+  {
+    std::cerr << e.ToString();
+    return 1;
+  }
+}
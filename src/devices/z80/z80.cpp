@@ -23,6 +23,77 @@ namespace Devices
 {
 namespace Z80
 {
+  class ClockSource
+  {
+  public:
+    ClockSource()
+      : ClockFreq()
+      , IntDuration()
+    {
+    }
+
+    void Reset()
+    {
+      ClockFreq = 0;
+      IntDuration = 0;
+      Clock.Reset();
+    }
+
+    void SetParameters(uint64_t clockFreq, uint_t intDuration)
+    {
+      if (clockFreq != ClockFreq || intDuration != IntDuration)
+      {
+        ClockFreq = clockFreq;
+        IntDuration = intDuration;
+        Clock.SetFrequency(ClockFreq);
+      }
+    }
+
+    void AdvanceTick(uint_t delta)
+    {
+      Clock.AdvanceTick(delta);
+    }
+
+    //account opcodes executed so far by z80ex_run before accessing timestamped devices
+    const Oscillator& Synchronize(Z80EX_CONTEXT* cpu)
+    {
+      Clock.AdvanceTick(z80ex_run_flush(cpu));
+      return Clock;
+    }
+
+    void Seek(const Stamp time)
+    {
+      Clock.Reset();
+      const uint64_t tick = Clock.GetTickAtTime(time);
+      Clock.SetFrequency(ClockFreq);
+      Clock.AdvanceTick(tick);
+    }
+
+    uint64_t GetCurrentTick() const
+    {
+      return Clock.GetCurrentTick();
+    }
+
+    Stamp GetCurrentTime() const
+    {
+      return Clock.GetCurrentTime();
+    }
+
+    uint64_t GetTickAtTime(const Stamp till) const
+    {
+      return Clock.GetTickAtTime(till);
+    }
+
+    uint64_t GetIntEnd() const
+    {
+      return Clock.GetCurrentTick() + IntDuration;
+    }
+  private:
+    uint64_t ClockFreq;
+    uint_t IntDuration;
+    Oscillator Clock;
+  };
+
   class IOBus
   {
   public:
@@ -34,7 +105,7 @@ namespace Z80
   class ExtendedIOBus : public IOBus
   {
   public:
-    ExtendedIOBus(const Oscillator& clock, ChipIO::Ptr memory, ChipIO::Ptr ports)
+    ExtendedIOBus(ClockSource& clock, ChipIO::Ptr memory, ChipIO::Ptr ports)
       : Clock(clock)
       , Memory(std::move(memory))
       , Ports(std::move(ports))
@@ -56,10 +127,10 @@ namespace Z80
       return self->Read(*self->Memory, addr);
     }
 
-    static void WriteByte(Z80EX_CONTEXT* /*cpu*/, Z80EX_WORD addr, Z80EX_BYTE value, void* userData)
+    static void WriteByte(Z80EX_CONTEXT* cpu, Z80EX_WORD addr, Z80EX_BYTE value, void* userData)
     {
       const ExtendedIOBus* const self = static_cast<const ExtendedIOBus*>(userData);
-      return self->Write(*self->Memory, addr, value);
+      return self->Write(cpu, *self->Memory, addr, value);
     }
 
     static Z80EX_BYTE InByte(Z80EX_CONTEXT* /*cpu*/, Z80EX_WORD port, void* userData)
@@ -68,10 +139,10 @@ namespace Z80
       return self->Read(*self->Ports, port);
     }
 
-    static void OutByte(Z80EX_CONTEXT* /*cpu*/, Z80EX_WORD port, Z80EX_BYTE value, void* userData)
+    static void OutByte(Z80EX_CONTEXT* cpu, Z80EX_WORD port, Z80EX_BYTE value, void* userData)
     {
       const ExtendedIOBus* const self = static_cast<const ExtendedIOBus*>(userData);
-      return self->Write(*self->Ports, port, value);
+      return self->Write(cpu, *self->Ports, port, value);
     }
 
     static Z80EX_BYTE IntRead(Z80EX_CONTEXT* /*cpu*/, void* /*userData*/)
@@ -84,12 +155,12 @@ namespace Z80
       return io.Read(addr);
     }
 
-    void Write(ChipIO& io, Z80EX_WORD addr, Z80EX_BYTE value) const
+    void Write(Z80EX_CONTEXT* cpu, ChipIO& io, Z80EX_WORD addr, Z80EX_BYTE value) const
     {
-      return io.Write(Clock, addr, value);
+      return io.Write(Clock.Synchronize(cpu), addr, value);
     }
   private:
-    const Oscillator& Clock;
+    ClockSource& Clock;
     const ChipIO::Ptr Memory;
     const ChipIO::Ptr Ports;
   };
@@ -97,7 +168,7 @@ namespace Z80
   class SimpleIOBus : public IOBus
   {
   public:
-    SimpleIOBus(const Oscillator& clock, Dump memory, ChipIO::Ptr ports)
+    SimpleIOBus(ClockSource& clock, Dump memory, ChipIO::Ptr ports)
       : Clock(clock)
       , Memory(std::move(memory))
       , RawMemory(&Memory.front())
@@ -111,10 +182,16 @@ namespace Z80
       const bool isLimited = Memory.size() < 65536;
       const z80ex_mread_cb read = isLimited ? &ReadByteLimited : &ReadByteUnlimited;
       const z80ex_mwrite_cb write = isLimited ? &WriteByteLimited : &WriteByteUnlimited;
-      return std::shared_ptr<Z80EX_CONTEXT>(
+      const std::shared_ptr<Z80EX_CONTEXT> result(
         z80ex_create(read, self, write, self,
                      &InByte, self, &OutByte, self,
                      &IntRead, self), std::ptr_fun(&z80ex_destroy));
+      if (!isLimited)
+      {
+        //whole address space is backed, so access it inline without callbacks
+        z80ex_set_memory(result.get(), RawMemory);
+      }
+      return result;
     }
   private:
     static Z80EX_BYTE ReadByteUnlimited(Z80EX_CONTEXT* /*cpu*/, Z80EX_WORD addr, int /*m1_state*/, void* userData)
@@ -152,10 +229,10 @@ namespace Z80
       return self->Ports->Read(port);
     }
 
-    static void OutByte(Z80EX_CONTEXT* /*cpu*/, Z80EX_WORD port, Z80EX_BYTE value, void* userData)
+    static void OutByte(Z80EX_CONTEXT* cpu, Z80EX_WORD port, Z80EX_BYTE value, void* userData)
     {
       const SimpleIOBus* const self = static_cast<const SimpleIOBus*>(userData);
-      return self->Ports->Write(self->Clock, port, value);
+      return self->Ports->Write(self->Clock.Synchronize(cpu), port, value);
     }
 
     static Z80EX_BYTE IntRead(Z80EX_CONTEXT* /*cpu*/, void* /*userData*/)
@@ -163,87 +240,18 @@ namespace Z80
       return 0xff;
     }
   private:
-    const Oscillator& Clock;
+    ClockSource& Clock;
     Dump Memory;
     uint8_t* const RawMemory;
     const ChipIO::Ptr Ports;
   };
 
-  class ClockSource
-  {
-  public:
-    ClockSource()
-      : ClockFreq()
-      , IntDuration()
-    {
-    }
-
-    void Reset()
-    {
-      ClockFreq = 0;
-      IntDuration = 0;
-      Clock.Reset();
-    }
-
-    void SetParameters(uint64_t clockFreq, uint_t intDuration)
-    {
-      if (clockFreq != ClockFreq || intDuration != IntDuration)
-      {
-        ClockFreq = clockFreq;
-        IntDuration = intDuration;
-        Clock.SetFrequency(ClockFreq);
-      }
-    }
-
-    void AdvanceTick(uint_t delta)
-    {
-      Clock.AdvanceTick(delta);
-    }
-
-    void Seek(const Stamp time)
-    {
-      Clock.Reset();
-      const uint64_t tick = Clock.GetTickAtTime(time);
-      Clock.SetFrequency(ClockFreq);
-      Clock.AdvanceTick(tick);
-    }
-
-    const Oscillator& GetOscillator() const
-    {
-      return Clock;
-    }
-
-    uint64_t GetCurrentTick() const
-    {
-      return Clock.GetCurrentTick();
-    }
-
-    Stamp GetCurrentTime() const
-    {
-      return Clock.GetCurrentTime();
-    }
-
-    uint64_t GetTickAtTime(const Stamp till) const
-    {
-      return Clock.GetTickAtTime(till);
-    }
-
-    uint64_t GetIntEnd() const
-    {
-      return Clock.GetCurrentTick() + IntDuration;
-    }
-  private:
-    uint64_t ClockFreq;
-    uint_t IntDuration;
-    Oscillator Clock;
-  };
-
   class Z80Chip : public Chip
   {
   public:
     Z80Chip(ChipParameters::Ptr params, ChipIO::Ptr memory, ChipIO::Ptr ports)
       : Params(params)
-      , Bus(new ExtendedIOBus(Clock.GetOscillator(), memory, ports))
+      , Bus(new ExtendedIOBus(Clock, memory, ports))
       , Context(Bus->ConnectCPU())
     {
       Z80Chip::Reset();
@@ -251,7 +259,7 @@ namespace Z80
 
     Z80Chip(ChipParameters::Ptr params, const Dump& memory, ChipIO::Ptr ports)
       : Params(params)
-      , Bus(new SimpleIOBus(Clock.GetOscillator(), memory, ports))
+      , Bus(new SimpleIOBus(Clock, memory, ports))
       , Context(Bus->ConnectCPU())
     {
       Z80Chip::Reset();
@@ -282,9 +290,10 @@ namespace Z80
     void Execute(const Stamp& till) override
     {
       const uint64_t endTick = Clock.GetTickAtTime(till);
-      while (Clock.GetCurrentTick() < endTick)
+      const uint64_t curTick = Clock.GetCurrentTick();
+      if (curTick < endTick)
       {
-        Clock.AdvanceTick(z80ex_step(Context.get()));
+        Clock.AdvanceTick(z80ex_run(Context.get(), endTick - curTick));
       }
     }
 
@@ -183,35 +183,6 @@ namespace Chiptune
     static_assert(sizeof(RawSample) == 2, "Invalid layout");
     static_assert(sizeof(RawOrnament) == 2, "Invalid layout");
 
-    class StubBuilder : public Builder
-    {
-    public:
-      MetaBuilder& GetMetaBuilder() override
-      {
-        return GetStubMetaBuilder();
-      }
-      void SetInitialTempo(uint_t /*tempo*/) override {}
-      void SetSample(uint_t /*index*/, Sample /*sample*/) override {}
-      void SetOrnament(uint_t /*index*/, Ornament /*ornament*/) override {}
-      void SetPositions(Positions /*positions*/) override {}
-      PatternBuilder& StartPattern(uint_t /*index*/) override
-      {
-        return GetStubPatternBuilder();
-      }
-      void StartChannel(uint_t /*index*/) override {}
-      void SetRest() override {}
-      void SetNote(uint_t /*note*/) override {}
-      void SetSample(uint_t /*sample*/) override {}
-      void SetOrnament(uint_t /*ornament*/) override {}
-      void SetVolume(uint_t /*vol*/) override {}
-      void SetGlissade(int_t /*val*/) override {}
-      void SetNoteGliss(int_t /*val*/, uint_t /*limit*/) override {}
-      void SetNoGliss() override {}
-      void SetEnvelope(uint_t /*type*/, uint_t /*value*/) override {}
-      void SetNoEnvelope() override {}
-      void SetNoiseAddon(int_t /*val*/) override {}
-    };
-
     class StatisticCollectingBuilder : public Builder
     {
     public:
@@ -81,6 +81,37 @@ namespace Formats
       };
 
       Formats::Chiptune::Container::Ptr Parse(const Binary::Container& data, Builder& target);
+
+      //! Builder ignoring all the data, base for builders interested in some part of it
+      class StubBuilder : public Builder
+      {
+      public:
+        MetaBuilder& GetMetaBuilder() override
+        {
+          return GetStubMetaBuilder();
+        }
+        void SetInitialTempo(uint_t /*tempo*/) override {}
+        void SetSample(uint_t /*index*/, Sample /*sample*/) override {}
+        void SetOrnament(uint_t /*index*/, Ornament /*ornament*/) override {}
+        void SetPositions(Positions /*positions*/) override {}
+        PatternBuilder& StartPattern(uint_t /*index*/) override
+        {
+          return GetStubPatternBuilder();
+        }
+        void StartChannel(uint_t /*index*/) override {}
+        void SetRest() override {}
+        void SetNote(uint_t /*note*/) override {}
+        void SetSample(uint_t /*sample*/) override {}
+        void SetOrnament(uint_t /*ornament*/) override {}
+        void SetVolume(uint_t /*vol*/) override {}
+        void SetGlissade(int_t /*val*/) override {}
+        void SetNoteGliss(int_t /*val*/, uint_t /*limit*/) override {}
+        void SetNoGliss() override {}
+        void SetEnvelope(uint_t /*type*/, uint_t /*value*/) override {}
+        void SetNoEnvelope() override {}
+        void SetNoiseAddon(int_t /*val*/) override {}
+      };
+
       Builder& GetStubBuilder();
     }
 
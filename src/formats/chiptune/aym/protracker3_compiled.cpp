@@ -214,41 +214,6 @@ namespace Chiptune
     static_assert(sizeof(RawSample::Line) == 4, "Invalid layout");
     static_assert(sizeof(RawOrnament) == 2, "Invalid layout");
 
-    class StubBuilder : public Builder
-    {
-    public:
-      MetaBuilder& GetMetaBuilder() override
-      {
-        return GetStubMetaBuilder();
-      }
-      void SetVersion(uint_t /*version*/) override {}
-      void SetNoteTable(NoteTable /*table*/) override {}
-      void SetMode(uint_t /*mode*/) override {}
-      void SetInitialTempo(uint_t /*tempo*/) override {}
-      void SetSample(uint_t /*index*/, Sample /*sample*/) override {}
-      void SetOrnament(uint_t /*index*/, Ornament /*ornament*/) override {}
-      void SetPositions(Positions /*positions*/) override {}
-      PatternBuilder& StartPattern(uint_t /*index*/) override
-      {
-        return GetStubPatternBuilder();
-      }
-      void StartChannel(uint_t /*index*/) override {}
-      void SetRest() override {}
-      void SetNote(uint_t /*note*/) override {}
-      void SetSample(uint_t /*sample*/) override {}
-      void SetOrnament(uint_t /*ornament*/) override {}
-      void SetVolume(uint_t /*vol*/) override {}
-      void SetGlissade(uint_t /*period*/, int_t /*val*/) override {}
-      void SetNoteGliss(uint_t /*period*/, int_t /*val*/, uint_t /*limit*/) override {}
-      void SetSampleOffset(uint_t /*offset*/) override {}
-      void SetOrnamentOffset(uint_t /*offset*/) override {}
-      void SetVibrate(uint_t /*ontime*/, uint_t /*offtime*/) override {}
-      void SetEnvelopeSlide(uint_t /*period*/, int_t /*val*/) override {}
-      void SetEnvelope(uint_t /*type*/, uint_t /*value*/) override {}
-      void SetNoEnvelope() override {}
-      void SetNoiseBase(uint_t /*val*/) override {}
-    };
-
     class RangesMap
     {
     public:
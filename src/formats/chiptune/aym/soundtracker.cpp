@@ -524,30 +524,6 @@ namespace Chiptune
 
   namespace SoundTracker
   {
-    class StubBuilder : public Builder
-    {
-    public:
-      MetaBuilder& GetMetaBuilder() override
-      {
-        return GetStubMetaBuilder();
-      }
-      void SetInitialTempo(uint_t /*tempo*/) override {}
-      void SetSample(uint_t /*index*/, Sample /*sample*/) override {}
-      void SetOrnament(uint_t /*index*/, Ornament /*ornament*/) override {}
-      void SetPositions(Positions /*positions*/) override {}
-      PatternBuilder& StartPattern(uint_t /*index*/) override
-      {
-        return GetStubPatternBuilder();
-      }
-      void StartChannel(uint_t /*index*/) override {}
-      void SetRest() override {}
-      void SetNote(uint_t /*note*/) override {}
-      void SetSample(uint_t /*sample*/) override {}
-      void SetOrnament(uint_t /*ornament*/) override {}
-      void SetEnvelope(uint_t /*type*/, uint_t /*value*/) override {}
-      void SetNoEnvelope() override {}
-    };
-
     Builder& GetStubBuilder()
     {
       static StubBuilder stub;
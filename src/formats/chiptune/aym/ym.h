@@ -47,6 +47,8 @@ namespace Formats
         virtual void SetProgram(const String& program) = 0;
         virtual void SetEditor(const String& editor) = 0;
 
+        //called before frames data
+        virtual void SetFrames(std::size_t count) = 0;
         virtual void AddData(const Dump& registers) = 0;
       };
 
@@ -58,6 +60,9 @@ namespace Formats
         typedef std::shared_ptr<const Decoder> Ptr;
 
         virtual Formats::Chiptune::Container::Ptr Parse(const Binary::Container& data, Builder& target) const = 0;
+        //! Same as Parse, but frames data may be skipped with only its size passed via Builder::SetFrames.
+        //! Packed data is decoded only if required
+        virtual Formats::Chiptune::Container::Ptr ParseHeader(const Binary::Container& data, Builder& target) const = 0;
       };
 
       Decoder::Ptr CreatePackedYMDecoder();
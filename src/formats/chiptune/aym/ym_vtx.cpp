@@ -23,6 +23,7 @@
 #include <formats/packed/lha_supp.h>
 #include <math/numeric.h>
 //std includes
+#include <algorithm>
 #include <array>
 #include <cstring>
 //text includes
@@ -230,6 +231,7 @@ namespace Chiptune
       void SetProgram(const String& /*program*/) override {}
       void SetEditor(const String& /*editor*/) override {}
 
+      void SetFrames(std::size_t /*count*/) override {}
       void AddData(const Dump& /*registers*/) override {}
     };
 
@@ -248,9 +250,11 @@ namespace Chiptune
     void ParseTransponedMatrix(const uint8_t* data, std::size_t size, std::size_t rows, std::size_t columns, Builder& target)
     {
       Require(rows != 0);
+      target.SetFrames(rows);
+      Dump registers(columns);
       for (std::size_t row = 0; row != rows; ++row)
       {
-        Dump registers(columns);
+        std::fill(registers.begin(), registers.end(), 0);
         for (std::size_t col = 0, cursor = row; col != columns && cursor < size; ++col, cursor += rows)
         {
           registers[col] = data[cursor];
@@ -262,27 +266,45 @@ namespace Chiptune
     void ParseMatrix(const uint8_t* data, std::size_t size, std::size_t rows, std::size_t columns, Builder& target)
     {
       Require(rows != 0);
+      target.SetFrames(rows);
+      Dump registers(columns);
       const uint8_t* cursor = data, *limit = data + size;
       for (std::size_t row = 0; row != rows; ++row)
       {
         const uint8_t* const nextCursor = cursor + columns;
         if (nextCursor <= limit)
         {
-          const Dump registers(cursor, nextCursor);
-          target.AddData(registers);
+          std::copy(cursor, nextCursor, registers.begin());
         }
         else
         {
-          Dump registers = cursor < limit
-              ? Dump(cursor, limit)
-              : Dump();
-          registers.resize(columns);
-          target.AddData(registers);
+          const auto rest = std::copy(cursor, std::max(cursor, limit), registers.begin());
+          std::fill(rest, registers.end(), 0);
         }
+        target.AddData(registers);
         cursor = nextCursor;
       }
     }
     
+    //@return nullptr if not supported
+    const Ver5::RawHeader* ParseVer5Header(Binary::InputStream& stream, Builder& target)
+    {
+      const Ver5::RawHeader& header = stream.ReadField<Ver5::RawHeader>();
+      if (0 != header.SamplesCount)
+      {
+        Dbg("Digital samples are not supported");
+        return nullptr;
+      }
+      target.SetVersion(String(header.Signature, header.Signature + sizeof(IdentifierType)));
+      target.SetClockrate(fromBE(header.Clockrate));
+      target.SetIntFreq(fromBE(header.IntFreq));
+      target.SetLoop(fromBE(header.Loop));
+      target.SetTitle(FromStdString(stream.ReadCString(MAX_STRING_SIZE)));
+      target.SetAuthor(FromStdString(stream.ReadCString(MAX_STRING_SIZE)));
+      target.SetComment(FromStdString(stream.ReadCString(MAX_STRING_SIZE)));
+      return &header;
+    }
+
     Formats::Chiptune::Container::Ptr ParseUnpacked(const Binary::Container& rawData, Builder& target)
     {
       const void* const data = rawData.Start();
@@ -316,20 +338,12 @@ namespace Chiptune
               || Ver6::FastCheck(data, size))
         {
           Binary::InputStream stream(rawData);
-          const Ver5::RawHeader& header = stream.ReadField<Ver5::RawHeader>();
-          if (0 != header.SamplesCount)
+          const Ver5::RawHeader* const headerPtr = ParseVer5Header(stream, target);
+          if (!headerPtr)
           {
-            Dbg("Digital samples are not supported");
             return Formats::Chiptune::Container::Ptr();
           }
-          target.SetVersion(String(header.Signature, header.Signature + sizeof(IdentifierType)));
-          target.SetClockrate(fromBE(header.Clockrate));
-          target.SetIntFreq(fromBE(header.IntFreq));
-          target.SetLoop(fromBE(header.Loop));
-          target.SetTitle(FromStdString(stream.ReadCString(MAX_STRING_SIZE)));
-          target.SetAuthor(FromStdString(stream.ReadCString(MAX_STRING_SIZE)));
-          target.SetComment(FromStdString(stream.ReadCString(MAX_STRING_SIZE)));
-
+          const Ver5::RawHeader& header = *headerPtr;
           const std::size_t dumpOffset = stream.GetPosition();
           const std::size_t dumpSize = size - sizeof(Ver5::Footer) - dumpOffset;
           const std::size_t lines = fromBE(header.Frames);
@@ -367,7 +381,43 @@ namespace Chiptune
       "'!|'b"
     );
       
-    Formats::Chiptune::Container::Ptr ParsePacked(const Binary::Container& rawData, Builder& target)
+    //enough for the biggest header with all the strings
+    const std::size_t MAX_HEADER_SIZE = sizeof(Ver5::RawHeader) + 3 * (MAX_STRING_SIZE + 1);
+
+    //Gets all but frames data, which is only counted using total size for old versions.
+    //@return false if header is not enough, e.g. for loop stored after frames data
+    bool ParseUnpackedHeader(const Binary::Container& header, std::size_t size, Builder& target)
+    {
+      const void* const data = header.Start();
+      try
+      {
+        if (Ver2::FastCheck(data, size)
+         || Ver3::FastCheck(data, size))
+        {
+          const IdentifierType& type = *static_cast<const IdentifierType*>(data);
+          target.SetVersion(String(type.begin(), type.end()));
+          target.SetFrames((size - sizeof(IdentifierType)) / sizeof(RegistersDump));
+          return true;
+        }
+        else if (Ver5::FastCheck(data, size)
+              || Ver6::FastCheck(data, size))
+        {
+          Binary::InputStream stream(header);
+          if (const Ver5::RawHeader* hdr = ParseVer5Header(stream, target))
+          {
+            target.SetFrames(fromBE(hdr->Frames));
+            return true;
+          }
+        }
+      }
+      catch (const std::exception&)
+      {
+        Dbg("Failed to parse header");
+      }
+      return false;
+    }
+
+    Formats::Chiptune::Container::Ptr ParsePacked(const Binary::Container& rawData, Builder& target, bool headerOnly)
     {
       const void* const data = rawData.Start();
       const std::size_t size = rawData.Size();
@@ -380,11 +430,21 @@ namespace Chiptune
       const std::size_t packedSize = fromLE(hdr.PackedSize);
       const Binary::Container::Ptr packed = rawData.GetSubcontainer(packedOffset, packedSize);
       const std::size_t unpackedSize = fromLE(hdr.OriginalSize);
-      if (const Formats::Packed::Container::Ptr unpacked = Formats::Packed::Lha::DecodeRawData(*packed, FromCharArray(hdr.Method), unpackedSize))
+      const std::string method = FromCharArray(hdr.Method);
+      const Binary::Container::Ptr subData = rawData.GetSubcontainer(0, packedOffset + packedSize + Compressed::FOOTER_SIZE);
+      if (headerOnly)
+      {
+        const std::size_t headerSize = std::min(unpackedSize, MAX_HEADER_SIZE);
+        const Formats::Packed::Container::Ptr header = Formats::Packed::Lha::DecodeRawDataAtLeast(*packed, method, headerSize);
+        if (header && ParseUnpackedHeader(*header, unpackedSize, target))
+        {
+          return CreateCalculatingCrcContainer(subData, packedOffset, packedSize);
+        }
+      }
+      if (const Formats::Packed::Container::Ptr unpacked = Formats::Packed::Lha::DecodeRawData(*packed, method, unpackedSize))
       {
         if (ParseUnpacked(*unpacked, target))
         {
-          const Binary::Container::Ptr subData = rawData.GetSubcontainer(0, packedOffset + packedSize + Compressed::FOOTER_SIZE);
           return CreateCalculatingCrcContainer(subData, packedOffset, packedSize);
         }
       }
@@ -440,6 +500,11 @@ namespace Chiptune
       {
         return ParseUnpacked(data, target);
       }
+
+      Formats::Chiptune::Container::Ptr ParseHeader(const Binary::Container& data, Builder& target) const override
+      {
+        return ParseUnpacked(data, target);
+      }
     private:
       const Binary::Format::Ptr Format;
     };
@@ -474,12 +539,17 @@ namespace Chiptune
           return Formats::Chiptune::Container::Ptr();
         }
         Builder& stub = GetStubBuilder();
-        return ParsePacked(rawData, stub);
+        return ParsePacked(rawData, stub, false);
       }
 
       Formats::Chiptune::Container::Ptr Parse(const Binary::Container& data, Builder& target) const override
       {
-        return ParsePacked(data, target);
+        return ParsePacked(data, target, false);
+      }
+
+      Formats::Chiptune::Container::Ptr ParseHeader(const Binary::Container& data, Builder& target) const override
+      {
+        return ParsePacked(data, target, true);
       }
     private:
       const Binary::Format::Ptr Format;
@@ -674,6 +744,12 @@ namespace Chiptune
       {
         return ParseVTX(data, target);
       }
+
+      //size of packed data is known only after decoding
+      Formats::Chiptune::Container::Ptr ParseHeader(const Binary::Container& data, Builder& target) const override
+      {
+        return ParseVTX(data, target);
+      }
     private:
       const Binary::Format::Ptr Format;
     };
@@ -52,5 +52,88 @@ namespace Formats
       //! @invariant Exactly Container::PackedSize first bytes is used from rawData
       virtual Container::Ptr Decode(const Binary::Container& rawData) const = 0;
     };
+
+    //! @brief Resources limit for speculative decoding of data found at arbitrary offsets
+    //! @note Installed for the creating thread during object's lifetime. Applied only to decodings performed
+    //!       via DecodeBudget::Decode, so direct Decoder::Decode calls are not limited.
+    //!       Only resources wasted by unsuccessful decodings are accounted, so after budget is exhausted all the
+    //!       subsequent decodings are rejected without starting until the next accounting window
+    class DecodeBudget
+    {
+    public:
+      //! @param maxOutput Size of data decoded by unsuccessful decodings in bytes per window, 0 for unlimited
+      //! @param maxWork Decoding steps (decoder-specific, e.g. processed tokens or blocks) performed
+      //!                by unsuccessful decodings per window, 0 for unlimited
+      DecodeBudget(uint64_t maxOutput, uint64_t maxWork);
+      ~DecodeBudget();
+
+      DecodeBudget(const DecodeBudget&) = delete;
+      DecodeBudget& operator = (const DecodeBudget&) = delete;
+
+      struct Statistic
+      {
+        Statistic()
+          : Completed()
+          , Failed()
+          , Aborted()
+          , WastedOutput()
+          , WastedWork()
+        {
+        }
+
+        //! Successfully decoded
+        std::size_t Completed;
+        //! Rejected by decoder itself
+        std::size_t Failed;
+        //! Stopped or not started due to exhausted budget
+        std::size_t Aborted;
+        //! Resources spent by unsuccessful decodings
+        uint64_t WastedOutput;
+        uint64_t WastedWork;
+      };
+
+      //! @return Budget installed for the current thread or null
+      static DecodeBudget* Installed();
+
+      //! @brief Start new accounting window, e.g. for the next part of scanned data
+      //! @note Statistic is accumulated for the whole lifetime
+      void StartWindow();
+
+      //! @brief Perform limited decoding with accounting
+      Container::Ptr Decode(const Decoder& decoder, const Binary::Container& rawData);
+
+      const Statistic& GetStatistic() const
+      {
+        return Stat;
+      }
+
+      //! @return Budget of the decoding in progress for the current thread or null if not limited
+      static DecodeBudget* Current();
+
+      //! @brief Cheap pre-validation of decoding parameters known in advance
+      //! @return false if decoding should not be started
+      bool Accept(std::size_t expectedOutput);
+
+      //! @param output Total decoded size of current decoding at the moment
+      //! @param work Total steps of current decoding performed at the moment
+      //! @return false if decoding should be aborted
+      bool Check(std::size_t output, std::size_t work);
+    private:
+      bool IsExhausted() const;
+      bool Exhaust();
+    private:
+      const uint64_t MaxOutput;
+      const uint64_t MaxWork;
+      DecodeBudget* const Previous;
+      bool Decoding;
+      bool Exhausted;
+      //last reported by current decoding
+      std::size_t Output;
+      std::size_t Work;
+      //wasted in current window
+      uint64_t WindowOutput;
+      uint64_t WindowWork;
+      Statistic Stat;
+    };
   }
 }
@@ -211,6 +211,10 @@ namespace Packed
         //assume that first byte always exists due to header format
         while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           const uint_t data = Stream.GetByte();
           if (data != Header.Marker)
           {
@@ -242,6 +246,7 @@ namespace Packed
       ReverseByteStream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace CharPres
 
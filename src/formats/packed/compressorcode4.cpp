@@ -272,6 +272,10 @@ namespace Packed
           //assume that first byte always exists due to header format
           while (chunksCount-- && Decoded.size() < MAX_DECODED_SIZE)
           {
+            if (!Limiter.Continue(Decoded.size()))
+            {
+              return false;
+            }
             const uint8_t data = *source;
             const uint_t count = (data >> 5);
             if (24 == (data & 24))
@@ -401,6 +405,7 @@ namespace Packed
       const uint_t ChunksCount;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
 
     template<class Version>
@@ -444,7 +449,6 @@ namespace Packed
     public:
       Bitstream(const uint8_t* data, std::size_t size)
         : Source(data, size)
-        , Bits(), Mask(0)
       {
       }
 
@@ -455,22 +459,12 @@ namespace Packed
 
       uint_t GetBit()
       {
-        if (!(Mask >>= 1))
-        {
-          Bits = *Source;
-          Mask = 0x80;
-        }
-        return Bits & Mask ? 1 : 0;
+        return Bits.GetBit([this]() {return *Source;});
       }
 
       uint_t GetBits(uint_t count)
       {
-        uint_t result = 0;
-        while (count--)
-        {
-          result = 2 * result | GetBit();
-        }
-        return result;
+        return Bits.Get(count, [this]() {return *Source;});
       }
 
       uint_t GetIndex()
@@ -486,8 +480,7 @@ namespace Packed
       }
     private:
       StreamAdapter Source;
-      uint_t Bits;
-      uint_t Mask;
+      BitsBuffer<8> Bits;
     };
 
     template<>
@@ -24,10 +24,7 @@
 #include <math/numeric.h>
 //std includes
 #include <algorithm>
-#include <iterator>
 #include <numeric>
-//boost includes
-#include <boost/bind.hpp>
 //text includes
 #include <formats/text/packed.h>
 
@@ -216,28 +213,18 @@ namespace Packed
     {
     public:
       Bitstream(const uint8_t* data, std::size_t size)
-        : Data(data), Pos(Data + size), Bits(), Mask(0)
+        : Data(data), Pos(Data + size)
       {
       }
 
       uint_t GetBit()
       {
-        if (!(Mask >>= 1))
-        {
-          Bits = GetByte();
-          Mask = 0x80;
-        }
-        return Bits & Mask ? 1 : 0;
+        return Bits.GetBit([this]() {return GetByte();});
       }
 
       uint_t GetBits(uint_t count)
       {
-        uint_t result = 0;
-        while (count--)
-        {
-          result = 2 * result | GetBit();
-        }
-        return result;
+        return Bits.Get(count, [this]() {return GetByte();});
       }
 
       uint8_t Get8Bits()
@@ -253,8 +240,7 @@ namespace Packed
     private:
       const uint8_t* const Data;
       const uint8_t* Pos;
-      uint_t Bits;
-      uint_t Mask;
+      BitsBuffer<8> Bits;
     };
 
     class Container
@@ -321,8 +307,6 @@ namespace Packed
         : IsValid(container.FastCheck())
         , Header(container.GetHeader())
         , Stream(Header.Data, fromLE(Header.SizeOfPacked))
-        , Result(new Dump())
-        , Decoded(*Result)
       {
         if (IsValid)
         {
@@ -333,28 +317,36 @@ namespace Packed
       std::unique_ptr<Dump> GetResult()
       {
         return IsValid
-          ? std::move(Result)
+          ? Decoded.CaptureResult()
           : std::unique_ptr<Dump>();
       }
     private:
       bool DecodeData()
       {
         const uint_t unpackedSize = fromLE(Header.LastOfDepacked) - fromLE(Header.DepackedLimit);
-        Decoded.reserve(unpackedSize);
+        if (!Limiter.Accept(unpackedSize))
+        {
+          return false;
+        }
+        Decoded.Reserve(unpackedSize);
         try
         {
-          while (Decoded.size() < unpackedSize)
+          while (Decoded.GetSize() < unpackedSize)
           {
+            if (!Limiter.Continue(Decoded.GetSize()))
+            {
+              return false;
+            }
             if (!Stream.GetBit())
             {
-              Decoded.push_back(Stream.Get8Bits());
+              Decoded.Add(Stream.Get8Bits());
             }
             else if (!DecodeCmd())
             {
               return false;
             }
           }
-          std::reverse(Decoded.begin(), Decoded.end());
+          Decoded.Reverse();
           return true;
         }
         catch (const std::exception&)
@@ -372,7 +364,7 @@ namespace Packed
           return true;
         }
         const uint_t off = GetOffset();
-        return CopyFromBack(off, Decoded, len);
+        return Decoded.CopyFromBack(off, len);
       }
 
       uint_t GetLength()
@@ -426,14 +418,17 @@ namespace Packed
       void CopySingleBytes()
       {
         const uint_t count = 14 + Stream.GetBits(5);
-        std::generate_n(std::back_inserter(Decoded), count, boost::bind(&Bitstream::Get8Bits, &Stream));
+        for (uint_t idx = 0; idx != count; ++idx)
+        {
+          Decoded.Add(Stream.Get8Bits());
+        }
       }
     private:
       bool IsValid;
       const RawHeader& Header;
       Bitstream Stream;
-      std::unique_ptr<Dump> Result;
-      Dump& Decoded;
+      DecodedData Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace DataSquieezer
 
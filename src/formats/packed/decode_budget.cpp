@@ -0,0 +1,140 @@
+/**
+*
+* @file
+*
+* @brief  Speculative decoding budget implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//common includes
+#include <types.h>
+//library includes
+#include <formats/packed.h>
+
+namespace Formats
+{
+  namespace Packed
+  {
+    thread_local DecodeBudget* InstalledBudget = nullptr;
+
+    inline bool IsInLimit(uint64_t value, uint64_t limit)
+    {
+      return !limit || value <= limit;
+    }
+
+    DecodeBudget::DecodeBudget(uint64_t maxOutput, uint64_t maxWork)
+      : MaxOutput(maxOutput)
+      , MaxWork(maxWork)
+      , Previous(InstalledBudget)
+      , Decoding(false)
+      , Exhausted(false)
+      , Output()
+      , Work()
+      , WindowOutput()
+      , WindowWork()
+    {
+      InstalledBudget = this;
+    }
+
+    DecodeBudget::~DecodeBudget()
+    {
+      InstalledBudget = Previous;
+    }
+
+    DecodeBudget* DecodeBudget::Installed()
+    {
+      return InstalledBudget;
+    }
+
+    void DecodeBudget::StartWindow()
+    {
+      WindowOutput = WindowWork = 0;
+    }
+
+    Container::Ptr DecodeBudget::Decode(const Decoder& decoder, const Binary::Container& rawData)
+    {
+      if (IsExhausted())
+      {
+        ++Stat.Aborted;
+        return Container::Ptr();
+      }
+      //decoders may be nested, e.g. archive decoder calls packed one for each file
+      const bool wasDecoding = Decoding;
+      const bool wasExhausted = Exhausted;
+      const std::size_t wasOutput = Output;
+      const std::size_t wasWork = Work;
+      Decoding = true;
+      Exhausted = false;
+      Output = Work = 0;
+      const auto finish = [&](bool success)
+      {
+        if (success)
+        {
+          ++Stat.Completed;
+        }
+        else
+        {
+          if (Exhausted)
+          {
+            ++Stat.Aborted;
+          }
+          else
+          {
+            ++Stat.Failed;
+          }
+          Stat.WastedOutput += Output;
+          Stat.WastedWork += Work;
+          WindowOutput += Output;
+          WindowWork += Work;
+        }
+        Decoding = wasDecoding;
+        Exhausted = wasExhausted;
+        Output = wasOutput;
+        Work = wasWork;
+      };
+      Container::Ptr result;
+      try
+      {
+        result = decoder.Decode(rawData);
+      }
+      catch (...)
+      {
+        finish(false);
+        throw;
+      }
+      finish(!!result);
+      return result;
+    }
+
+    DecodeBudget* DecodeBudget::Current()
+    {
+      DecodeBudget* const budget = InstalledBudget;
+      return budget && budget->Decoding ? budget : nullptr;
+    }
+
+    bool DecodeBudget::Accept(std::size_t expectedOutput)
+    {
+      return IsInLimit(WindowOutput + expectedOutput, MaxOutput) || Exhaust();
+    }
+
+    bool DecodeBudget::Check(std::size_t output, std::size_t work)
+    {
+      Output = output;
+      Work = work;
+      return (IsInLimit(WindowOutput + output, MaxOutput) && IsInLimit(WindowWork + work, MaxWork)) || Exhaust();
+    }
+
+    bool DecodeBudget::IsExhausted() const
+    {
+      return !IsInLimit(WindowOutput, MaxOutput) || !IsInLimit(WindowWork, MaxWork);
+    }
+
+    bool DecodeBudget::Exhaust()
+    {
+      Exhausted = true;
+      return false;
+    }
+  }
+}
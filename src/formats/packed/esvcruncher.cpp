@@ -23,10 +23,7 @@
 #include <math/numeric.h>
 //std includes
 #include <algorithm>
-#include <iterator>
 #include <numeric>
-//boost includes
-#include <boost/bind.hpp>
 //text includes
 #include <formats/text/packed.h>
 
@@ -208,7 +205,7 @@ namespace Packed
     {
     public:
       Bitstream(const uint8_t* data, std::size_t size)
-        : Data(data), Pos(Data + size), Bits(), Mask(0)
+        : Data(data), Pos(Data + size)
       {
       }
 
@@ -224,28 +221,17 @@ namespace Packed
 
       uint_t GetBit()
       {
-        if (!(Mask >>= 1))
-        {
-          Bits = GetByte();
-          Mask = 0x80;
-        }
-        return Bits & Mask ? 1 : 0;
+        return Bits.GetBit([this]() {return GetByte();});
       }
 
       uint_t GetBits(uint_t count)
       {
-        uint_t result = 0;
-        while (count--)
-        {
-          result = 2 * result | GetBit();
-        }
-        return result;
+        return Bits.Get(count, [this]() {return GetByte();});
       }
     private:
       const uint8_t* const Data;
       const uint8_t* Pos;
-      uint_t Bits;
-      uint_t Mask;
+      BitsBuffer<8> Bits;
     };
 
     class Container
@@ -312,8 +298,6 @@ namespace Packed
         : IsValid(container.FastCheck())
         , Header(container.GetHeader())
         , Stream(Header.Data, fromLE(Header.SizeOfPacked))
-        , Result(new Dump())
-        , Decoded(*Result)
       {
         if (IsValid && !Stream.Eof())
         {
@@ -324,27 +308,35 @@ namespace Packed
       std::unique_ptr<Dump> GetResult()
       {
         return IsValid
-          ? std::move(Result)
+          ? Decoded.CaptureResult()
           : std::unique_ptr<Dump>();
       }
     private:
       bool DecodeData()
       {
         const uint_t unpackedSize = 1 + fromLE(Header.LastOfDepacked) - ((fromLE(Header.DepackedLimit) + 1) & 0xffff);
-        Decoded.reserve(unpackedSize);
+        if (!Limiter.Accept(unpackedSize))
+        {
+          return false;
+        }
+        Decoded.Reserve(unpackedSize);
         while (!Stream.Eof() &&
-               Decoded.size() < unpackedSize)
+               Decoded.GetSize() < unpackedSize)
         {
+          if (!Limiter.Continue(Decoded.GetSize()))
+          {
+            return false;
+          }
           if (!Stream.GetBit())
           {
-            Decoded.push_back(Stream.GetByte());
+            Decoded.Add(Stream.GetByte());
           }
           else if (!DecodeCmd())
           {
             return false;
           }
         }
-        std::reverse(Decoded.begin(), Decoded.end());
+        Decoded.Reverse();
         return true;
       }
 
@@ -353,7 +345,7 @@ namespace Packed
         const uint_t len = GetLength();
         if (const uint_t off = GetOffset(len))
         {
-          return CopyFromBack(off, Decoded, len);
+          return Decoded.CopyFromBack(off, len);
         }
         return true;
       }
@@ -398,7 +390,10 @@ namespace Packed
             return 0x221 + Stream.GetBits(Header.WindowSize);
           }
           const uint_t size = 0x0a + Stream.GetBits(5);
-          std::generate_n(std::back_inserter(Decoded), size, boost::bind(&Bitstream::GetByte, &Stream));
+          for (uint_t idx = 0; idx != size; ++idx)
+          {
+            Decoded.Add(Stream.GetByte());
+          }
           return 0;
         }
         //%0
@@ -414,8 +409,8 @@ namespace Packed
       bool IsValid;
       const RawHeader& Header;
       Bitstream Stream;
-      std::unique_ptr<Dump> Result;
-      Dump& Decoded;
+      DecodedData Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace ESVCruncher
 
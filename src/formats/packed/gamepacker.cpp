@@ -251,6 +251,10 @@ namespace Packed
 
         while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           const uint8_t byt = Stream.GetByte();
           if (0 == (byt & 128))
           {
@@ -292,6 +296,7 @@ namespace Packed
       ByteStream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace GamePacker
 
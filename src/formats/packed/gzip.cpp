@@ -115,7 +115,8 @@ namespace Packed
       z_stream stream = z_stream();
       Require(Z_OK == ::inflateInit2(&stream, -15));
       const std::shared_ptr<void> cleanup(&stream, ::inflateEnd);
-      for (;;)
+      DecodeBudget* const budget = DecodeBudget::Current();
+      for (std::size_t blocks = 1; ; ++blocks)
       {
         const std::size_t restIn = input.GetRestSize();
         if (stream.avail_in == 0)
@@ -130,6 +131,7 @@ namespace Packed
           stream.avail_out = static_cast<uInt>(bufSize);
         }
         const int res = ::inflate(&stream, Z_SYNC_FLUSH);
+        Require(!budget || budget->Check(stream.total_out, blocks));
         if (Z_STREAM_END == res)
         {
           input.Skip(restIn - stream.avail_in);
@@ -245,6 +245,10 @@ namespace Packed
         //assume that first byte always exists due to header format
         while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           if (Stream.GetBit())
           {
             Decoded.push_back(Stream.GetByte());
@@ -301,6 +305,7 @@ namespace Packed
       Bitstream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace Hrum
 
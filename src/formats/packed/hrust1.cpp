@@ -226,8 +226,6 @@ namespace Packed
         : IsValid(container.FastCheck())
         , Header(container.GetHeader())
         , Stream(Header.BitStream, container.GetUsedSize() - 12)
-        , Result(new Dump())
-        , Decoded(*Result)
       {
         if (IsValid && !Stream.Eof())
         {
@@ -238,23 +236,31 @@ namespace Packed
       std::unique_ptr<Dump> GetResult()
       {
         return IsValid
-          ? std::move(Result)
+          ? Decoded.CaptureResult()
           : std::unique_ptr<Dump>();
       }
     private:
       bool DecodeData()
       {
-        Decoded.reserve(fromLE(Header.DataSize));
+        if (!Limiter.Accept(fromLE(Header.DataSize)))
+        {
+          return false;
+        }
+        Decoded.Reserve(fromLE(Header.DataSize));
 
         //put first byte
-        Decoded.push_back(Stream.GetByte());
+        Decoded.Add(Stream.GetByte());
         uint_t refBits = 2;
-        while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
+        while (!Stream.Eof() && Decoded.GetSize() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.GetSize()))
+          {
+            return false;
+          }
           //%1 - put byte
           if (Stream.GetBit())
           {
-            Decoded.push_back(Stream.GetByte());
+            Decoded.Add(Stream.GetByte());
             continue;
           }
           uint_t len = Stream.GetLen();
@@ -309,7 +315,7 @@ namespace Packed
             {
               offset = static_cast<int16_t>(0xffe0 + Stream.GetBits(5));
             }
-            if (!CopyFromBack(-offset, Decoded, 2))
+            if (!Decoded.CopyFromBack(-offset, 2))
             {
               return false;
             }
@@ -334,7 +340,7 @@ namespace Packed
               const uint_t count = 2 * (6 + Stream.GetBits(4));
               for (uint_t bytes = 0; bytes < count; ++bytes)
               {
-                Decoded.push_back(Stream.GetByte());
+                Decoded.Add(Stream.GetByte());
               }
               continue;
             }
@@ -396,41 +402,44 @@ namespace Packed
             offset |= Stream.GetByte();
             offset = static_cast<int16_t>(offset & 0xffff);
           }
-          if (!CopyFromBack(-offset, Decoded, len))
+          if (!Decoded.CopyFromBack(-offset, len))
           {
             return false;
           }
         }
         //put remaining bytes
-        std::copy(Header.LastBytes, std::end(Header.LastBytes), std::back_inserter(Decoded));
+        for (const auto byte : Header.LastBytes)
+        {
+          Decoded.Add(byte);
+        }
         return true;
       }
 
       bool CopyByteFromBack(int_t offset)
       {
         assert(offset <= 0);
-        const std::size_t size = Decoded.size();
+        const std::size_t size = Decoded.GetSize();
         if (uint_t(-offset) > size)
         {
           return false;//invalid backreference
         }
-        const Dump::value_type val = Decoded[size + offset];
-        Decoded.push_back(val);
+        const uint8_t val = Decoded[size + offset];
+        Decoded.Add(val);
         return true;
       }
 
       bool CopyBreaked(int_t offset)
       {
         return CopyByteFromBack(offset) && 
-               (Decoded.push_back(Stream.GetByte()), true) && 
+               (Decoded.Add(Stream.GetByte()), true) && 
                CopyByteFromBack(offset);
       }
     private:
       bool IsValid;
       const RawHeader& Header;
       Hrust1Bitstream Stream;
-      std::unique_ptr<Dump> Result;
-      Dump& Decoded;
+      DecodedData Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace Hrust1
 
@@ -21,29 +21,18 @@ class Hrust1Bitstream : public ByteStream
 public:
   Hrust1Bitstream(const uint8_t* data, std::size_t size)
     : ByteStream(data, size)
-    , Bits(), Mask()
   {
-    InitMask();
+    Bits.Fill(GetLEWord());
   }
 
   uint_t GetBit()
   {
-    const uint_t result = (Bits & Mask) != 0 ? 1 : 0;
-    if (!(Mask >>= 1))
-    {
-      InitMask();
-    }
-    return result;
+    return Bits.GetPrefetchedBit([this]() {return GetLEWord();});
   }
 
   uint_t GetBits(uint_t count)
   {
-    uint_t result = 0;
-    while (count--)
-    {
-      result = 2 * result | GetBit();
-    }
-    return result;
+    return Bits.GetPrefetched(count, [this]() {return GetLEWord();});
   }
 
   uint_t GetLen()
@@ -57,12 +46,5 @@ public:
     return len;
   }
 private:
-  void InitMask()
-  {
-    Bits = GetLEWord();
-    Mask = 0x8000;
-  }
-private:
-  uint_t Bits;
-  uint_t Mask;
+  BitsBuffer<16> Bits;
 };
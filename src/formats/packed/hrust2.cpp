@@ -142,28 +142,17 @@ namespace Packed
     public:
       Bitstream(const uint8_t* data, std::size_t size)
         : ByteStream(data, size)
-        , Bits(), Mask(0)
       {
       }
 
       uint_t GetBit()
       {
-        if (!(Mask >>= 1))
-        {
-          Bits = GetByte();
-          Mask = 0x80;
-        }
-        return Bits & Mask ? 1 : 0;
+        return Bits.GetBit([this]() {return GetByte();});
       }
 
       uint_t GetBits(uint_t count)
       {
-        uint_t result = 0;
-        while (count--)
-        {
-          result = 2 * result | GetBit();
-        }
-        return result;
+        return Bits.Get(count, [this]() {return GetByte();});
       }
 
       uint_t GetLen()
@@ -201,8 +190,7 @@ namespace Packed
         }
       }
     private:
-      uint_t Bits;
-      uint_t Mask;
+      BitsBuffer<8> Bits;
     };
 
     class RawDataDecoder
@@ -236,6 +224,10 @@ namespace Packed
 
         while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           //%1,byte
           if (Stream.GetBit())
           {
@@ -296,6 +288,7 @@ namespace Packed
       bool IsValid;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
 
     namespace Version1
@@ -408,6 +401,10 @@ namespace Packed
         bool DecodeData()
         {
           const uint_t size = fromLE(Header.DataSize);
+          if (!DecodeLimiter().Accept(size))
+          {
+            return false;
+          }
           if (0 != (Header.Flag & Header.NO_COMPRESSION))
           {
             //just copy
@@ -538,6 +535,8 @@ namespace Packed
         {
           const Binary::TypedContainer source(Data);
           BlocksAccumulator target;
+          const DecodeLimiter limiter;
+          std::size_t declaredSize = 0;
           std::size_t offset = 0;
           for (;;)
           {
@@ -547,6 +546,11 @@ namespace Packed
               {
                 break;
               }
+              declaredSize += fromLE(hdr->DataSize);
+              if (!limiter.Accept(declaredSize))
+              {
+                return;
+              }
               const std::size_t blockEnd = offset + hdr->GetTotalSize();
               const std::size_t packedOffset = offset + hdr->GetSize();
               const std::size_t packedSize = blockEnd - packedOffset;
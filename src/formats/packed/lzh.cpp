@@ -325,6 +325,10 @@ namespace Packed
         //assume that first byte always exists due to header format
         while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           const uint_t data = Stream.GetByte();
           if (!data)
           {
@@ -366,6 +370,7 @@ namespace Packed
       ByteStream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace LZH
 
@@ -22,7 +22,6 @@
 #include <formats/packed.h>
 //std includes
 #include <algorithm>
-#include <iterator>
 //text includes
 #include <formats/text/packed.h>
 
@@ -211,8 +210,7 @@ namespace Packed
         : IsValid(container.FastCheck())
         , Header(container.GetHeader())
         , Stream(Header.Data, fromLE(Header.SizeOfPacked))
-        , Result(new Dump())
-        , Decoded(*Result)
+        , Decoded(2 * fromLE(Header.SizeOfPacked))
       {
         if (IsValid && !Stream.Eof())
         {
@@ -223,17 +221,20 @@ namespace Packed
       std::unique_ptr<Dump> GetResult()
       {
         return IsValid
-          ? std::move(Result)
+          ? Decoded.CaptureResult()
           : std::unique_ptr<Dump>();
       }
     private:
       bool DecodeData()
       {
         // The main concern is to decode data as much as possible, skipping defenitely invalid structure
-        Decoded.reserve(2 * fromLE(Header.SizeOfPacked));
         //assume that first byte always exists due to header format
-        while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
+        while (!Stream.Eof() && Decoded.GetSize() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.GetSize()))
+          {
+            return false;
+          }
           const uint_t data = Stream.GetByte();
           if (0x80 == data)
           {
@@ -252,7 +253,7 @@ namespace Packed
             assert(len);
             for (; len && !Stream.Eof(); --len)
             {
-              Decoded.push_back(Stream.GetByte());
+              Decoded.Add(Stream.GetByte());
             }
             if (len)
             {
@@ -263,13 +264,13 @@ namespace Packed
           {
             const std::size_t len = (data & 0x3f) + 3;
             const uint8_t filler = Stream.GetByte();
-            std::fill_n(std::back_inserter(Decoded), len, filler);
+            Decoded.Fill(len, filler);
           }
           else
           {
             const std::size_t len = ((data & 0xf0) >> 4) + 3;
             const uint_t offset = 256 * (data & 0x0f) + Stream.GetByte();
-            if (!CopyFromBack(offset, Decoded, len))
+            if (!Decoded.CopyFromBack(offset, len))
             {
               return false;
             }
@@ -277,7 +278,7 @@ namespace Packed
         }
         while (!Stream.Eof())
         {
-          Decoded.push_back(Stream.GetByte());
+          Decoded.Add(Stream.GetByte());
         }
         return true;
       }
@@ -285,8 +286,8 @@ namespace Packed
       bool IsValid;
       const RawHeader& Header;
       ByteStream Stream;
-      std::unique_ptr<Dump> Result;
-      Dump& Decoded;
+      DecodedData Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace LZS
 
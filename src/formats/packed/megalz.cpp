@@ -64,7 +64,6 @@ namespace Packed
     public:
       Bitstream(const uint8_t* data, std::size_t size)
         : ByteStream(data, size)
-        , Bits(), Mask(0)
       {
       }
 
@@ -76,22 +75,12 @@ namespace Packed
 
       uint_t GetBit()
       {
-        if (!(Mask >>= 1))
-        {
-          Bits = GetByte();
-          Mask = 0x80;
-        }
-        return Bits & Mask ? 1 : 0;
+        return Bits.GetBit([this]() {return GetByte();});
       }
 
       uint_t GetBits(uint_t count)
       {
-        uint_t result = 0;
-        while (count--)
-        {
-          result = 2 * result | GetBit();
-        }
-        return result;
+        return Bits.Get(count, [this]() {return GetByte();});
       }
 
       uint_t GetLen()
@@ -119,8 +108,7 @@ namespace Packed
 
       using ByteStream::GetProcessedBytes;
     private:
-      uint_t Bits;
-      uint_t Mask;
+      BitsBuffer<8> Bits;
     };
 
     class DataDecoder
@@ -158,6 +146,10 @@ namespace Packed
           Decoded.push_back(Stream.GetByte());
           while (Decoded.size() < MAX_DECODED_SIZE)
           {
+            if (!Limiter.Continue(Decoded.size()))
+            {
+              return false;
+            }
             if (Stream.GetBit())
             {
               Decoded.push_back(Stream.GetByte());
@@ -206,6 +198,7 @@ namespace Packed
       Bitstream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace MegaLZ
 
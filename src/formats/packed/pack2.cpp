@@ -20,7 +20,6 @@
 #include <formats/packed.h>
 //std includes
 #include <algorithm>
-#include <iterator>
 //text includes
 #include <formats/text/packed.h>
 
@@ -199,8 +198,7 @@ namespace Packed
         : IsValid(container.FastCheck())
         , Header(container.GetHeader())
         , Stream(Header.PackedData, container.GetPackedSize())
-        , Result(new Dump())
-        , Decoded(*Result)
+        , Decoded(2 * container.GetPackedSize())
       {
         if (IsValid && !Stream.Eof())
         {
@@ -211,19 +209,23 @@ namespace Packed
       std::unique_ptr<Dump> GetResult()
       {
         return IsValid
-          ? std::move(Result)
+          ? Decoded.CaptureResult()
           : std::unique_ptr<Dump>();
       }
     private:
       bool DecodeData()
       {
         //assume that first byte always exists due to header format
-        while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
+        while (!Stream.Eof() && Decoded.GetSize() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.GetSize()))
+          {
+            return false;
+          }
           const uint_t data = Stream.GetByte();
           if (data != Header.Marker)
           {
-            Decoded.push_back(data);
+            Decoded.Add(data);
           }
           else
           {
@@ -235,31 +237,31 @@ namespace Packed
                 const uint8_t filler = len < Header.RleThreshold
                   ? Header.FirstRleByte
                   : Header.SecondRleByte;
-                std::fill_n(std::back_inserter(Decoded), len, filler);
+                Decoded.Fill(len, filler);
               }
               else
               {
-                std::fill_n(std::back_inserter(Decoded), 256, 0);
+                Decoded.Fill(256, 0);
               }
             }
             else
             {
               const std::size_t len = token ? token : 256;
               const uint8_t filler = Stream.GetByte();
-              std::fill_n(std::back_inserter(Decoded), len, filler);
+              Decoded.Fill(len, filler);
             }
           }
         }
-        Decoded.pop_back();
-        std::reverse(Decoded.begin(), Decoded.end());
+        Decoded.Truncate(Decoded.GetSize() - 1);
+        Decoded.Reverse();
         return true;
       }
     private:
       bool IsValid;
       const RawHeader& Header;
       ReverseByteStream Stream;
-      std::unique_ptr<Dump> Result;
-      Dump& Decoded;
+      DecodedData Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace Pack2
 
@@ -12,10 +12,13 @@
 
 //common includes
 #include <types.h>
+//library includes
+#include <formats/packed.h>
 //std includes
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <memory>
 
 class ByteStream
 {
@@ -76,6 +79,245 @@ void RecursiveCopy(ConstIterator srcBegin, ConstIterator srcEnd, Iterator dstBeg
   }
 }
 
+//MSB-first bits buffer taking data from source by units of UnitBits width.
+//Next unit is fetched only when all the bits of previous one are consumed, so order of bytes reads
+//interleaved with bits reads from the same stream is kept. Multiple bits are extracted at once.
+template<uint_t UnitBits>
+class BitsBuffer
+{
+public:
+  BitsBuffer()
+    : Bits(), Available()
+  {
+  }
+
+  void Fill(uint_t unit)
+  {
+    Bits = unit;
+    Available = UnitBits;
+  }
+
+  template<class FetchFunc>
+  uint_t GetBit(FetchFunc fetch)
+  {
+    if (!Available)
+    {
+      Fill(fetch());
+    }
+    return (Bits >> --Available) & 1;
+  }
+
+  template<class FetchFunc>
+  uint_t GetPrefetchedBit(FetchFunc fetch)
+  {
+    const uint_t result = (Bits >> --Available) & 1;
+    if (!Available)
+    {
+      Fill(fetch());
+    }
+    return result;
+  }
+
+  //unit is fetched on demand
+  template<class FetchFunc>
+  uint_t Get(uint_t count, FetchFunc fetch)
+  {
+    uint_t result = 0;
+    while (count)
+    {
+      if (!Available)
+      {
+        Fill(fetch());
+      }
+      result = Take(result, count);
+    }
+    return result;
+  }
+
+  //next unit is fetched right after the previous one is exhausted
+  template<class FetchFunc>
+  uint_t GetPrefetched(uint_t count, FetchFunc fetch)
+  {
+    uint_t result = 0;
+    while (count)
+    {
+      result = Take(result, count);
+      if (!Available)
+      {
+        Fill(fetch());
+      }
+    }
+    return result;
+  }
+private:
+  uint_t Take(uint_t result, uint_t& count)
+  {
+    const uint_t portion = std::min(count, Available);
+    Available -= portion;
+    count -= portion;
+    return (result << portion) | ((Bits >> Available) & ((1u << portion) - 1));
+  }
+private:
+  uint_t Bits;
+  uint_t Available;
+};
+
+//LZ-style forward copy where source may overlap the beginning of target.
+//Long matches are copied by blocks of already available pattern, so even short offsets do not degrade to bytes loop
+inline void CopyMatch(const uint8_t* src, uint8_t* dst, std::size_t count)
+{
+  const std::size_t SHORT_MATCH = 16;
+  const std::size_t offset = dst - src;
+  if (count < SHORT_MATCH)
+  {
+    while (count--)
+    {
+      *dst++ = *src++;
+    }
+  }
+  else if (offset >= count)
+  {
+    std::memcpy(dst, src, count);
+  }
+  else if (offset == 1)
+  {
+    std::memset(dst, *src, count);
+  }
+  else
+  {
+    //each block doubles available pattern size keeping it multiple of offset
+    for (std::size_t block = offset; count != 0; block = dst - src)
+    {
+      const std::size_t toCopy = std::min(block, count);
+      std::memcpy(dst, src, toCopy);
+      dst += toCopy;
+      count -= toCopy;
+    }
+  }
+}
+
+//Same as CopyMatch, but up to WIDE_MATCH_SLACK bytes after the target may be overwritten.
+//Matches are copied by 16- or 8-byte blocks not overlapping their sources
+const std::size_t WIDE_MATCH_SLACK = 16;
+
+inline void CopyMatchWide(const uint8_t* src, uint8_t* dst, std::size_t count)
+{
+  const std::size_t offset = dst - src;
+  if (offset >= 16)
+  {
+    for (const uint8_t* const end = dst + count; dst < end; dst += 16, src += 16)
+    {
+      std::memcpy(dst, src, 16);
+    }
+  }
+  else if (offset >= 8)
+  {
+    for (const uint8_t* const end = dst + count; dst < end; dst += 8, src += 8)
+    {
+      std::memcpy(dst, src, 8);
+    }
+  }
+  else
+  {
+    CopyMatch(src, dst, count);
+  }
+}
+
+//Decoded data storage. Memory is allocated at once for known size (or grown geometrically otherwise)
+//with slack for wide matches copying, so back references are copied in place without resizing.
+class DecodedData
+{
+public:
+  //@param expectedSize exact size if known or estimation
+  explicit DecodedData(std::size_t expectedSize = 0)
+    : Data(new Dump(expectedSize + WIDE_MATCH_SLACK))
+    , Size()
+  {
+  }
+
+  //@param expectedSize exact size known after validation
+  void Reserve(std::size_t expectedSize)
+  {
+    if (expectedSize + WIDE_MATCH_SLACK > Data->size())
+    {
+      Data->resize(expectedSize + WIDE_MATCH_SLACK);
+    }
+  }
+
+  std::size_t GetSize() const
+  {
+    return Size;
+  }
+
+  uint8_t operator[](std::size_t idx) const
+  {
+    return (*Data)[idx];
+  }
+
+  void Add(uint8_t val)
+  {
+    *Allocate(1) = val;
+  }
+
+  void Fill(std::size_t count, uint8_t val)
+  {
+    std::memset(Allocate(count), val, count);
+  }
+
+  //offset to back
+  bool CopyFromBack(std::size_t offset, std::size_t count)
+  {
+    if (offset > Size)
+    {
+      return false;//invalid backref
+    }
+    if (offset && count)
+    {
+      uint8_t* const target = Prepare(count);
+      CopyMatchWide(target - offset, target, count);
+    }
+    Size += count;
+    return true;
+  }
+
+  void Truncate(std::size_t size)
+  {
+    Size = std::min(Size, size);
+  }
+
+  void Reverse()
+  {
+    std::reverse(Data->begin(), Data->begin() + Size);
+  }
+
+  std::unique_ptr<Dump> CaptureResult()
+  {
+    Data->resize(Size);
+    return std::move(Data);
+  }
+private:
+  //@return pointer to the data end with at least count+WIDE_MATCH_SLACK bytes available
+  uint8_t* Prepare(std::size_t count)
+  {
+    const std::size_t required = Size + count + WIDE_MATCH_SLACK;
+    if (required > Data->size())
+    {
+      Data->resize(std::max(required, Data->size() * 2));
+    }
+    return Data->data() + Size;
+  }
+
+  uint8_t* Allocate(std::size_t count)
+  {
+    uint8_t* const result = Prepare(count);
+    Size += count;
+    return result;
+  }
+private:
+  std::unique_ptr<Dump> Data;
+  std::size_t Size;
+};
+
 //offset to back
 inline bool CopyFromBack(std::size_t offset, Dump& dst, std::size_t count)
 {
@@ -85,13 +327,42 @@ inline bool CopyFromBack(std::size_t offset, Dump& dst, std::size_t count)
     return false;//invalid backref
   }
   dst.resize(size + count);
-  const Dump::iterator dstStart = dst.begin() + size;
-  const Dump::const_iterator srcStart = dstStart - offset;
-  const Dump::const_iterator srcEnd = srcStart + count;
-  RecursiveCopy(srcStart, srcEnd, dstStart);
+  if (offset && count)
+  {
+    uint8_t* const target = &dst[size];
+    CopyMatch(target - offset, target, count);
+  }
   return true;
 }
 
+//Accounting of speculative decoding budget for decoders main loops. Checked periodically to keep loops cheap
+class DecodeLimiter
+{
+public:
+  DecodeLimiter()
+    : Budget(Formats::Packed::DecodeBudget::Current())
+    , Steps()
+  {
+  }
+
+  //@return false if decoding of declared size should not be started
+  bool Accept(std::size_t expectedOutput) const
+  {
+    return !Budget || Budget->Accept(expectedOutput);
+  }
+
+  //single step of decoding, e.g. token or block
+  //@return false if decoding should be aborted
+  bool Continue(std::size_t output)
+  {
+    return !Budget || ++Steps % CHECK_PERIOD != 0 || Budget->Check(output, Steps);
+  }
+private:
+  static const std::size_t CHECK_PERIOD = 256;
+  Formats::Packed::DecodeBudget* const Budget;
+  std::size_t Steps;
+};
+
 // src - first or last byte of source data to copy (e.g. hl)
 // dst - first or last byte of target data to copy (e.g. de)
 // count - count of bytes to copy (e.g. bc)
@@ -295,32 +295,20 @@ namespace Packed
     public:
       Bitstream(const uint8_t* data, std::size_t size)
         : ByteStream(data, size)
-        , Bits(), Mask(0)
       {
       }
 
       uint_t GetBit()
       {
-        if (!(Mask >>= 1))
-        {
-          Bits = GetLEWord();
-          Mask = 0x8000;
-        }
-        return (Bits & Mask) != 0 ? 1 : 0;
+        return Bits.GetBit([this]() {return GetLEWord();});
       }
 
       uint_t GetBits(uint_t count)
       {
-        uint_t result = 0;
-        while (count--)
-        {
-          result = 2 * result | GetBit();
-        }
-        return result;
+        return Bits.Get(count, [this]() {return GetLEWord();});
       }
     private:
-      uint_t Bits;
-      uint_t Mask;
+      BitsBuffer<16> Bits;
     };
 
     class BitstreamDecoder
@@ -339,6 +327,10 @@ namespace Packed
         while (GetSingleBytes() &&
                Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           const uint_t index = GetIndex();
           uint_t offset = 0;
           uint_t len = index + 1;
@@ -433,6 +425,7 @@ namespace Packed
       Bitstream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
 
     template<class Version>
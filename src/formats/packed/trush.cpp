@@ -208,6 +208,10 @@ namespace Packed
 
         while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.size()))
+          {
+            return false;
+          }
           //%0 - put byte
           if (!Stream.GetBit())
           {
@@ -296,6 +300,7 @@ namespace Packed
       Hrust1Bitstream Stream;
       std::unique_ptr<Dump> Result;
       Dump& Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace Trush
 
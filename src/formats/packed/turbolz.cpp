@@ -22,7 +22,6 @@
 //std includes
 #include <algorithm>
 #include <array>
-#include <iterator>
 //text includes
 #include <formats/text/packed.h>
 
@@ -327,8 +326,7 @@ namespace Packed
         : IsValid(container.FastCheck())
         , Header(container.GetHeader())
         , Stream(container.GetPackedData(), container.GetPackedDataSize())
-        , Result(new Dump())
-        , Decoded(*Result)
+        , Decoded(2 * Stream.GetRestBytes())
       {
         if (IsValid && !Stream.Eof())
         {
@@ -340,7 +338,7 @@ namespace Packed
       std::unique_ptr<Dump> GetResult()
       {
         return IsValid
-          ? std::move(Result)
+          ? Decoded.CaptureResult()
           : std::unique_ptr<Dump>();
       }
 
@@ -354,13 +352,17 @@ namespace Packed
       template<class KeyFunc>
       bool DecodeData(KeyFunc& keyFunctor)
       {
-        while (!Stream.Eof() && Decoded.size() < MAX_DECODED_SIZE)
+        while (!Stream.Eof() && Decoded.GetSize() < MAX_DECODED_SIZE)
         {
+          if (!Limiter.Continue(Decoded.GetSize()))
+          {
+            return false;
+          }
           const uint_t token = Stream.GetByte();
           if (!token)
           {
             //%00000000 - exit
-            Decoded.push_back(Header.LastByte);
+            Decoded.Add(Header.LastByte);
             Simple::KeyFunc noDecode;
             CopyNonPacked(Stream.GetRestBytes(), noDecode);
             return true;
@@ -373,7 +375,7 @@ namespace Packed
             const uint_t len = (0xe0 == (token & 0xe0))
               ? Stream.GetByte()
               : 3 + (token >> 5);
-            if (!CopyFromBack(offset + 1, Decoded, len))
+            if (!Decoded.CopyFromBack(offset + 1, len))
             {
               return false;
             }
@@ -388,7 +390,7 @@ namespace Packed
             uint8_t incMarker = 63 + 3;
             for (uint_t len = initCount + 3; len;)
             {
-              std::fill_n(std::back_inserter(Decoded), len, data);
+              Decoded.Fill(len, data);
               if (len != incMarker)
               {
                 break;
@@ -431,7 +433,7 @@ namespace Packed
         {
           const uint8_t data = Stream.GetByte();
           const uint8_t key = keyFunctor();
-          Decoded.push_back(data ^ key);
+          Decoded.Add(data ^ key);
         }
         return len == 0;
       }
@@ -439,8 +441,8 @@ namespace Packed
       bool IsValid;
       const typename Version::RawHeader& Header;
       ByteStream Stream;
-      std::unique_ptr<Dump> Result;
-      Dump& Decoded;
+      DecodedData Decoded;
+      DecodeLimiter Limiter;
     };
   }//namespace TurboLZ
 
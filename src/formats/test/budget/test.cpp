@@ -0,0 +1,153 @@
+/**
+*
+* @file
+*
+* @brief  Speculative decoding budget test
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#include "../utils.h"
+
+namespace
+{
+  Binary::Container::Ptr Open(const std::string& name)
+  {
+    std::unique_ptr<Dump> data(new Dump());
+    Test::OpenFile(name, *data);
+    return Binary::CreateContainer(std::move(data));
+  }
+
+  //keeps header and stream start, so decoding fails somewhere in the middle
+  Binary::Container::Ptr Corrupt(const Binary::Data& data)
+  {
+    const uint8_t* const start = static_cast<const uint8_t*>(data.Start());
+    std::unique_ptr<Dump> result(new Dump(start, start + data.Size()));
+    for (std::size_t idx = result->size() / 2; idx < result->size(); ++idx)
+    {
+      (*result)[idx] ^= 0xff;
+    }
+    return Binary::CreateContainer(std::move(result));
+  }
+
+  void Check(bool condition, const std::string& msg)
+  {
+    if (!condition)
+    {
+      throw std::runtime_error(msg);
+    }
+    std::cout << " " << msg << ": passed" << std::endl;
+  }
+
+  void CheckStatistic(const Formats::Packed::DecodeBudget& budget, std::size_t completed, std::size_t failed, std::size_t aborted)
+  {
+    const Formats::Packed::DecodeBudget::Statistic& stat = budget.GetStatistic();
+    if (stat.Completed != completed || stat.Failed != failed || stat.Aborted != aborted)
+    {
+      std::ostringstream str;
+      str << "Invalid statistic: completed=" << stat.Completed << " failed=" << stat.Failed << " aborted=" << stat.Aborted;
+      throw std::runtime_error(str.str());
+    }
+  }
+}
+
+int main()
+{
+  try
+  {
+    const Formats::Packed::Decoder::Ptr hrum = Formats::Packed::CreateHrumDecoder();
+    const Formats::Packed::Decoder::Ptr dsq = Formats::Packed::CreateDataSquieezerDecoder();
+    const Binary::Container::Ptr hrumData = Open("../hrum/packed1.bin");
+    const Binary::Container::Ptr dsqData = Open("../dsq/4kfixed.bin");
+    const Formats::Packed::Decoder::Ptr cc3 = Formats::Packed::CreateCodeCruncher3Decoder();
+    const Binary::Container::Ptr corruptedCc3Data = Corrupt(*Open("../cc3/packed.bin"));
+
+    std::cout << "Test for unlimited budget" << std::endl;
+    {
+      Formats::Packed::DecodeBudget budget(0, 0);
+      Check(!!budget.Decode(*hrum, *hrumData), "valid data decoded");
+      Check(!budget.Decode(*cc3, *corruptedCc3Data), "corrupted data rejected");
+      CheckStatistic(budget, 1, 1, 0);
+      Check(budget.GetStatistic().WastedOutput != 0 && budget.GetStatistic().WastedWork != 0, "corrupted data decoding accounted");
+      Check(!!budget.Decode(*dsq, *dsqData), "valid data decoded after waste");
+    }
+    std::cout << "Test for exhausted budget" << std::endl;
+    {
+      Formats::Packed::DecodeBudget budget(1024, 0);
+      Check(!budget.Decode(*hrum, *hrumData), "decoding aborted in main loop");
+      CheckStatistic(budget, 0, 0, 1);
+      Check(!budget.Decode(*dsq, *dsqData), "decoding not started");
+      CheckStatistic(budget, 0, 0, 2);
+      Check(!!hrum->Decode(*hrumData), "direct decoding is not limited");
+    }
+    std::cout << "Test for declared size" << std::endl;
+    {
+      Formats::Packed::DecodeBudget budget(1024, 0);
+      Check(!budget.Decode(*dsq, *dsqData), "decoding rejected by declared size");
+      CheckStatistic(budget, 0, 0, 1);
+      Check(budget.GetStatistic().WastedOutput == 0, "nothing decoded");
+    }
+    std::cout << "Test for work limit" << std::endl;
+    {
+      Formats::Packed::DecodeBudget budget(0, 512);
+      Check(!budget.Decode(*cc3, *corruptedCc3Data), "corrupted data rejected");
+      CheckStatistic(budget, 0, 0, 1);
+      Check(budget.GetStatistic().WastedWork > 512, "work limit exceeded");
+    }
+    std::cout << "Test for accounting window" << std::endl;
+    {
+      Formats::Packed::DecodeBudget budget(16384, 0);
+      Check(!budget.Decode(*cc3, *corruptedCc3Data), "corrupted data rejected");
+      Check(!budget.Decode(*hrum, *hrumData), "decoding aborted by spent budget");
+      CheckStatistic(budget, 0, 1, 1);
+      budget.StartWindow();
+      Check(!!budget.Decode(*hrum, *hrumData), "valid data decoded in new window");
+      CheckStatistic(budget, 1, 1, 1);
+      Check(budget.GetStatistic().WastedOutput != 0, "statistic is kept");
+    }
+    std::cout << "Test for nested decoding" << std::endl;
+    {
+      //outer decoding is exhausted while inner one is performed
+      class NestedDecoder : public Formats::Packed::Decoder
+      {
+      public:
+        NestedDecoder(Formats::Packed::Decoder::Ptr inner, Binary::Container::Ptr innerData)
+          : Inner(std::move(inner))
+          , InnerData(std::move(innerData))
+        {
+        }
+
+        String GetDescription() const override
+        {
+          return Inner->GetDescription();
+        }
+
+        Binary::Format::Ptr GetFormat() const override
+        {
+          return Inner->GetFormat();
+        }
+
+        Formats::Packed::Container::Ptr Decode(const Binary::Container& /*rawData*/) const override
+        {
+          Formats::Packed::DecodeBudget* const budget = Formats::Packed::DecodeBudget::Current();
+          budget->Check(32768, 0);
+          budget->Decode(*Inner, *InnerData);
+          return Formats::Packed::Container::Ptr();
+        }
+      private:
+        const Formats::Packed::Decoder::Ptr Inner;
+        const Binary::Container::Ptr InnerData;
+      };
+      Formats::Packed::DecodeBudget budget(16384, 0);
+      const NestedDecoder nested(cc3, corruptedCc3Data);
+      Check(!budget.Decode(nested, *hrumData), "outer decoding aborted");
+      CheckStatistic(budget, 0, 1, 1);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << e.what() << std::endl;
+    return 1;
+  }
+}
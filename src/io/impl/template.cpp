@@ -32,12 +32,22 @@ namespace IO
 
     String GetFieldValue(const String& fieldName) const override
     {
-      const String res = Delegate.GetFieldValue(fieldName);
-      return res.empty()
+      String res = Delegate.GetFieldValue(fieldName);
+      return IsPlainName(res)
         ? res
         : FilterPath(res);
     }
   private:
+    //single path component is kept as is, so avoid paths parsing for the most of values
+    static bool IsPlainName(const String& val)
+    {
+      static const Char SPECIAL[] = {'/', '\\', ':', 0};
+      static const Char THIS_DIR[] = {'.', 0};
+      static const Char PARENT_DIR[] = {'.', '.', 0};
+      return val.empty()
+        || (String::npos == val.find_first_of(SPECIAL) && val != THIS_DIR && val != PARENT_DIR);
+    }
+
     static String FilterPath(const String& val)
     {
       static const Char DELIMITER[] = {'_', 0};
@@ -69,10 +79,12 @@ namespace IO
     {
     }
 
-    String Instantiate(const Strings::FieldsSource& source) const override
+    using Strings::Template::Instantiate;
+
+    void Instantiate(const Strings::FieldsSource& source, String& result) const override
     {
       const FilenameFieldsFilter filter(source);
-      return Delegate->Instantiate(filter);
+      Delegate->Instantiate(filter, result);
     }
   private:
     const Strings::Template::Ptr Delegate;
@@ -14,6 +14,7 @@
 #include <types.h>
 //std includes
 #include <memory>
+#include <vector>
 
 namespace Module
 {
@@ -33,5 +34,13 @@ namespace Module
     };
 
     virtual std::vector<ChannelState> GetState() const = 0;
+
+    //! @brief Get state reusing target's memory
+    //! @param lag Frames count back from the most recent state to be in sync with playback latency. Used if supported
+    virtual void GetState(uint_t lag, std::vector<ChannelState>& state) const
+    {
+      static_cast<void>(lag);
+      state = GetState();
+    }
   };
 }
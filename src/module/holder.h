@@ -20,6 +20,8 @@
 namespace Module
 {
   //! @brief %Module holder interface
+  //! @note Holder is immutable after creation, so all the methods may be called concurrently and produced renderers
+  //!       may be used in different threads independently. Lazily calculated data is initialized once in thread-safe manner
   class Holder
   {
   public:
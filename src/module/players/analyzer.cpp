@@ -34,6 +34,15 @@ namespace Module
       //required by compiler
       return std::move(out);
     }
+
+    void GetState(uint_t lag, std::vector<ChannelState>& state) const override
+    {
+      //per-thread buffer to allow concurrent polling
+      static thread_local Devices::MultiChannelState buffer;
+      Delegate->GetState(lag, buffer);
+      state.resize(buffer.size());
+      std::transform(buffer.begin(), buffer.end(), state.begin(), &ConvertState);
+    }
   private:
     static ChannelState ConvertState(const Devices::ChannelState& in)
     {
@@ -259,6 +259,8 @@ namespace ASCSoundMaster
     ModuleData::RWPtr Data;
   };
 
+  typedef TrackProbeBuilder<Formats::Chiptune::ASCSoundMaster::StubBuilder, Formats::Chiptune::ASCSoundMaster::Positions, SimpleOrderList> ProbeBuilder;
+
   const uint_t LIMITER(~uint_t(0));
 
   struct ChannelState
@@ -634,10 +636,42 @@ namespace ASCSoundMaster
   private:
     const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr Decoder;
   };
-  
+
+  class Prober : public Module::Prober
+  {
+  public:
+    explicit Prober(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {
+    }
+
+    Information::Ptr Probe(const Binary::Container& rawData, Parameters::Modifier& properties) const override
+    {
+      AYM::PropertiesHelper props(properties);
+      props.SetFrequencyTable(TABLE_ASM);
+      ProbeBuilder dataBuilder(props);
+      if (const auto container = Decoder->Parse(rawData, dataBuilder))
+      {
+        props.SetSource(*container);
+        return CreateTrackInfo(dataBuilder.CaptureResult(), AYM::TRACK_CHANNELS);
+      }
+      else
+      {
+        return Information::Ptr();
+      }
+    }
+  private:
+    const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr Decoder;
+  };
+
   AYM::Factory::Ptr CreateFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(decoder);
   }
+
+  Module::Prober::Ptr CreateProber(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder)
+  {
+    return MakePtr<Prober>(decoder);
+  }
 }
 }
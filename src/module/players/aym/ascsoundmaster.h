@@ -14,11 +14,13 @@
 #include "aym_factory.h"
 //library includes
 #include <formats/chiptune/aym/ascsoundmaster.h>
+#include <module/players/prober.h>
 
 namespace Module
 {
   namespace ASCSoundMaster
   {
     AYM::Factory::Ptr CreateFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder);
+    Prober::Ptr CreateProber(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder);
   }
 }
@@ -50,12 +50,25 @@ namespace AYEMUL
       Register = 0;
       Chunks.clear();
       State = Devices::AYM::DataChunk();
+      Pending = Devices::AYM::Registers();
       Blocked = false;
     }
 
-    void SetBlocked(bool block)
+    void Block()
     {
-      Blocked = block;
+      Pending = Devices::AYM::Registers();
+      Blocked = true;
+    }
+
+    void Unblock(const Devices::AYM::Stamp& timeStamp)
+    {
+      Blocked = false;
+      //pass only registers written silently, so envelope is not restarted without R13 write
+      if (!Pending.Empty())
+      {
+        AllocateChunk(timeStamp).Data = Pending;
+        Pending = Devices::AYM::Registers();
+      }
     }
 
     bool SelectRegister(uint_t reg)
@@ -73,6 +86,10 @@ namespace AYEMUL
         {
           chunk->Data[idx] = val;
         }
+        else
+        {
+          Pending[idx] = val;
+        }
         State.Data[idx] = val;
         return true;
       }
@@ -127,6 +144,7 @@ namespace AYEMUL
     uint_t Register;
     std::vector<Devices::AYM::DataChunk> Chunks;
     Devices::AYM::DataChunk State;
+    Devices::AYM::Registers Pending;
     bool Blocked;
   };
   
@@ -148,9 +166,15 @@ namespace AYEMUL
       Blocked = false;
     }
 
-    void SetBlocked(bool block)
+    void Block()
     {
-      Blocked = block;
+      Blocked = true;
+    }
+
+    void Unblock(const Devices::Beeper::Stamp& timeStamp)
+    {
+      Blocked = false;
+      AllocateChunk(timeStamp);
     }
 
     void SetLevel(const Devices::Beeper::Stamp& timeStamp, bool val)
@@ -208,10 +232,16 @@ namespace AYEMUL
       Beeper.Reset();
     }
     
-    void SetBlocked(bool block)
+    void Block()
+    {
+      Ay.Block();
+      Beeper.Block();
+    }
+
+    void Unblock(const Devices::Z80::Stamp& timeStamp)
     {
-      Ay.SetBlocked(block);
-      Beeper.SetBlocked(block);
+      Ay.Unblock(timeStamp);
+      Beeper.Unblock(timeStamp);
     }
 
     bool SelectAyRegister(uint_t reg)
@@ -400,9 +430,14 @@ namespace AYEMUL
       CPC.Reset();
     }
 
-    void SetBlocked(bool blocked)
+    void Block()
     {
-      Channel->SetBlocked(blocked);
+      Channel->Block();
+    }
+
+    void Unblock(const Devices::Z80::Stamp& timeStamp)
+    {
+      Channel->Unblock(timeStamp);
     }
 
     uint8_t Read(uint16_t port) override
@@ -532,17 +567,22 @@ namespace AYEMUL
       CPU->Execute(til);
     }
 
+    //run CPU only, sound devices get the resulting registers state afterwards
     void SkipFrames(uint_t count, const Devices::Z80::Stamp& frameStep)
     {
+      if (!count)
+      {
+        return;
+      }
       const Devices::Z80::Stamp curTime = CPU->GetTime();
-      CPUPorts->SetBlocked(true);
+      CPUPorts->Block();
       Devices::Z80::Stamp pos = curTime;
       for (uint_t frame = 0; frame < count; ++frame)
       {
         pos += frameStep;
         NextFrame(pos);
       }
-      CPUPorts->SetBlocked(false);
+      CPUPorts->Unblock(curTime);
       CPU->SetTime(curTime);
     }
   private:
@@ -830,7 +870,9 @@ namespace AYEMUL
 
     Renderer::Ptr CreateRenderer(Parameters::Accessor::Ptr params, Devices::AYM::Device::Ptr chip) const override
     {
-      return CreateRenderer(params, chip, MakePtr<StubBeeper>());
+      //chip may track beeper too, e.g. to detect playback end without sound synthesis
+      const Devices::Beeper::Device::Ptr beeper = std::dynamic_pointer_cast<Devices::Beeper::Device>(chip);
+      return CreateRenderer(params, chip, beeper ? beeper : MakePtr<StubBeeper>());
     }
 
     AYM::Chiptune::Ptr GetChiptune() const override
@@ -10,6 +10,7 @@
 
 //local includes
 #include "aym_base.h"
+#include "aym_base_cache.h"
 //common includes
 #include <make_ptr.h>
 //library includes
@@ -261,7 +262,7 @@ namespace Module
   {
     Holder::Ptr CreateHolder(Chiptune::Ptr chiptune)
     {
-      return MakePtr<AYMHolder>(chiptune);
+      return MakePtr<AYMHolder>(CreateCachedChiptune(chiptune));
     }
 
     Analyzer::Ptr CreateAnalyzer(Devices::AYM::Device::Ptr device)
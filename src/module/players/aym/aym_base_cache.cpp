@@ -0,0 +1,535 @@
+/**
+*
+* @file
+*
+* @brief  AYM-based chiptunes registers cache implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "aym_base_cache.h"
+#include "aym_base_stream.h"
+//common includes
+#include <make_ptr.h>
+//library includes
+#include <debug/log.h>
+#include <module/players/track_model.h>
+#include <parameters/tracking_helper.h>
+//std includes
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <utility>
+
+namespace Module
+{
+namespace AYM
+{
+  const Debug::Stream Dbg("Core::AYCache");
+
+  inline bool IsSame(const Devices::AYM::Registers& lh, const Devices::AYM::Registers& rh)
+  {
+    for (uint_t reg = 0; reg != Devices::AYM::Registers::TOTAL; ++reg)
+    {
+      const auto idx = static_cast<Devices::AYM::Registers::Index>(reg);
+      if (lh.Has(idx) != rh.Has(idx) || (lh.Has(idx) && lh[idx] != rh[idx]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //Registers stream and tracker's state recorded for specific frequency table
+  struct CachedTrack
+  {
+    typedef std::shared_ptr<const CachedTrack> Ptr;
+
+    //tracker's state is stored once per line, quirk is calculated from the frame
+    struct LineState
+    {
+      uint_t Frame;
+      uint_t Quirk;
+      uint_t Position;
+      uint_t Pattern;
+      uint_t Line;
+      uint_t Tempo;
+      const class Pattern* PatternObject;
+      const class Line* LineObject;
+
+      bool Continues(const TrackModelState& state) const
+      {
+        return state.Quirk() == Quirk + (state.Frame() - Frame)
+            && state.Position() == Position && state.Pattern() == Pattern && state.Line() == Line && state.Tempo() == Tempo
+            && state.PatternObject() == PatternObject && state.LineObject() == LineObject;
+      }
+    };
+
+    uint_t Frames;
+    uint_t Loop;
+    std::vector<LineState> Lines;
+    StreamModel::Ptr Registers;
+
+    std::size_t FindLine(uint_t frame) const
+    {
+      const auto it = std::upper_bound(Lines.begin(), Lines.end(), frame,
+        [](uint_t frm, const LineState& line) {return frm < line.Frame;});
+      return it - Lines.begin() - 1;
+    }
+
+    //! @param played frames passed since start including loops
+    uint_t GetRegistersIndex(uint_t played) const
+    {
+      const uint_t size = Registers->Size();
+      const uint_t loop = Registers->Loop();
+      return played < size
+        ? played
+        : loop + (played - loop) % (size - loop);
+    }
+  };
+
+  class FixedTableParameters : public TrackParameters
+  {
+  public:
+    explicit FixedTableParameters(const FrequencyTable& table)
+      : Table(table)
+    {
+    }
+
+    uint_t Version() const override
+    {
+      return 1;
+    }
+
+    void FreqTable(FrequencyTable& table) const override
+    {
+      table = Table;
+    }
+
+    bool CacheData() const override
+    {
+      return false;
+    }
+  private:
+    const FrequencyTable Table;
+  };
+
+  /*
+    Tracker's state after loop may differ from the one at the first pass (e.g. sliding or envelope),
+    so loop passes are recorded till the registers output becomes the same as the previous pass.
+  */
+  const uint_t MAX_LOOP_PASSES = 4;
+
+  inline CachedTrack::Ptr CompileStream(const Chiptune& tune, const FrequencyTable& table)
+  {
+    const DataIterator::Ptr iterator = tune.CreateDataIterator(MakePtr<FixedTableParameters>(table));
+    const auto state = std::dynamic_pointer_cast<const TrackModelState>(iterator->GetStateObserver());
+    if (!state)
+    {
+      //not a tracker
+      return CachedTrack::Ptr();
+    }
+    const Information::Ptr info = tune.GetInformation();
+    const uint_t frames = info->FramesCount();
+    const uint_t loop = info->LoopFrame();
+    if (loop >= frames)
+    {
+      return CachedTrack::Ptr();
+    }
+    const auto result = std::make_shared<CachedTrack>();
+    result->Frames = frames;
+    result->Loop = loop;
+    const uint_t loopSize = frames - loop;
+    std::vector<Devices::AYM::Registers> data;
+    data.reserve(frames + loopSize);
+    for (uint_t frame = 0; frame != frames; ++frame)
+    {
+      if (!iterator->IsValid() || state->Frame() != frame)
+      {
+        Dbg("Unexpected frame %1% instead of %2%", state->Frame(), frame);
+        return CachedTrack::Ptr();
+      }
+      if (result->Lines.empty() || !result->Lines.back().Continues(*state))
+      {
+        const CachedTrack::LineState line = {frame, state->Quirk(), state->Position(), state->Pattern(), state->Line(), state->Tempo(),
+          state->PatternObject(), state->LineObject()};
+        result->Lines.push_back(line);
+      }
+      data.push_back(iterator->GetData());
+      iterator->NextFrame(true);
+    }
+    for (uint_t pass = 1; pass <= MAX_LOOP_PASSES; ++pass)
+    {
+      if (!iterator->IsValid() || state->Frame() != loop)
+      {
+        Dbg("Unexpected loop frame %1% instead of %2%", state->Frame(), loop);
+        return CachedTrack::Ptr();
+      }
+      for (uint_t frame = 0; frame != loopSize; ++frame)
+      {
+        data.push_back(iterator->GetData());
+        iterator->NextFrame(true);
+      }
+      const auto curPass = data.end() - loopSize;
+      const auto prevPass = curPass - loopSize;
+      if (std::equal(curPass, data.end(), prevPass, &IsSame))
+      {
+        data.erase(curPass, data.end());
+        Dbg("Cached %1% frames (loop pass %2%), %3% lines", data.size(), pass, result->Lines.size());
+        const StreamBuilder::Ptr builder = CreateStreamBuilder();
+        for (const auto& frame : data)
+        {
+          builder->AddFrame(frame);
+        }
+        builder->SetLoop(static_cast<uint_t>(data.size() - loopSize));
+        result->Registers = builder->CaptureResult();
+        result->Lines.shrink_to_fit();
+        return result;
+      }
+    }
+    Dbg("Loop is not stable after %1% passes, caching is not possible", MAX_LOOP_PASSES);
+    return CachedTrack::Ptr();
+  }
+
+  class RegistersCache
+  {
+  public:
+    typedef std::shared_ptr<RegistersCache> Ptr;
+    typedef std::shared_future<CachedTrack::Ptr> Result;
+
+    explicit RegistersCache(Chiptune::Ptr tune)
+      : Tune(std::move(tune))
+    {
+    }
+
+    //! @return result of compilation performed in background, empty pointer if caching is not possible
+    Result Get(const FrequencyTable& table)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      for (const auto& entry : Entries)
+      {
+        if (entry.first == table)
+        {
+          return entry.second;
+        }
+      }
+      const Chiptune::Ptr tune = Tune;
+      const Result result = std::async(std::launch::async, [tune, table]() {return CompileStream(*tune, table);}).share();
+      Entries.emplace_back(table, result);
+      return result;
+    }
+  private:
+    const Chiptune::Ptr Tune;
+    std::mutex Guard;
+    std::vector<std::pair<FrequencyTable, Result>> Entries;
+  };
+
+  inline bool IsReady(const RegistersCache::Result& result)
+  {
+    return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  //Reports delegate's state while playing live and recorded one while playing from cache
+  class CachedTrackState : public TrackModelState
+  {
+  public:
+    typedef std::shared_ptr<CachedTrackState> Ptr;
+
+    CachedTrackState(TrackModelState::Ptr delegate, RegistersCache::Ptr cache)
+      : Delegate(std::move(delegate))
+      , Cache(std::move(cache))
+      , Track()
+      , CurFrame()
+      , CurLine()
+    {
+    }
+
+    uint_t Position() const override
+    {
+      return Track ? GetLine().Position : Delegate->Position();
+    }
+
+    uint_t Pattern() const override
+    {
+      return Track ? GetLine().Pattern : Delegate->Pattern();
+    }
+
+    uint_t PatternSize() const override
+    {
+      return Track ? GetLine().PatternObject->GetSize() : Delegate->PatternSize();
+    }
+
+    uint_t Line() const override
+    {
+      return Track ? GetLine().Line : Delegate->Line();
+    }
+
+    uint_t Tempo() const override
+    {
+      return Track ? GetLine().Tempo : Delegate->Tempo();
+    }
+
+    uint_t Quirk() const override
+    {
+      return Track ? GetLine().Quirk + (CurFrame - GetLine().Frame) : Delegate->Quirk();
+    }
+
+    uint_t Frame() const override
+    {
+      return Track ? CurFrame : Delegate->Frame();
+    }
+
+    uint_t Channels() const override
+    {
+      if (Track)
+      {
+        const class Line* const line = GetLine().LineObject;
+        return line ? line->CountActiveChannels() : 0;
+      }
+      return Delegate->Channels();
+    }
+
+    const class Pattern* PatternObject() const override
+    {
+      return Track ? GetLine().PatternObject : Delegate->PatternObject();
+    }
+
+    const class Line* LineObject() const override
+    {
+      return Track ? GetLine().LineObject : Delegate->LineObject();
+    }
+
+    //! Start reporting recorded state from the delegate's position
+    void Attach(const CachedTrack* track)
+    {
+      if (!Track)
+      {
+        Seek(track, Delegate->Frame());
+      }
+      Track = track;
+    }
+
+    void Detach()
+    {
+      Track = nullptr;
+    }
+
+    bool IsValid() const
+    {
+      return CurFrame < Track->Frames;
+    }
+
+    void Reset()
+    {
+      CurFrame = 0;
+      CurLine = 0;
+    }
+
+    void NextFrame(bool looped)
+    {
+      if (++CurFrame == Track->Frames)
+      {
+        if (looped)
+        {
+          Seek(Track, Track->Loop);
+        }
+      }
+      else if (CurLine + 1 < Track->Lines.size() && Track->Lines[CurLine + 1].Frame == CurFrame)
+      {
+        ++CurLine;
+      }
+    }
+  private:
+    const CachedTrack::LineState& GetLine() const
+    {
+      return Track->Lines[CurLine];
+    }
+
+    void Seek(const CachedTrack* track, uint_t frame)
+    {
+      CurFrame = frame;
+      CurLine = track->FindLine(std::min(frame, track->Frames - 1));
+    }
+  private:
+    const TrackModelState::Ptr Delegate;
+    //keeps all the attached tracks alive while observed
+    const RegistersCache::Ptr Cache;
+    const CachedTrack* Track;
+    uint_t CurFrame;
+    std::size_t CurLine;
+  };
+
+  /*
+    Delegate is not touched while playing from cache, so its position is tracked separately.
+    Frequency table change keeps playing the current data till the new one is compiled.
+    Delegate is used only before the first compilation is finished or if caching is not possible.
+  */
+  class CachedDataIterator : public DataIterator
+  {
+  public:
+    CachedDataIterator(DataIterator::Ptr delegate, TrackModelState::Ptr state, TrackParameters::Ptr trackParams, RegistersCache::Ptr cache)
+      : Delegate(std::move(delegate))
+      , State(MakePtr<CachedTrackState>(std::move(state), cache))
+      , Params(std::move(trackParams))
+      , Cache(std::move(cache))
+      , Played()
+      , DelegatePlayed()
+    {
+    }
+
+    void Reset() override
+    {
+      if (!Data)
+      {
+        Delegate->Reset();
+        DelegatePlayed = 0;
+      }
+      State->Reset();
+      Played = 0;
+    }
+
+    bool IsValid() const override
+    {
+      return Data
+        ? State->IsValid()
+        : Delegate->IsValid();
+    }
+
+    void NextFrame(bool looped) override
+    {
+      if (!IsValid())
+      {
+        return;
+      }
+      ++Played;
+      if (Data)
+      {
+        State->NextFrame(looped);
+      }
+      else
+      {
+        Delegate->NextFrame(looped);
+        ++DelegatePlayed;
+      }
+    }
+
+    TrackState::Ptr GetStateObserver() const override
+    {
+      return State;
+    }
+
+    Devices::AYM::Registers GetData() const override
+    {
+      SynchronizeParameters();
+      if (!IsValid())
+      {
+        return Devices::AYM::Registers();
+      }
+      return Data
+        ? RegistersCursor->Get(Data->GetRegistersIndex(Played))
+        : Delegate->GetData();
+    }
+  private:
+    void SynchronizeParameters() const
+    {
+      if (Params.IsChanged())
+      {
+        FrequencyTable table = FrequencyTable();
+        Params->FreqTable(table);
+        Pending = Cache->Get(table);
+      }
+      if (Pending.valid() && IsReady(Pending))
+      {
+        const CachedTrack::Ptr newData = Pending.get();
+        Pending = RegistersCache::Result();
+        if (newData)
+        {
+          State->Attach(newData.get());
+        }
+        else if (Data)
+        {
+          State->Detach();
+          SeekDelegate();
+        }
+        Data = newData;
+        RegistersCursor = Data ? Data->Registers->CreateCursor() : StreamModel::Cursor::Ptr();
+      }
+    }
+
+    //delegate should reach the current position with all the data generated
+    void SeekDelegate() const
+    {
+      Dbg("Replay %1% frames from %2%", Played, DelegatePlayed);
+      if (DelegatePlayed > Played)
+      {
+        Delegate->Reset();
+        DelegatePlayed = 0;
+      }
+      for (; DelegatePlayed != Played && Delegate->IsValid(); ++DelegatePlayed)
+      {
+        Delegate->GetData();
+        Delegate->NextFrame(true);
+      }
+    }
+  private:
+    const DataIterator::Ptr Delegate;
+    const CachedTrackState::Ptr State;
+    Parameters::TrackingHelper<TrackParameters> Params;
+    const RegistersCache::Ptr Cache;
+    mutable RegistersCache::Result Pending;
+    mutable CachedTrack::Ptr Data;
+    mutable StreamModel::Cursor::Ptr RegistersCursor;
+    uint_t Played;
+    mutable uint_t DelegatePlayed;
+  };
+
+  class CachedChiptune : public Chiptune
+  {
+  public:
+    explicit CachedChiptune(Chiptune::Ptr delegate)
+      : Delegate(delegate)
+      , Cache(MakePtr<RegistersCache>(std::move(delegate)))
+    {
+    }
+
+    Information::Ptr GetInformation() const override
+    {
+      return Delegate->GetInformation();
+    }
+
+    Parameters::Accessor::Ptr GetProperties() const override
+    {
+      return Delegate->GetProperties();
+    }
+
+    DataIterator::Ptr CreateDataIterator(TrackParameters::Ptr trackParams) const override
+    {
+      DataIterator::Ptr iterator = Delegate->CreateDataIterator(trackParams);
+      if (trackParams->CacheData())
+      {
+        if (auto state = std::dynamic_pointer_cast<const TrackModelState>(iterator->GetStateObserver()))
+        {
+          return MakePtr<CachedDataIterator>(std::move(iterator), std::move(state), std::move(trackParams), Cache);
+        }
+      }
+      return iterator;
+    }
+  private:
+    const Chiptune::Ptr Delegate;
+    const RegistersCache::Ptr Cache;
+  };
+}
+}
+
+namespace Module
+{
+  namespace AYM
+  {
+    Chiptune::Ptr CreateCachedChiptune(Chiptune::Ptr delegate)
+    {
+      return MakePtr<CachedChiptune>(std::move(delegate));
+    }
+  }
+}
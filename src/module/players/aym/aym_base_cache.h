@@ -0,0 +1,24 @@
+/**
+* 
+* @file
+*
+* @brief  AYM-based chiptunes registers cache
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//local includes
+#include "aym_chiptune.h"
+
+namespace Module
+{
+  namespace AYM
+  {
+    //! @brief Records registers output of tracker-based chiptunes on first use (if enabled by track parameters)
+    //! and replays it later instead of tracker interpretation. Other chiptunes are passed as is.
+    Chiptune::Ptr CreateCachedChiptune(Chiptune::Ptr delegate);
+  }
+}
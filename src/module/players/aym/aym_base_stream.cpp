@@ -16,11 +16,262 @@
 #include <module/players/streaming.h>
 //std includes
 #include <utility>
+#include <vector>
 
 namespace Module
 {
   namespace AYM
   {
+    class RandomAccessCursor : public StreamModel::Cursor
+    {
+    public:
+      explicit RandomAccessCursor(const StreamModel& model)
+        : Model(model)
+      {
+      }
+
+      Devices::AYM::Registers Get(uint_t pos) override
+      {
+        return Model.Get(pos);
+      }
+    private:
+      const StreamModel& Model;
+    };
+
+    StreamModel::Cursor::Ptr StreamModel::CreateCursor() const
+    {
+      return Cursor::Ptr(new RandomAccessCursor(*this));
+    }
+
+    /*
+      Compact registers stream. Each frame is stored as
+        uint16_t header - mask of registers which values differ from the previous ones, WRITTEN_CHANGED flag
+        uint16_t written - mask of registers written in frame, only if WRITTEN_CHANGED is set
+        uint8_t values[] - for changed registers
+      Every KEY_PERIOD-th frame contains all the known registers values to allow random access.
+    */
+    class CompactStreamModel : public StreamModel
+    {
+    public:
+      CompactStreamModel(uint_t frames, uint_t loop, std::vector<uint32_t> keyOffsets, std::vector<uint8_t> data)
+        : Frames(frames)
+        , LoopFrame(loop)
+        , KeyOffsets(std::move(keyOffsets))
+        , Data(std::move(data))
+      {
+      }
+
+      uint_t Size() const override
+      {
+        return Frames;
+      }
+
+      uint_t Loop() const override
+      {
+        return LoopFrame;
+      }
+
+      Devices::AYM::Registers Get(uint_t pos) const override
+      {
+        return FramesCursor(*this).Get(pos);
+      }
+
+      Cursor::Ptr CreateCursor() const override
+      {
+        return Cursor::Ptr(new FramesCursor(*this));
+      }
+
+      static const uint_t KEY_PERIOD = 32;
+
+      class State
+      {
+      public:
+        State()
+          : Known()
+          , Written()
+          , Values()
+        {
+        }
+
+        void Encode(const Devices::AYM::Registers& regs, bool isKey, std::vector<uint8_t>& out)
+        {
+          uint_t written = 0;
+          uint_t changed = isKey ? Known : 0;
+          for (Devices::AYM::Registers::IndicesIterator it(regs); it; ++it)
+          {
+            const uint_t mask = 1 << *it;
+            const uint8_t val = regs[*it];
+            written |= mask;
+            if (0 == (Known & mask) || Values[*it] != val)
+            {
+              changed |= mask;
+              Values[*it] = val;
+            }
+          }
+          Known |= written;
+          const bool writeMask = isKey || written != Written;
+          Written = written;
+          PutWord(changed | (writeMask ? WRITTEN_CHANGED : 0), out);
+          if (writeMask)
+          {
+            PutWord(written, out);
+          }
+          for (uint_t reg = 0; reg != Devices::AYM::Registers::TOTAL; ++reg)
+          {
+            if (0 != (changed & (1 << reg)))
+            {
+              out.push_back(Values[reg]);
+            }
+          }
+        }
+
+        const uint8_t* Decode(const uint8_t* in)
+        {
+          const uint_t header = GetWord(in);
+          if (0 != (header & WRITTEN_CHANGED))
+          {
+            Written = GetWord(in);
+          }
+          for (uint_t reg = 0; reg != Devices::AYM::Registers::TOTAL; ++reg)
+          {
+            if (0 != (header & (1 << reg)))
+            {
+              Values[reg] = *in++;
+            }
+          }
+          return in;
+        }
+
+        Devices::AYM::Registers Get() const
+        {
+          Devices::AYM::Registers res;
+          for (uint_t reg = 0; reg != Devices::AYM::Registers::TOTAL; ++reg)
+          {
+            if (0 != (Written & (1 << reg)))
+            {
+              res[static_cast<Devices::AYM::Registers::Index>(reg)] = Values[reg];
+            }
+          }
+          return res;
+        }
+      private:
+        static const uint_t WRITTEN_CHANGED = 1 << Devices::AYM::Registers::TOTAL;
+
+        static void PutWord(uint_t val, std::vector<uint8_t>& out)
+        {
+          out.push_back(static_cast<uint8_t>(val & 0xff));
+          out.push_back(static_cast<uint8_t>(val >> 8));
+        }
+
+        static uint_t GetWord(const uint8_t*& in)
+        {
+          const uint_t res = in[0] | (uint_t(in[1]) << 8);
+          in += 2;
+          return res;
+        }
+      private:
+        uint_t Known;
+        uint_t Written;
+        uint8_t Values[Devices::AYM::Registers::TOTAL];
+      };
+    private:
+      //decodes forward from the last position, key frames are used only for backward or far forward moves
+      class FramesCursor : public Cursor
+      {
+      public:
+        explicit FramesCursor(const CompactStreamModel& model)
+          : Model(model)
+          , Position()
+          , Next()
+        {
+        }
+
+        Devices::AYM::Registers Get(uint_t pos) override
+        {
+          if (!Next || pos < Position || pos - Position > KEY_PERIOD)
+          {
+            Seek(pos / KEY_PERIOD);
+          }
+          for (; Position < pos; ++Position)
+          {
+            Next = Decoder.Decode(Next);
+          }
+          return Decoder.Get();
+        }
+      private:
+        void Seek(uint_t keyFrame)
+        {
+          Decoder = State();
+          Position = keyFrame * KEY_PERIOD;
+          Next = Decoder.Decode(Model.Data.data() + Model.KeyOffsets[keyFrame]);
+        }
+      private:
+        const CompactStreamModel& Model;
+        State Decoder;
+        //last decoded frame
+        uint_t Position;
+        const uint8_t* Next;
+      };
+    private:
+      const uint_t Frames;
+      const uint_t LoopFrame;
+      const std::vector<uint32_t> KeyOffsets;
+      const std::vector<uint8_t> Data;
+    };
+
+    class CompactStreamBuilder : public StreamBuilder
+    {
+    public:
+      CompactStreamBuilder()
+        : Frames()
+        , LoopFrame()
+      {
+      }
+
+      void AddFrame(const Devices::AYM::Registers& frame) override
+      {
+        const bool isKey = 0 == Frames % CompactStreamModel::KEY_PERIOD;
+        if (isKey)
+        {
+          KeyOffsets.push_back(static_cast<uint32_t>(Data.size()));
+        }
+        Encoder.Encode(frame, isKey, Data);
+        ++Frames;
+      }
+
+      void SetLoop(uint_t frame) override
+      {
+        LoopFrame = frame;
+      }
+
+      uint_t Size() const override
+      {
+        return Frames;
+      }
+
+      StreamModel::Ptr CaptureResult() override
+      {
+        if (!Frames)
+        {
+          return StreamModel::Ptr();
+        }
+        KeyOffsets.shrink_to_fit();
+        Data.shrink_to_fit();
+        const StreamModel::Ptr result = MakePtr<CompactStreamModel>(Frames, LoopFrame, std::move(KeyOffsets), std::move(Data));
+        Frames = LoopFrame = 0;
+        Encoder = CompactStreamModel::State();
+        KeyOffsets.clear();
+        Data.clear();
+        return result;
+      }
+    private:
+      uint_t Frames;
+      uint_t LoopFrame;
+      CompactStreamModel::State Encoder;
+      std::vector<uint32_t> KeyOffsets;
+      std::vector<uint8_t> Data;
+    };
+
     class StreamDataIterator : public DataIterator
     {
     public:
@@ -28,6 +279,7 @@ namespace Module
         : Delegate(std::move(delegate))
         , State(Delegate->GetStateObserver())
         , Data(std::move(data))
+        , Cursor(Data->CreateCursor())
       {
       }
 
@@ -54,13 +306,14 @@ namespace Module
       Devices::AYM::Registers GetData() const override
       {
         return Delegate->IsValid()
-          ? Data->Get(State->Frame())
+          ? Cursor->Get(State->Frame())
           : Devices::AYM::Registers();
       }
     private:
       const StateIterator::Ptr Delegate;
       const TrackState::Ptr State;
       const StreamModel::Ptr Data;
+      const StreamModel::Cursor::Ptr Cursor;
     };
 
     class StreamedChiptune : public Chiptune
@@ -94,6 +347,11 @@ namespace Module
       const Information::Ptr Info;
     };
 
+    StreamBuilder::Ptr CreateStreamBuilder()
+    {
+      return StreamBuilder::Ptr(new CompactStreamBuilder());
+    }
+
     Chiptune::Ptr CreateStreamedChiptune(StreamModel::Ptr model, Parameters::Accessor::Ptr properties)
     {
       return MakePtr<StreamedChiptune>(model, properties);
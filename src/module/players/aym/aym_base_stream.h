@@ -26,8 +26,38 @@ namespace Module
       virtual uint_t Size() const = 0;
       virtual uint_t Loop() const = 0;
       virtual Devices::AYM::Registers Get(uint_t pos) const = 0;
+
+      //! Keeps decoding state between calls, so sequential access is cheaper than random one
+      //! @note Should not outlive the model
+      class Cursor
+      {
+      public:
+        typedef std::unique_ptr<Cursor> Ptr;
+        virtual ~Cursor() = default;
+
+        virtual Devices::AYM::Registers Get(uint_t pos) = 0;
+      };
+
+      //! Default implementation performs random access for each call
+      virtual Cursor::Ptr CreateCursor() const;
+    };
+
+    //! Stores frames in compact delta-encoded form with periodic keyframes for random access
+    class StreamBuilder
+    {
+    public:
+      typedef std::unique_ptr<StreamBuilder> Ptr;
+      virtual ~StreamBuilder() = default;
+
+      virtual void AddFrame(const Devices::AYM::Registers& frame) = 0;
+      virtual void SetLoop(uint_t frame) = 0;
+      virtual uint_t Size() const = 0;
+      //! @return empty pointer if no frames were added
+      virtual StreamModel::Ptr CaptureResult() = 0;
     };
 
+    StreamBuilder::Ptr CreateStreamBuilder();
+
     Chiptune::Ptr CreateStreamedChiptune(StreamModel::Ptr model, Parameters::Accessor::Ptr properties);
   }
 }
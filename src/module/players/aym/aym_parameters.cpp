@@ -195,6 +195,13 @@ namespace AYM
     const Sound::RenderParameters::Ptr SoundParams;
   };
 
+  inline bool IsCacheEnabled(const Parameters::Accessor& params)
+  {
+    Parameters::IntType val = Parameters::ZXTune::Core::AYM::CACHE_DEFAULT;
+    params.FindValue(Parameters::ZXTune::Core::AYM::CACHE, val);
+    return val != 0;
+  }
+
   class AYTrackParameters : public TrackParameters
   {
   public:
@@ -230,6 +237,11 @@ namespace AYM
         }
       }
     }
+
+    bool CacheData() const override
+    {
+      return IsCacheEnabled(*Params);
+    }
   private:
     const Parameters::Accessor::Ptr Params;
   };
@@ -258,6 +270,11 @@ namespace AYM
         GetFreqTable(subName, table);
       }
     }
+
+    bool CacheData() const override
+    {
+      return IsCacheEnabled(*Params);
+    }
   private:
     /*
       ('a', 0) => 'a'
@@ -30,6 +30,7 @@ namespace Module
 
       virtual uint_t Version() const = 0;
       virtual void FreqTable(FrequencyTable& table) const = 0;
+      virtual bool CacheData() const = 0;
 
       static Ptr Create(Parameters::Accessor::Ptr params);
       static Ptr Create(Parameters::Accessor::Ptr params, uint_t idx);
@@ -203,6 +203,8 @@ namespace ProTracker2
     ModuleData::RWPtr Data;
   };
 
+  typedef TrackProbeBuilder<Formats::Chiptune::ProTracker2::StubBuilder, Formats::Chiptune::ProTracker2::Positions, SimpleOrderList> ProbeBuilder;
+
   const uint_t LIMITER = ~uint_t(0);
 
   inline uint_t GetVolume(uint_t volume, uint_t level)
@@ -462,9 +464,34 @@ namespace ProTracker2
     }
   };
 
+  class Prober : public Module::Prober
+  {
+  public:
+    Information::Ptr Probe(const Binary::Container& rawData, Parameters::Modifier& properties) const override
+    {
+      AYM::PropertiesHelper props(properties);
+      props.SetFrequencyTable(TABLE_PROTRACKER2);
+      ProbeBuilder dataBuilder(props);
+      if (const auto container = Formats::Chiptune::ProTracker2::Parse(rawData, dataBuilder))
+      {
+        props.SetSource(*container);
+        return CreateTrackInfo(dataBuilder.CaptureResult(), AYM::TRACK_CHANNELS);
+      }
+      else
+      {
+        return Information::Ptr();
+      }
+    }
+  };
+
   Factory::Ptr CreateFactory()
   {
     return MakePtr<Factory>();
   }
+
+  Module::Prober::Ptr CreateProber()
+  {
+    return MakePtr<Prober>();
+  }
 }
 }
@@ -22,6 +22,8 @@
 #include <module/players/simple_orderlist.h>
 //text includes
 #include <core/text/plugins.h>
+//std includes
+#include <mutex>
 
 namespace Module
 {
@@ -191,6 +193,43 @@ namespace ProTracker3
     ModuleData::RWPtr Data;
   };
 
+  class ProbeBuilder : public TrackProbeBuilder<Formats::Chiptune::ProTracker3::StubBuilder, Formats::Chiptune::ProTracker3::Positions, SimpleOrderList>
+  {
+  public:
+    explicit ProbeBuilder(AYM::PropertiesHelper& props)
+      : TrackProbeBuilder(props)
+      , Properties(props)
+      , Version()
+      , PatOffset(Formats::Chiptune::ProTracker3::SINGLE_AY_MODE)
+    {
+    }
+
+    void SetVersion(uint_t version) override
+    {
+      Properties.SetVersion(3, Version = version);
+    }
+
+    void SetNoteTable(Formats::Chiptune::ProTracker3::NoteTable table) override
+    {
+      const String freqTable = Vortex::GetFreqTable(static_cast<Vortex::NoteTable>(table), Version);
+      Properties.SetFrequencyTable(freqTable);
+    }
+
+    void SetMode(uint_t mode) override
+    {
+      PatOffset = mode;
+    }
+
+    uint_t GetPatOffset() const
+    {
+      return PatOffset;
+    }
+  private:
+    AYM::PropertiesHelper& Properties;
+    uint_t Version;
+    uint_t PatOffset;
+  };
+
   class StubLine : public Line
   {
     StubLine()
@@ -266,8 +305,10 @@ namespace ProTracker3
     {
     }
 
+    //lines are combined lazily during playback by renderers sharing the same module
     const Line* GetLine(uint_t row) const override
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       if (const auto cached = Lines.Get(row).get())
       {
         return cached;
@@ -287,6 +328,7 @@ namespace ProTracker3
   private:
     const Pattern& First;
     const Pattern& Second;
+    mutable std::mutex Guard;
     mutable SparsedObjectsStorage<TSLine::Ptr> Lines;
   };
 
@@ -301,6 +343,7 @@ namespace ProTracker3
 
     const Pattern* Get(uint_t idx) const override
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       if (const auto cached = Patterns.Get(idx).get())
       {
         return cached;
@@ -320,6 +363,7 @@ namespace ProTracker3
   private:
     const uint_t Base;
     const PatternsSet::Ptr Delegate;
+    mutable std::mutex Guard;
     mutable SparsedObjectsStorage<TSPattern::Ptr> Patterns;
   };
 
@@ -430,9 +474,48 @@ namespace ProTracker3
     const Formats::Chiptune::ProTracker3::Decoder::Ptr Decoder;
   };
 
+  class Prober : public Module::Prober
+  {
+  public:
+    explicit Prober(Formats::Chiptune::ProTracker3::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {
+    }
+
+    Information::Ptr Probe(const Binary::Container& rawData, Parameters::Modifier& properties) const override
+    {
+      AYM::PropertiesHelper props(properties);
+      ProbeBuilder dataBuilder(props);
+      if (const Formats::Chiptune::Container::Ptr container = Decoder->Parse(rawData, dataBuilder))
+      {
+        props.SetSource(*container);
+        const uint_t patOffset = dataBuilder.GetPatOffset();
+        auto modData = dataBuilder.CaptureResult();
+        if (patOffset != Formats::Chiptune::ProTracker3::SINGLE_AY_MODE)
+        {
+          props.SetComment(Text::PT3_TURBOSOUND_MODULE);
+          modData->Patterns = CreateTSPatterns(patOffset, std::move(modData->Patterns));
+          return CreateTrackInfo(std::move(modData), TurboSound::TRACK_CHANNELS);
+        }
+        else
+        {
+          return CreateTrackInfo(std::move(modData), AYM::TRACK_CHANNELS);
+        }
+      }
+      return Information::Ptr();
+    }
+  private:
+    const Formats::Chiptune::ProTracker3::Decoder::Ptr Decoder;
+  };
+
   Factory::Ptr CreateFactory(Formats::Chiptune::ProTracker3::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(decoder);
   }
+
+  Module::Prober::Ptr CreateProber(Formats::Chiptune::ProTracker3::Decoder::Ptr decoder)
+  {
+    return MakePtr<Prober>(decoder);
+  }
 }
 }
@@ -13,11 +13,13 @@
 //library includes
 #include <formats/chiptune/aym/protracker3.h>
 #include <module/players/factory.h>
+#include <module/players/prober.h>
 
 namespace Module
 {
   namespace ProTracker3
   {
     Factory::Ptr CreateFactory(Formats::Chiptune::ProTracker3::Decoder::Ptr decoder);
+    Prober::Ptr CreateProber(Formats::Chiptune::ProTracker3::Decoder::Ptr decoder);
   }
 }
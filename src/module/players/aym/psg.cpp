@@ -17,80 +17,86 @@
 //library includes
 #include <formats/chiptune/aym/psg.h>
 #include <module/players/properties_helper.h>
+#include <module/players/streaming.h>
 
 namespace Module
 {
 namespace PSG
 {
-  typedef std::vector<Devices::AYM::Registers> RegistersArray;
-
-  class StreamModel : public AYM::StreamModel
+  class DataBuilder : public Formats::Chiptune::PSG::Builder
   {
   public:
-    typedef std::shared_ptr<StreamModel> RWPtr;
-  
-    uint_t Size() const override
+    DataBuilder()
+      : Data(AYM::CreateStreamBuilder())
+      , HasFrame(false)
     {
-      return static_cast<uint_t>(Data.size());
     }
-
-    uint_t Loop() const override
+    
+    void AddChunks(std::size_t count) override
     {
-      return 0;
+      if (!count)
+      {
+        return;
+      }
+      FlushFrame();
+      const Devices::AYM::Registers empty;
+      for (std::size_t skip = 1; skip != count; ++skip)
+      {
+        Data->AddFrame(empty);
+      }
+      HasFrame = true;
     }
 
-    Devices::AYM::Registers Get(uint_t pos) const override
+    void SetRegister(uint_t reg, uint_t val) override
     {
-      return Data[pos];
+      if (reg < Devices::AYM::Registers::TOTAL && HasFrame)
+      {
+        Frame[static_cast<Devices::AYM::Registers::Index>(reg)] = val;
+      }
     }
-    
-    void Append(std::size_t count)
+
+    AYM::StreamModel::Ptr CaptureResult()
     {
-      Data.resize(Data.size() + count);
+      FlushFrame();
+      return Data->CaptureResult();
     }
-    
-    Devices::AYM::Registers* CurFrame()
+  private:
+    void FlushFrame()
     {
-      return Data.empty()
-        ? nullptr
-        : &Data.back();
+      if (HasFrame)
+      {
+        Data->AddFrame(Frame);
+        Frame = Devices::AYM::Registers();
+        HasFrame = false;
+      }
     }
   private:
-    RegistersArray Data;
+    const AYM::StreamBuilder::Ptr Data;
+    Devices::AYM::Registers Frame;
+    bool HasFrame;
   };
 
-  class DataBuilder : public Formats::Chiptune::PSG::Builder
+  class FramesCounter : public Formats::Chiptune::PSG::Builder
   {
   public:
-    DataBuilder()
-      : Data(MakeRWPtr<StreamModel>())
+    FramesCounter()
+      : Frames()
     {
     }
-    
+
     void AddChunks(std::size_t count) override
     {
-      Data->Append(count);
+      Frames += count;
     }
 
-    void SetRegister(uint_t reg, uint_t val) override
-    {
-      if (reg < Devices::AYM::Registers::TOTAL)
-      {
-        if (Devices::AYM::Registers* regs = Data->CurFrame())
-        {
-          (*regs)[static_cast<Devices::AYM::Registers::Index>(reg)] = val;
-        }
-      }
-    }
+    void SetRegister(uint_t /*reg*/, uint_t /*val*/) override {}
 
-    AYM::StreamModel::Ptr GetResult() const
+    uint_t GetFramesCount() const
     {
-      return Data->Size()
-        ? Data
-        : AYM::StreamModel::Ptr();
+      return static_cast<uint_t>(Frames);
     }
   private:
-    const StreamModel::RWPtr Data;
+    std::size_t Frames;
   };
 
   class Factory : public AYM::Factory
@@ -101,7 +107,7 @@ namespace PSG
       DataBuilder dataBuilder;
       if (const Formats::Chiptune::Container::Ptr container = Formats::Chiptune::PSG::Parse(rawData, dataBuilder))
       {
-        if (const AYM::StreamModel::Ptr data = dataBuilder.GetResult())
+        if (const AYM::StreamModel::Ptr data = dataBuilder.CaptureResult())
         {
           PropertiesHelper props(*properties);
           props.SetSource(*container);
@@ -112,9 +118,33 @@ namespace PSG
     }
   };
 
+  class Prober : public Module::Prober
+  {
+  public:
+    Information::Ptr Probe(const Binary::Container& rawData, Parameters::Modifier& properties) const override
+    {
+      FramesCounter counter;
+      if (const Formats::Chiptune::Container::Ptr container = Formats::Chiptune::PSG::Parse(rawData, counter))
+      {
+        if (const uint_t frames = counter.GetFramesCount())
+        {
+          PropertiesHelper props(properties);
+          props.SetSource(*container);
+          return CreateStreamInfo(frames);
+        }
+      }
+      return Information::Ptr();
+    }
+  };
+
   Factory::Ptr CreateFactory()
   {
     return MakePtr<Factory>();
   }
+
+  Module::Prober::Ptr CreateProber()
+  {
+    return MakePtr<Prober>();
+  }
 }
 }
@@ -12,11 +12,14 @@
 
 //local includes
 #include "aym_factory.h"
+//library includes
+#include <module/players/prober.h>
 
 namespace Module
 {
   namespace PSG
   {
     AYM::Factory::Ptr CreateFactory();
+    Prober::Ptr CreateProber();
   }
 }
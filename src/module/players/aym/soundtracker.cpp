@@ -157,6 +157,8 @@ namespace SoundTracker
     ModuleData::RWPtr Data;
   };
 
+  typedef TrackProbeBuilder<Formats::Chiptune::SoundTracker::StubBuilder, Formats::Chiptune::SoundTracker::Positions, OrderListWithTransposition> ProbeBuilder;
+
   class ChannelBuilder
   {
   public:
@@ -552,9 +554,41 @@ namespace SoundTracker
     const Formats::Chiptune::SoundTracker::Decoder::Ptr Decoder;
   };
 
+  class Prober : public Module::Prober
+  {
+  public:
+    explicit Prober(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {
+    }
+
+    Information::Ptr Probe(const Binary::Container& rawData, Parameters::Modifier& properties) const override
+    {
+      AYM::PropertiesHelper props(properties);
+      props.SetFrequencyTable(TABLE_SOUNDTRACKER);
+      ProbeBuilder dataBuilder(props);
+      if (const auto container = Decoder->Parse(rawData, dataBuilder))
+      {
+        props.SetSource(*container);
+        return CreateTrackInfo(dataBuilder.CaptureResult(), AYM::TRACK_CHANNELS);
+      }
+      else
+      {
+        return Information::Ptr();
+      }
+    }
+  private:
+    const Formats::Chiptune::SoundTracker::Decoder::Ptr Decoder;
+  };
+
   Factory::Ptr CreateFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(decoder);
   }
+
+  Module::Prober::Ptr CreateProber(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder)
+  {
+    return MakePtr<Prober>(decoder);
+  }
 }
 }
@@ -14,11 +14,13 @@
 #include "aym_factory.h"
 //library includes
 #include <formats/chiptune/aym/soundtracker.h>
+#include <module/players/prober.h>
 
 namespace Module
 {
   namespace SoundTracker
   {
     AYM::Factory::Ptr CreateFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder);
+    Prober::Ptr CreateProber(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder);
   }
 }                                                     
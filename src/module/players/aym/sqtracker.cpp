@@ -21,6 +21,7 @@
 #include <module/players/properties_meta.h>
 #include <module/players/simple_orderlist.h>
 //std includes
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 //boost includes
@@ -128,22 +129,20 @@ namespace SQTracker
       return 0;
     }
 
+    //model is shared between renderers of the same module
     const OrderList& GetOrder() const override
     {
-      if (!FlatOrder)
-      {
-        FlatOrder = CreateFlatOrderlist();
-      }
+      std::call_once(FlatOrderCreated, [this]() {FlatOrder = CreateFlatOrderlist();});
       return *FlatOrder;
     }
 
     const PatternsSet& GetPatterns() const override
     {
-      if (!FlatPatterns)
+      std::call_once(FlatPatternsCreated, [this]()
       {
         FlatPatterns = CreateFlatPatterns(GetOrder());
         RawPatterns = PatternsSet::Ptr();
-      }
+      });
       return *FlatPatterns;
     }
 
@@ -371,7 +370,9 @@ namespace SQTracker
       return tempoAddon;
     }
   private:
+    mutable std::once_flag FlatOrderCreated;
     mutable OrderList::Ptr FlatOrder;
+    mutable std::once_flag FlatPatternsCreated;
     mutable PatternsSet::Ptr FlatPatterns;
   };
 
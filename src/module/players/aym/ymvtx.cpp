@@ -16,8 +16,12 @@
 //common includes
 #include <make_ptr.h>
 //library includes
+#include <binary/container_factories.h>
 #include <core/core_parameters.h>
+#include <debug/log.h>
+#include <module/players/streaming.h>
 //std includes
+#include <mutex>
 #include <utility>
 //boost includes
 #include <boost/lexical_cast.hpp>
@@ -26,47 +30,7 @@ namespace Module
 {
 namespace YMVTX
 {
-  typedef std::vector<Devices::AYM::Registers> RegistersArray;
-
-  class StreamModel : public AYM::StreamModel
-  {
-  public:
-    typedef std::shared_ptr<StreamModel> RWPtr;
-    
-    StreamModel()
-      : LoopFrame(0)
-    {
-    }
-
-    uint_t Size() const override
-    {
-      return static_cast<uint_t>(Data.size());
-    }
-
-    uint_t Loop() const override
-    {
-      return LoopFrame;
-    }
-
-    Devices::AYM::Registers Get(uint_t pos) const override
-    {
-      return Data[pos];
-    }
-    
-    void SetLoop(uint_t frame)
-    {
-      LoopFrame = frame;
-    }
-    
-    Devices::AYM::Registers& Allocate()
-    {
-      Data.push_back(Devices::AYM::Registers());
-      return Data.back();
-    }
-  private:
-    uint_t LoopFrame;
-    RegistersArray Data;
-  };
+  const Debug::Stream Dbg("Core::YMSupp");
 
   Devices::AYM::LayoutType VtxMode2AymLayout(uint_t mode)
   {
@@ -93,12 +57,89 @@ namespace YMVTX
     }
   }
 
-  class DataBuilder : public Formats::Chiptune::YM::Builder
+  class FramesBuilder : public Formats::Chiptune::YM::Builder
+  {
+  public:
+    explicit FramesBuilder(AYM::StreamBuilder::Ptr data)
+      : Data(std::move(data))
+      , Frames()
+      , LoopFrame()
+    {
+    }
+
+    void SetVersion(const String& /*version*/) override {}
+    void SetChipType(bool /*ym*/) override {}
+    void SetStereoMode(uint_t /*mode*/) override {}
+
+    void SetLoop(uint_t loop) override
+    {
+      LoopFrame = loop;
+    }
+
+    void SetDigitalSample(uint_t /*idx*/, const Dump& /*data*/) override
+    {
+      //TODO:
+    }
+
+    void SetClockrate(uint64_t /*freq*/) override {}
+    void SetIntFreq(uint_t /*freq*/) override {}
+    void SetTitle(const String& /*title*/) override {}
+    void SetAuthor(const String& /*author*/) override {}
+    void SetComment(const String& /*comment*/) override {}
+    void SetYear(uint_t /*year*/) override {}
+
+    void SetProgram(const String& /*program*/) override
+    {
+      //TODO
+    }
+
+    void SetEditor(const String& /*editor*/) override {}
+
+    void SetFrames(std::size_t count) override
+    {
+      Frames = static_cast<uint_t>(count);
+    }
+
+    void AddData(const Dump& registers) override
+    {
+      if (Data)
+      {
+        Devices::AYM::Registers data;
+        const uint_t availRegs = std::min<uint_t>(registers.size(), Devices::AYM::Registers::ENV + 1);
+        for (uint_t reg = 0; reg != availRegs; ++reg)
+        {
+          const uint8_t val = registers[reg];
+          if (reg != Devices::AYM::Registers::ENV || val != 0xff)
+          {
+            data[static_cast<Devices::AYM::Registers::Index>(reg)] = val;
+          }
+        }
+        Data->AddFrame(data);
+      }
+    }
+
+    uint_t GetFramesCount() const
+    {
+      return Frames;
+    }
+
+    uint_t GetLoopFrame() const
+    {
+      return LoopFrame;
+    }
+  private:
+    const AYM::StreamBuilder::Ptr Data;
+    uint_t Frames;
+    uint_t LoopFrame;
+  };
+
+  //! Collects properties and frames count only, data is decoded separately
+  class DataBuilder : public FramesBuilder
   {
   public:
     explicit DataBuilder(AYM::PropertiesHelper& props)
-      : Properties(props)
-      , Data(MakeRWPtr<StreamModel>())
+      : FramesBuilder(AYM::StreamBuilder::Ptr())
+      , Properties(props)
     {
     }
 
@@ -117,16 +158,6 @@ namespace YMVTX
       Properties.SetChannelsLayout(VtxMode2AymLayout(mode));
     }
 
-    void SetLoop(uint_t loop) override
-    {
-      Data->SetLoop(loop);
-    }
-
-    void SetDigitalSample(uint_t /*idx*/, const Dump& /*data*/) override
-    {
-      //TODO:
-    }
-
     void SetClockrate(uint64_t freq) override
     {
       Properties.SetChipFrequency(freq);
@@ -160,41 +191,87 @@ namespace YMVTX
       }
     }
 
-    void SetProgram(const String& /*program*/) override
+    void SetEditor(const String& editor) override
     {
-      //TODO
+      Properties.SetProgram(editor);
     }
+  private:
+    AYM::PropertiesHelper& Properties;
+  };
 
-    void SetEditor(const String& editor) override
+  AYM::StreamModel::Ptr DecodeStream(const Formats::Chiptune::YM::Decoder& decoder, const Binary::Container& data, uint_t frames)
+  {
+    AYM::StreamBuilder::Ptr stream = AYM::CreateStreamBuilder();
+    AYM::StreamBuilder& target = *stream;
+    FramesBuilder builder(std::move(stream));
+    if (!decoder.Parse(data, builder))
     {
-      Properties.SetProgram(editor);
+      Dbg("Failed to decode stream data");
+    }
+    //keep track structure consistent with the one got at module creation
+    const Devices::AYM::Registers empty;
+    while (target.Size() < frames)
+    {
+      target.AddFrame(empty);
     }
+    target.SetLoop(builder.GetLoopFrame());
+    return target.CaptureResult();
+  }
 
-    void AddData(const Dump& registers) override
+  /*
+    Keeps packed source data and decodes it on renderer creation, so modules that are not played
+    (e.g. in big playlists) do not waste memory for unpacked registers dump and playback thread never decodes.
+  */
+  class LazyStreamedChiptune : public AYM::Chiptune
+  {
+  public:
+    LazyStreamedChiptune(Formats::Chiptune::YM::Decoder::Ptr decoder, const Binary::Container& data, uint_t frames, uint_t loop, Parameters::Accessor::Ptr properties)
+      : Decoder(std::move(decoder))
+      , Data(Binary::CreateContainer(data.Start(), data.Size()))
+      , Frames(frames)
+      , Properties(std::move(properties))
+      , Info(CreateStreamInfo(frames, loop))
     {
-      Devices::AYM::Registers& data = Data->Allocate();
-      const uint_t availRegs = std::min<uint_t>(registers.size(), Devices::AYM::Registers::ENV + 1);
-      for (uint_t reg = 0, mask = 1; reg != availRegs; ++reg, mask <<= 1)
-      {
-        const uint8_t val = registers[reg];
-        if (reg != Devices::AYM::Registers::ENV || val != 0xff)
-        {
-          data[static_cast<Devices::AYM::Registers::Index>(reg)] = val;
-        }
-      }
     }
 
-    AYM::StreamModel::Ptr GetResult() const
+    Information::Ptr GetInformation() const override
+    {
+      return Info;
+    }
+
+    Parameters::Accessor::Ptr GetProperties() const override
     {
-      return Data->Size()
-        ? Data
-        : AYM::StreamModel::Ptr();
+      return Properties;
+    }
+
+    AYM::DataIterator::Ptr CreateDataIterator(AYM::TrackParameters::Ptr trackParams) const override
+    {
+      std::call_once(Decoded, &LazyStreamedChiptune::Decode, this);
+      return Delegate->CreateDataIterator(std::move(trackParams));
     }
   private:
-    AYM::PropertiesHelper& Properties;
-    const StreamModel::RWPtr Data;
+    void Decode() const
+    {
+      Dbg("Decode %1% frames on demand", Frames);
+      Delegate = AYM::CreateStreamedChiptune(DecodeStream(*Decoder, *Data, Frames), Properties);
+      Data.reset();
+    }
+  private:
+    const Formats::Chiptune::YM::Decoder::Ptr Decoder;
+    mutable Binary::Container::Ptr Data;
+    const uint_t Frames;
+    const Parameters::Accessor::Ptr Properties;
+    const Information::Ptr Info;
+    mutable std::once_flag Decoded;
+    mutable AYM::Chiptune::Ptr Delegate;
   };
 
+  //! Unpacked registers dump is always bigger than compact representation
+  inline bool IsPacked(const Binary::Container& data, uint_t frames)
+  {
+    return data.Size() < std::size_t(frames) * Devices::AYM::Registers::TOTAL;
+  }
+
   class Factory : public AYM::Factory
   {
   public:
@@ -207,12 +284,14 @@ namespace YMVTX
     {
       AYM::PropertiesHelper props(*properties);
       DataBuilder dataBuilder(props);
-      if (const Formats::Chiptune::Container::Ptr container = Decoder->Parse(rawData, dataBuilder))
+      if (const Formats::Chiptune::Container::Ptr container = Decoder->ParseHeader(rawData, dataBuilder))
       {
-        if (const AYM::StreamModel::Ptr data = dataBuilder.GetResult())
+        if (const uint_t frames = dataBuilder.GetFramesCount())
         {
           props.SetSource(*container);
-          return AYM::CreateStreamedChiptune(data, properties);
+          return IsPacked(*container, frames)
+            ? MakePtr<LazyStreamedChiptune>(Decoder, *container, frames, dataBuilder.GetLoopFrame(), properties)
+            : AYM::CreateStreamedChiptune(DecodeStream(*Decoder, *container, frames), properties);
         }
       }
       return AYM::Chiptune::Ptr();
@@ -221,9 +300,40 @@ namespace YMVTX
     const Formats::Chiptune::YM::Decoder::Ptr Decoder;
   };
 
+  class Prober : public Module::Prober
+  {
+  public:
+    explicit Prober(Formats::Chiptune::YM::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {
+    }
+
+    Information::Ptr Probe(const Binary::Container& rawData, Parameters::Modifier& properties) const override
+    {
+      AYM::PropertiesHelper props(properties);
+      DataBuilder dataBuilder(props);
+      if (const Formats::Chiptune::Container::Ptr container = Decoder->ParseHeader(rawData, dataBuilder))
+      {
+        if (const uint_t frames = dataBuilder.GetFramesCount())
+        {
+          props.SetSource(*container);
+          return CreateStreamInfo(frames, dataBuilder.GetLoopFrame());
+        }
+      }
+      return Information::Ptr();
+    }
+  private:
+    const Formats::Chiptune::YM::Decoder::Ptr Decoder;
+  };
+
   Factory::Ptr CreateFactory(Formats::Chiptune::YM::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(decoder);
   }
+
+  Module::Prober::Ptr CreateProber(Formats::Chiptune::YM::Decoder::Ptr decoder)
+  {
+    return MakePtr<Prober>(decoder);
+  }
 }
 }
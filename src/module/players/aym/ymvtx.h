@@ -14,11 +14,13 @@
 #include "aym_factory.h"
 //library includes
 #include <formats/chiptune/aym/ym.h>
+#include <module/players/prober.h>
 
 namespace Module
 {
   namespace YMVTX
   {
     AYM::Factory::Ptr CreateFactory(Formats::Chiptune::YM::Decoder::Ptr decoder);
+    Prober::Ptr CreateProber(Formats::Chiptune::YM::Decoder::Ptr decoder);
   }
 }
@@ -23,6 +23,8 @@
 #include <sound/chunk_builder.h>
 #include <sound/render_params.h>
 #include <sound/sound_parameters.h>
+//std includes
+#include <mutex>
 //3rdparty
 #include <3rdparty/hvl/hvl_replay.h>
 
@@ -80,19 +82,13 @@ namespace AHX
 
     uint_t FramesCount() const override
     {
-      if (!CachedFramesCount)
-      {
-        FillCache();
-      }
+      std::call_once(CacheFilled, &Information::FillCache, this);
       return CachedFramesCount;
     }
 
     uint_t LoopFrame() const override
     {
-      if (!CachedLoopFrame)
-      {
-        FillCache();
-      }
+      std::call_once(CacheFilled, &Information::FillCache, this);
       return CachedLoopFrame;
     }
     
@@ -120,6 +116,7 @@ namespace AHX
     }
   private:
     const HvlPtr Hvl;
+    mutable std::once_flag CacheFilled;
     mutable uint_t CachedFramesCount;
     mutable uint_t CachedLoopFrame;
   };
@@ -0,0 +1,598 @@
+/**
+*
+* @file
+*
+* @brief  Playback end detection implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "end_detector.h"
+#include "aym/aym_base.h"
+#include "aym/aym_parameters.h"
+//common includes
+#include <make_ptr.h>
+//library includes
+#include <debug/log.h>
+#include <devices/beeper.h>
+#include <sound/render_params.h>
+#include <sound/sound_parameters.h>
+//std includes
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  const Debug::Stream Dbg("Module::EndDetector");
+
+  //about -54dB
+  const Sound::Sample::WideType SILENCE_THRESHOLD = 64;
+
+  //longest period of repeated output to detect
+  const Parameters::IntType MAX_REPEAT_PERIOD_US = Parameters::IntType(10) * 60 * 1000000;
+}
+
+namespace Module
+{
+  //per-frame summary of rendered output
+  class FrameFingerprint
+  {
+  public:
+    FrameFingerprint()
+    {
+      Reset();
+    }
+
+    void Reset()
+    {
+      Hash = HASH_BASIS;
+      Empty = true;
+      std::fill(std::begin(Min), std::end(Min), Sound::Sample::MAX);
+      std::fill(std::begin(Max), std::end(Max), Sound::Sample::MIN);
+    }
+
+    void Add(const Sound::Chunk& chunk)
+    {
+      for (const auto& smp : chunk)
+      {
+        const Sound::Sample::WideType left = smp.Left();
+        const Sound::Sample::WideType right = smp.Right();
+        Hash = (Hash ^ (uint32_t(uint16_t(left)) | (uint32_t(uint16_t(right)) << 16))) * HASH_PRIME;
+        Min[0] = std::min(Min[0], left);
+        Max[0] = std::max(Max[0], left);
+        Min[1] = std::min(Min[1], right);
+        Max[1] = std::max(Max[1], right);
+      }
+      Empty = Empty && chunk.empty();
+    }
+
+    //frame described by the state of sound source instead of rendered output
+    void Add(uint64_t stateHash, bool audible)
+    {
+      Hash = (Hash ^ stateHash) * HASH_PRIME;
+      for (uint_t chan = 0; chan != Sound::Sample::CHANNELS; ++chan)
+      {
+        Min[chan] = audible ? Sound::Sample::MIN : std::min<Sound::Sample::WideType>(Min[chan], Sound::Sample::MID);
+        Max[chan] = audible ? Sound::Sample::MAX : std::max<Sound::Sample::WideType>(Max[chan], Sound::Sample::MID);
+      }
+      Empty = false;
+    }
+
+    bool IsEmpty() const
+    {
+      return Empty;
+    }
+
+    uint64_t GetHash() const
+    {
+      return Hash;
+    }
+
+    //silent frame is the one with the level close to constant
+    bool IsSilent(Sound::Sample::WideType threshold) const
+    {
+      return Max[0] - Min[0] <= threshold && Max[1] - Min[1] <= threshold;
+    }
+
+    Sound::Sample::WideType GetLevel(uint_t channel) const
+    {
+      return (Min[channel] + Max[channel]) / 2;
+    }
+  private:
+    static const uint64_t HASH_BASIS = UINT64_C(14695981039346656037);
+    static const uint64_t HASH_PRIME = UINT64_C(1099511628211);
+    uint64_t Hash;
+    bool Empty;
+    Sound::Sample::WideType Min[Sound::Sample::CHANNELS];
+    Sound::Sample::WideType Max[Sound::Sample::CHANNELS];
+  };
+
+  class SilenceDetector
+  {
+  public:
+    explicit SilenceDetector(uint_t limit)
+      : Limit(limit)
+      , Frames()
+    {
+      std::fill(std::begin(Level), std::end(Level), Sound::Sample::MID);
+    }
+
+    void Reset()
+    {
+      Frames = 0;
+    }
+
+    bool Detect(const FrameFingerprint& frame)
+    {
+      if (!Limit)
+      {
+        return false;
+      }
+      if (!frame.IsSilent(SILENCE_THRESHOLD))
+      {
+        Frames = 0;
+        return false;
+      }
+      if (Frames == 0 || !IsSameLevel(frame))
+      {
+        Frames = 0;
+        Level[0] = frame.GetLevel(0);
+        Level[1] = frame.GetLevel(1);
+      }
+      return ++Frames >= Limit;
+    }
+  private:
+    bool IsSameLevel(const FrameFingerprint& frame) const
+    {
+      return std::abs(frame.GetLevel(0) - Level[0]) <= SILENCE_THRESHOLD
+          && std::abs(frame.GetLevel(1) - Level[1]) <= SILENCE_THRESHOLD;
+    }
+  private:
+    const uint_t Limit;
+    uint_t Frames;
+    Sound::Sample::WideType Level[Sound::Sample::CHANNELS];
+  };
+
+  //detects window of specified frames count with output already rendered before using rolling hash of frames hashes.
+  //Only repeats with period up to specified one are detected, so history is kept in the ring buffer of fixed size
+  class RepeatDetector
+  {
+  public:
+    RepeatDetector(uint_t window, uint_t maxPeriod)
+      : Window(window)
+      , MaxPeriod(maxPeriod)
+      , WindowFactor(1)
+      , WindowHash()
+      , SilentFrames()
+      , Frames()
+      , History(window ? window + maxPeriod : 0)
+    {
+      for (uint_t idx = 0; idx != Window; ++idx)
+      {
+        WindowFactor *= HASH_FACTOR;
+      }
+    }
+
+    void Reset()
+    {
+      Windows.clear();
+      WindowHash = 0;
+      SilentFrames = 0;
+      Frames = 0;
+    }
+
+    bool Detect(const FrameFingerprint& frame, bool silent)
+    {
+      if (!Window)
+      {
+        return false;
+      }
+      const std::size_t idx = Frames++;
+      if (idx > MaxPeriod)
+      {
+        ForgetWindow(idx - MaxPeriod - 1);
+      }
+      WindowHash = WindowHash * HASH_FACTOR + frame.GetHash();
+      SilentFrames += silent;
+      if (idx >= Window)
+      {
+        const Entry& out = GetEntry(idx - Window);
+        WindowHash -= out.Hash * WindowFactor;
+        SilentFrames -= out.Silent;
+      }
+      Entry& entry = GetEntry(idx);
+      entry.Hash = frame.GetHash();
+      entry.WindowHash = WindowHash;
+      entry.Silent = silent;
+      //silence is not a loop
+      if (idx + 1 < Window || SilentFrames == Window)
+      {
+        return false;
+      }
+      const auto res = Windows.emplace(WindowHash, idx);
+      if (res.second)
+      {
+        return false;
+      }
+      const std::size_t prevIdx = res.first->second;
+      if (IsSameWindow(prevIdx, idx))
+      {
+        Dbg("Output is repeated with period of %1% frames", idx - prevIdx);
+        return true;
+      }
+      res.first->second = idx;
+      return false;
+    }
+  private:
+    struct Entry
+    {
+      Entry()
+        : Hash()
+        , WindowHash()
+        , Silent()
+      {
+      }
+
+      uint64_t Hash;
+      uint64_t WindowHash;
+      bool Silent;
+    };
+
+    Entry& GetEntry(std::size_t idx)
+    {
+      return History[idx % History.size()];
+    }
+
+    const Entry& GetEntry(std::size_t idx) const
+    {
+      return History[idx % History.size()];
+    }
+
+    //window ending at specified frame is too far to be the start of detected period
+    void ForgetWindow(std::size_t idx)
+    {
+      const auto it = Windows.find(GetEntry(idx).WindowHash);
+      if (it != Windows.end() && it->second == idx)
+      {
+        Windows.erase(it);
+      }
+    }
+
+    bool IsSameWindow(std::size_t lhEnd, std::size_t rhEnd) const
+    {
+      for (uint_t frame = 0; frame != Window; ++frame)
+      {
+        if (GetEntry(lhEnd - frame).Hash != GetEntry(rhEnd - frame).Hash)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  private:
+    static const uint64_t HASH_FACTOR = UINT64_C(0x100000001b3);
+    const uint_t Window;
+    const uint_t MaxPeriod;
+    uint64_t WindowFactor;
+    uint64_t WindowHash;
+    uint_t SilentFrames;
+    std::size_t Frames;
+    std::vector<Entry> History;
+    std::unordered_map<uint64_t, std::size_t> Windows;
+  };
+
+  class EndDetector : public Sound::Receiver
+  {
+  public:
+    typedef std::shared_ptr<EndDetector> Ptr;
+
+    EndDetector(uint_t silenceFrames, uint_t repeatFrames, uint_t maxRepeatPeriod, Sound::Receiver::Ptr target)
+      : Silence(silenceFrames)
+      , Repeat(repeatFrames, maxRepeatPeriod)
+      , Target(std::move(target))
+    {
+    }
+
+    void ApplyData(Sound::Chunk::Ptr chunk) override
+    {
+      Frame.Add(*chunk);
+      Target->ApplyData(std::move(chunk));
+    }
+
+    void ApplyState(uint64_t stateHash, bool audible)
+    {
+      Frame.Add(stateHash, audible);
+    }
+
+    void Flush() override
+    {
+      Target->Flush();
+    }
+
+    void Reset()
+    {
+      Frame.Reset();
+      Silence.Reset();
+      Repeat.Reset();
+    }
+
+    //@return true if playback should be stopped
+    bool FinishFrame()
+    {
+      if (Frame.IsEmpty())
+      {
+        return false;
+      }
+      const bool silenceEnd = Silence.Detect(Frame);
+      const bool repeatEnd = Repeat.Detect(Frame, Frame.IsSilent(SILENCE_THRESHOLD));
+      Frame.Reset();
+      return silenceEnd || repeatEnd;
+    }
+  private:
+    FrameFingerprint Frame;
+    SilenceDetector Silence;
+    RepeatDetector Repeat;
+    const Sound::Receiver::Ptr Target;
+  };
+
+  //Tracks AY/beeper registers instead of sound synthesis. Frame is considered audible if any
+  //channel produces tone, noise, running envelope or its level is changed
+  class ChipsState : public Devices::AYM::Device
+                   , public Devices::Beeper::Device
+  {
+  public:
+    typedef std::shared_ptr<ChipsState> Ptr;
+
+    explicit ChipsState(uint64_t clockFreq)
+      : ClockFreq(clockFreq)
+    {
+      Reset();
+    }
+
+    void RenderData(const Devices::AYM::DataChunk& src) override
+    {
+      Apply(src);
+    }
+
+    void RenderData(const std::vector<Devices::AYM::DataChunk>& src) override
+    {
+      for (const auto& chunk : src)
+      {
+        Apply(chunk);
+      }
+    }
+
+    void RenderData(const std::vector<Devices::Beeper::DataChunk>& src) override
+    {
+      for (const auto& chunk : src)
+      {
+        if (chunk.Level != BeeperLevel)
+        {
+          BeeperLevel = chunk.Level;
+          Hash = (Hash ^ (BeeperLevel ? BEEPER_ON : BEEPER_OFF)) * HASH_PRIME;
+          LevelChanged = true;
+        }
+      }
+    }
+
+    void Reset() override
+    {
+      State.fill(0);
+      EnvelopeStart = LastTime = Devices::AYM::Stamp();
+      BeeperLevel = false;
+      Hash = HASH_BASIS;
+      LevelChanged = false;
+    }
+
+    void FinishFrame(EndDetector& detector)
+    {
+      detector.ApplyState(Hash, LevelChanged || IsAudible());
+      Hash = HASH_BASIS;
+      LevelChanged = false;
+    }
+  private:
+    void Apply(const Devices::AYM::DataChunk& chunk)
+    {
+      using namespace Devices::AYM;
+      LastTime = chunk.TimeStamp;
+      for (Registers::IndicesIterator it(chunk.Data); it; ++it)
+      {
+        const Registers::Index reg = *it;
+        const uint8_t val = chunk.Data[reg];
+        if (reg == Registers::ENV)
+        {
+          EnvelopeStart = chunk.TimeStamp;
+        }
+        else if (reg >= Registers::VOLA && reg <= Registers::VOLC && val != State[reg])
+        {
+          LevelChanged = true;
+        }
+        State[reg] = val;
+        Hash = (Hash ^ ((reg << 8) | val)) * HASH_PRIME;
+      }
+    }
+
+    bool IsAudible() const
+    {
+      using namespace Devices::AYM;
+      for (uint_t chan = 0; chan != 3; ++chan)
+      {
+        const uint_t vol = State[Registers::VOLA + chan];
+        const uint_t disabled = (Registers::MASK_TONEA | Registers::MASK_NOISEA) << chan;
+        if (0 != (vol & Registers::MASK_ENV)
+          ? IsEnvelopeRunning()
+          : 0 != (vol & Registers::MASK_VOL) && disabled != (State[Registers::MIXER] & disabled))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    //single-cycle envelopes keep constant level after the first period
+    bool IsEnvelopeRunning() const
+    {
+      using namespace Devices::AYM;
+      const uint_t shape = State[Registers::ENV] & 0x0f;
+      if ((shape & 0x09) == 0x08)
+      {
+        return true;
+      }
+      const uint64_t period = 256 * std::max<uint_t>(1, State[Registers::TONEE_L] | (State[Registers::TONEE_H] << 8));
+      const uint64_t elapsed = LastTime.Get() - EnvelopeStart.Get();
+      return elapsed * ClockFreq < period * Devices::AYM::Stamp::PER_SECOND;
+    }
+  private:
+    static const uint64_t HASH_BASIS = UINT64_C(14695981039346656037);
+    static const uint64_t HASH_PRIME = UINT64_C(1099511628211);
+    static const uint64_t BEEPER_ON = 0x10000;
+    static const uint64_t BEEPER_OFF = 0x20000;
+    const uint64_t ClockFreq;
+    std::array<uint8_t, Devices::AYM::Registers::TOTAL> State;
+    Devices::AYM::Stamp EnvelopeStart;
+    Devices::AYM::Stamp LastTime;
+    bool BeeperLevel;
+    uint64_t Hash;
+    bool LevelChanged;
+  };
+
+  class EndDetectingRenderer : public Renderer
+  {
+  public:
+    EndDetectingRenderer(Renderer::Ptr delegate, EndDetector::Ptr detector, ChipsState::Ptr state)
+      : Delegate(std::move(delegate))
+      , Detector(std::move(detector))
+      , State(std::move(state))
+    {
+    }
+
+    TrackState::Ptr GetTrackState() const override
+    {
+      return Delegate->GetTrackState();
+    }
+
+    Analyzer::Ptr GetAnalyzer() const override
+    {
+      return Delegate->GetAnalyzer();
+    }
+
+    bool RenderFrame() override
+    {
+      const bool result = Delegate->RenderFrame();
+      if (State)
+      {
+        State->FinishFrame(*Detector);
+      }
+      if (Detector->FinishFrame())
+      {
+        Dbg("Stop at frame %1%", Delegate->GetTrackState()->Frame());
+        return false;
+      }
+      return result;
+    }
+
+    void Reset() override
+    {
+      Delegate->Reset();
+      Detector->Reset();
+    }
+
+    void SetPosition(uint_t frame) override
+    {
+      Delegate->SetPosition(frame);
+      Detector->Reset();
+    }
+  private:
+    const Renderer::Ptr Delegate;
+    const EndDetector::Ptr Detector;
+    const ChipsState::Ptr State;
+  };
+
+  uint_t GetLimitInFrames(const Parameters::Accessor& params, const Parameters::NameType& name, Parameters::IntType frameDuration)
+  {
+    Parameters::IntType limit = 0;
+    params.FindValue(name, limit);
+    return limit > 0
+      ? static_cast<uint_t>((limit + frameDuration - 1) / frameDuration)
+      : 0;
+  }
+
+  //@return empty pointer if end detection is not required
+  EndDetector::Ptr CreateEndDetector(Parameters::Accessor::Ptr params, Sound::Receiver::Ptr target)
+  {
+    using namespace Parameters::ZXTune::Sound;
+    const Sound::RenderParameters::Ptr renderParams = Sound::RenderParameters::Create(params);
+    const Parameters::IntType frameDuration = renderParams->FrameDuration().Get();
+    const uint_t silenceFrames = GetLimitInFrames(*params, SILENCE_LIMIT, frameDuration);
+    const uint_t repeatFrames = renderParams->Looped() ? 0 : GetLimitInFrames(*params, REPEAT_LIMIT, frameDuration);
+    if (!silenceFrames && !repeatFrames)
+    {
+      return EndDetector::Ptr();
+    }
+    const uint_t maxRepeatPeriod = static_cast<uint_t>(MAX_REPEAT_PERIOD_US / frameDuration);
+    Dbg("Detect end after %1% silent frames or %2% repeated frames with period up to %3%", silenceFrames, repeatFrames, maxRepeatPeriod);
+    return MakePtr<EndDetector>(silenceFrames, repeatFrames, maxRepeatPeriod, std::move(target));
+  }
+
+  Renderer::Ptr CreateEndDetectingRenderer(const Holder& holder, Parameters::Accessor::Ptr params, Sound::Receiver::Ptr target)
+  {
+    if (const EndDetector::Ptr detector = CreateEndDetector(params, target))
+    {
+      return MakePtr<EndDetectingRenderer>(holder.CreateRenderer(params, detector), detector, ChipsState::Ptr());
+    }
+    return holder.CreateRenderer(params, target);
+  }
+
+  Renderer::Ptr CreateFastForwardEndDetectingRenderer(const Holder& holder, Parameters::Accessor::Ptr params)
+  {
+    const AYM::Holder* const aymHolder = dynamic_cast<const AYM::Holder*>(&holder);
+    if (!aymHolder)
+    {
+      return Renderer::Ptr();
+    }
+    const EndDetector::Ptr detector = CreateEndDetector(params, Sound::Receiver::CreateStub());
+    if (!detector)
+    {
+      return Renderer::Ptr();
+    }
+    Dbg("Detect end by chips state");
+    const ChipsState::Ptr state = MakePtr<ChipsState>(AYM::CreateChipParameters(params)->ClockFreq());
+    return MakePtr<EndDetectingRenderer>(aymHolder->CreateRenderer(params, state), detector, state);
+  }
+
+  class EndDetectingHolder : public Holder
+  {
+  public:
+    explicit EndDetectingHolder(Holder::Ptr delegate)
+      : Delegate(std::move(delegate))
+    {
+    }
+
+    Information::Ptr GetModuleInformation() const override
+    {
+      return Delegate->GetModuleInformation();
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Delegate->GetModuleProperties();
+    }
+
+    Renderer::Ptr CreateRenderer(Parameters::Accessor::Ptr params, Sound::Receiver::Ptr target) const override
+    {
+      return CreateEndDetectingRenderer(*Delegate, std::move(params), std::move(target));
+    }
+  private:
+    const Holder::Ptr Delegate;
+  };
+
+  Holder::Ptr CreateEndDetectingHolder(Holder::Ptr delegate)
+  {
+    return MakePtr<EndDetectingHolder>(std::move(delegate));
+  }
+}
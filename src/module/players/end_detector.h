@@ -0,0 +1,29 @@
+/**
+*
+* @file
+*
+* @brief  Playback end detection by rendered output
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <module/holder.h>
+
+namespace Module
+{
+  //! @brief Creates renderer which stops on sustained silence or exactly repeated output
+  //! @note Limits are taken from Parameters::ZXTune::Sound::SILENCE_LIMIT and Parameters::ZXTune::Sound::REPEAT_LIMIT.
+  //!       Holder's renderer is returned as is if both are not set
+  Renderer::Ptr CreateEndDetectingRenderer(const Holder& holder, Parameters::Accessor::Ptr params, Sound::Receiver::Ptr target);
+
+  //! @brief Creates renderer which detects end by sound chips registers state without sound synthesis (fast-forward)
+  //! @return Empty pointer if module is not AY/YM-based or limits are not set
+  Renderer::Ptr CreateFastForwardEndDetectingRenderer(const Holder& holder, Parameters::Accessor::Ptr params);
+
+  //! @brief Creates holder with renderers made by CreateEndDetectingRenderer, so players and converters can stop early
+  Holder::Ptr CreateEndDetectingHolder(Holder::Ptr delegate);
+}
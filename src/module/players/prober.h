@@ -0,0 +1,112 @@
+/**
+*
+* @file
+*
+* @brief  Module metadata prober interface and helpers
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//local includes
+#include "properties_meta.h"
+#include "tracking.h"
+//common includes
+#include <make_ptr.h>
+//library includes
+#include <binary/container.h>
+#include <module/information.h>
+#include <parameters/modifier.h>
+
+namespace Module
+{
+  //! @brief Extracts module metadata without building the whole playback model
+  class Prober
+  {
+  public:
+    typedef std::shared_ptr<const Prober> Ptr;
+    virtual ~Prober() = default;
+
+    //! @return Module information or empty pointer if data is not matched. Module properties are stored to properties
+    virtual Information::Ptr Probe(const Binary::Container& data, Parameters::Modifier& properties) const = 0;
+  };
+
+  //! @brief Track model with order and patterns structure only, enough to calculate duration
+  //! @note Patterns are expected to be built using PatternsBuilder::Create<0>() to store lines tempo only
+  class TrackProbeModel : public TrackModel
+  {
+  public:
+    typedef std::shared_ptr<const TrackProbeModel> Ptr;
+    typedef std::shared_ptr<TrackProbeModel> RWPtr;
+
+    TrackProbeModel()
+      : InitialTempo()
+    {
+    }
+
+    uint_t GetInitialTempo() const override
+    {
+      return InitialTempo;
+    }
+
+    const OrderList& GetOrder() const override
+    {
+      return *Order;
+    }
+
+    const PatternsSet& GetPatterns() const override
+    {
+      return *Patterns;
+    }
+
+    uint_t InitialTempo;
+    OrderList::Ptr Order;
+    PatternsSet::Ptr Patterns;
+  };
+
+  //! @brief Format builder collecting metadata, tempo, order and lines tempo of patterns. The rest is skipped by StubBuilderType
+  template<class StubBuilderType, class PositionsType, class OrderListType>
+  class TrackProbeBuilder : public StubBuilderType
+  {
+  public:
+    explicit TrackProbeBuilder(PropertiesHelper& props)
+      : Meta(props)
+      , Patterns(PatternsBuilder::Create<0>())
+      , Data(MakeRWPtr<TrackProbeModel>())
+    {
+    }
+
+    Formats::Chiptune::MetaBuilder& GetMetaBuilder() override
+    {
+      return Meta;
+    }
+
+    void SetInitialTempo(uint_t tempo) override
+    {
+      Data->InitialTempo = tempo;
+    }
+
+    void SetPositions(PositionsType positions) override
+    {
+      Data->Order = MakePtr<OrderListType>(positions.Loop, std::move(positions.Lines));
+    }
+
+    Formats::Chiptune::PatternBuilder& StartPattern(uint_t index) override
+    {
+      Patterns.SetPattern(index);
+      return Patterns;
+    }
+
+    TrackProbeModel::RWPtr CaptureResult()
+    {
+      Data->Patterns = Patterns.CaptureResult();
+      return std::move(Data);
+    }
+  private:
+    MetaProperties Meta;
+    PatternsBuilder Patterns;
+    TrackProbeModel::RWPtr Data;
+  };
+}
@@ -47,6 +47,13 @@ namespace TFM
     {
       return SoundParams->SoundFreq();
     }
+
+    Devices::FM::EngineType Engine() const override
+    {
+      Parameters::IntType intVal = Parameters::ZXTune::Core::FM::ENGINE_DEFAULT;
+      Params->FindValue(Parameters::ZXTune::Core::FM::ENGINE, intVal);
+      return static_cast<Devices::FM::EngineType>(intVal);
+    }
   private:
     const Parameters::Accessor::Ptr Params;
     const Sound::RenderParameters::Ptr SoundParams;
@@ -19,6 +19,8 @@
 #include <module/players/properties_helper.h>
 #include <module/players/properties_meta.h>
 #include <module/players/simple_orderlist.h>
+//std includes
+#include <mutex>
 
 namespace Module
 {
@@ -1495,10 +1497,11 @@ namespace TFMMusicMaker
   private:
     void Initialize() const
     {
-      if (Frames)
-      {
-        return;//initialized
-      }
+      std::call_once(Initialized, &InformationImpl::Calculate, this);
+    }
+
+    void Calculate() const
+    {
       TrackStateCursor cursor(Data);
       cursor.Seek(Data->Order->GetLoopPosition());
       LoopFrameNum = cursor.GetState().Frame;
@@ -1507,6 +1510,7 @@ namespace TFMMusicMaker
     }
   private:
     const ModuleData::Ptr Data;
+    mutable std::once_flag Initialized;
     mutable uint_t Frames;
     mutable uint_t LoopFrameNum;
   };
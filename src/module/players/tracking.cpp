@@ -13,6 +13,8 @@
 //common includes
 #include <pointers.h>
 #include <make_ptr.h>
+//std includes
+#include <mutex>
 
 namespace Module
 {
@@ -341,12 +343,14 @@ namespace Module
       return Model->GetInitialTempo();
     }
   private:
+    //information is shared between renderers of the same module
     void Initialize() const
     {
-      if (Frames)
-      {
-        return;//initialized
-      }
+      std::call_once(Initialized, &InformationImpl::Calculate, this);
+    }
+
+    void Calculate() const
+    {
       TrackStateCursor cursor(Model);
       cursor.Seek(Model->GetOrder().GetLoopPosition());
       LoopFrameNum = cursor.GetState().Frame;
@@ -356,6 +360,7 @@ namespace Module
   private:
     const TrackModel::Ptr Model;
     const uint_t Channels;
+    mutable std::once_flag Initialized;
     mutable uint_t Frames;
     mutable uint_t LoopFrameNum;
   };
@@ -0,0 +1,22 @@
+/**
+*
+* @file
+*
+* @brief  Flat parameters snapshot factory
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <parameters/accessor.h>
+
+namespace Parameters
+{
+  //! @brief Collapse all the values visible through accessor (e.g. merged chain) into single immutable storage
+  //! @note Lookups are performed by interned names identifiers. Snapshot keeps version of source at the moment
+  //!       of creation and is not affected by subsequent changes, so should be used only for unchanged sources
+  Accessor::Ptr CreateSnapshot(const Accessor& source);
+}
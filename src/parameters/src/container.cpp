@@ -13,20 +13,40 @@
 //library includes
 #include <parameters/container.h>
 //std includes
-#include <map>
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace Parameters
 {
   template<class T>
-  bool FindByName(const std::map<NameType, T>& map, const NameType& name, T& res)
+  bool FindByName(const std::unordered_map<NameType, T>& map, const NameType& name, T& res)
   {
-    const typename std::map<NameType, T>::const_iterator it = map.find(name);
+    const typename std::unordered_map<NameType, T>::const_iterator it = map.find(name);
     return it != map.end()
       ? (res = it->second, true)
       : false;
   }
 
+  //values are visited in names order
+  template<class T>
+  void ProcessByName(const std::unordered_map<NameType, T>& map, Visitor& visitor)
+  {
+    typedef typename std::unordered_map<NameType, T>::const_pointer EntryPtr;
+    std::vector<EntryPtr> entries;
+    entries.reserve(map.size());
+    for (const auto& entry : map)
+    {
+      entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](EntryPtr lh, EntryPtr rh) {return lh->first < rh->first;});
+    for (const auto entry : entries)
+    {
+      visitor.SetValue(entry->first, entry->second);
+    }
+  }
+
   class StorageContainer : public Container
   {
   public:
@@ -58,18 +78,9 @@ namespace Parameters
 
     void Process(Visitor& visitor) const override
     {
-      for (const auto& i : Integers)
-      {
-        visitor.SetValue(i.first, i.second);
-      }
-      for (const auto& s : Strings)
-      {
-        visitor.SetValue(s.first, s.second);
-      }
-      for (const auto& d : Datas)
-      {
-        visitor.SetValue(d.first, d.second);
-      }
+      ProcessByName(Integers, visitor);
+      ProcessByName(Strings, visitor);
+      ProcessByName(Datas, visitor);
     }
 
     //visitor virtuals
@@ -127,9 +138,10 @@ namespace Parameters
     }
   private:
     uint_t VersionValue;
-    typedef std::map<NameType, IntType> IntegerMap;
-    typedef std::map<NameType, StringType> StringMap;
-    typedef std::map<NameType, DataType> DataMap;
+    //names are hashed by interned identifiers
+    typedef std::unordered_map<NameType, IntType> IntegerMap;
+    typedef std::unordered_map<NameType, StringType> StringMap;
+    typedef std::unordered_map<NameType, DataType> DataMap;
     IntegerMap Integers;
     StringMap Strings;
     DataMap Datas;
@@ -14,7 +14,7 @@
 #include <parameters/merged_accessor.h>
 #include <parameters/visitor.h>
 //std includes
-#include <set>
+#include <unordered_set>
 #include <utility>
 
 namespace Parameters
@@ -52,9 +52,9 @@ namespace Parameters
     }
   private:
     Visitor& Delegate;
-    std::set<NameType> DoneIntegers;
-    std::set<NameType> DoneStrings;
-    std::set<NameType> DoneDatas;
+    std::unordered_set<NameType> DoneIntegers;
+    std::unordered_set<NameType> DoneStrings;
+    std::unordered_set<NameType> DoneDatas;
   };
 
   class DoubleAccessor : public Accessor
@@ -0,0 +1,161 @@
+/**
+*
+* @file
+*
+* @brief  Flat parameters snapshot implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//common includes
+#include <make_ptr.h>
+//library includes
+#include <parameters/snapshot.h>
+#include <parameters/visitor.h>
+//std includes
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Parameters
+{
+  //values are kept in order of source visiting, lookup is performed via index sorted by names identifiers
+  template<class T>
+  class FlatStorage
+  {
+  public:
+    void Add(const NameType& name, T val)
+    {
+      Index.push_back(std::make_pair(name.Id(), static_cast<uint_t>(Values.size())));
+      Values.emplace_back(name, std::move(val));
+    }
+
+    void Seal()
+    {
+      std::sort(Index.begin(), Index.end());
+    }
+
+    bool Find(const NameType& name, T& res) const
+    {
+      if (const NameType::IdType id = name.Id())
+      {
+        //stored name may be not interned
+        return Find(id, name, res) || Find(0, name, res);
+      }
+      //names without identifiers are compared by value with any stored one
+      for (const auto& val : Values)
+      {
+        if (val.first == name)
+        {
+          res = val.second;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void Process(Visitor& visitor) const
+    {
+      for (const auto& val : Values)
+      {
+        visitor.SetValue(val.first, val.second);
+      }
+    }
+  private:
+    bool Find(NameType::IdType id, const NameType& name, T& res) const
+    {
+      for (auto it = std::lower_bound(Index.begin(), Index.end(), std::make_pair(id, uint_t(0))); it != Index.end() && it->first == id; ++it)
+      {
+        const std::pair<NameType, T>& val = Values[it->second];
+        if (val.first == name)
+        {
+          res = val.second;
+          return true;
+        }
+      }
+      return false;
+    }
+  private:
+    std::vector<std::pair<NameType::IdType, uint_t> > Index;
+    std::vector<std::pair<NameType, T> > Values;
+  };
+
+  class SnapshotAccessor : public Accessor
+  {
+  public:
+    explicit SnapshotAccessor(const Accessor& source)
+      : VersionValue(source.Version())
+    {
+      Builder builder(*this);
+      source.Process(builder);
+      Integers.Seal();
+      Strings.Seal();
+      Datas.Seal();
+    }
+
+    uint_t Version() const override
+    {
+      return VersionValue;
+    }
+
+    bool FindValue(const NameType& name, IntType& val) const override
+    {
+      return Integers.Find(name, val);
+    }
+
+    bool FindValue(const NameType& name, StringType& val) const override
+    {
+      return Strings.Find(name, val);
+    }
+
+    bool FindValue(const NameType& name, DataType& val) const override
+    {
+      return Datas.Find(name, val);
+    }
+
+    void Process(Visitor& visitor) const override
+    {
+      Integers.Process(visitor);
+      Strings.Process(visitor);
+      Datas.Process(visitor);
+    }
+  private:
+    //merged sources visit every name only once with the most prioritized value
+    class Builder : public Visitor
+    {
+    public:
+      explicit Builder(SnapshotAccessor& target)
+        : Target(target)
+      {
+      }
+
+      void SetValue(const NameType& name, IntType val) override
+      {
+        Target.Integers.Add(name, val);
+      }
+
+      void SetValue(const NameType& name, const StringType& val) override
+      {
+        Target.Strings.Add(name, val);
+      }
+
+      void SetValue(const NameType& name, const DataType& val) override
+      {
+        Target.Datas.Add(name, val);
+      }
+    private:
+      SnapshotAccessor& Target;
+    };
+  private:
+    const uint_t VersionValue;
+    FlatStorage<IntType> Integers;
+    FlatStorage<StringType> Strings;
+    FlatStorage<DataType> Datas;
+  };
+
+  Accessor::Ptr CreateSnapshot(const Accessor& source)
+  {
+    return MakePtr<SnapshotAccessor>(source);
+  }
+}
@@ -0,0 +1,78 @@
+/**
+*
+* @file
+*
+* @brief  Parameters names interning implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//library includes
+#include <parameters/types.h>
+//std includes
+#include <atomic>
+#include <memory>
+
+namespace Parameters
+{
+  //Insert-only open addressing hash table with lock-free lookups and insertions.
+  //Zero-initialized static storage, so it's ready before any static name construction.
+  //Names are never released, but their count is limited. Names not fitting the table are not interned.
+  class NamesTable
+  {
+  public:
+    static NameType::IdType Get(const std::string& path, std::size_t hash)
+    {
+      if (path.empty())
+      {
+        return 0;
+      }
+      std::unique_ptr<std::string> created;
+      for (std::size_t probe = 0; probe != MAX_PROBES; ++probe)
+      {
+        const std::size_t idx = (hash + probe) & (CAPACITY - 1);
+        std::atomic<const std::string*>& slot = Slots[idx];
+        const std::string* existing = slot.load(std::memory_order_acquire);
+        if (!existing)
+        {
+          if (Used.load(std::memory_order_relaxed) >= MAX_NAMES)
+          {
+            return 0;
+          }
+          if (!created)
+          {
+            created.reset(new std::string(path));
+          }
+          if (slot.compare_exchange_strong(existing, created.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+          {
+            created.release();
+            Used.fetch_add(1, std::memory_order_relaxed);
+            return static_cast<NameType::IdType>(idx + 1);
+          }
+          //taken by concurrent insertion, existing is updated
+        }
+        if (*existing == path)
+        {
+          return static_cast<NameType::IdType>(idx + 1);
+        }
+      }
+      return 0;
+    }
+  private:
+    static const std::size_t CAPACITY = 16384;
+    //keep probes sequences short
+    static const std::size_t MAX_NAMES = CAPACITY * 3 / 4;
+    static const std::size_t MAX_PROBES = 64;
+    static std::atomic<const std::string*> Slots[CAPACITY];
+    static std::atomic<std::size_t> Used;
+  };
+
+  std::atomic<const std::string*> NamesTable::Slots[NamesTable::CAPACITY];
+  std::atomic<std::size_t> NamesTable::Used;
+
+  NameType::IdType NameType::Intern(const std::string& path, std::size_t hash)
+  {
+    return NamesTable::Get(path, hash);
+  }
+}
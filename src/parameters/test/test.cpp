@@ -8,9 +8,14 @@
 *
 **/
 
+#include <parameters/container.h>
+#include <parameters/merged_accessor.h>
+#include <parameters/snapshot.h>
 #include <parameters/types.h>
+#include <parameters/visitor.h>
 
 #include <iostream>
+#include <vector>
 
 namespace
 {
@@ -104,6 +109,102 @@ int main()
     Test("three - three", (three - three).FullPath(), std::string());
     Test("three.Name", three.Name(), std::string("three"));
   }
+  std::cout << "---- Test for Parameters::NameType identifiers" << std::endl;
+  {
+    using namespace Parameters;
+    const NameType zero{};
+    const NameType one("one");
+    const NameType two("one.two");
+    Test("zero.Id", zero.Id(), NameType::IdType(0));
+    Test("one.Id != zero.Id", one.Id() != zero.Id(), true);
+    Test("one.Id != two.Id", one.Id() != two.Id(), true);
+    Test("one.Id == NameType(one).Id", one.Id() == NameType("one").Id(), true);
+    Test("two == one + two", two == one + "two", true);
+    Test("empty.Id", NameType(std::string()).Id(), NameType::IdType(0));
+    Test("zero == empty", zero == NameType(std::string()) && zero.Hash() == NameType(std::string()).Hash(), true);
+  }
+  std::cout << "---- Test for Parameters::CreateSnapshot" << std::endl;
+  {
+    using namespace Parameters;
+    const NameType intName("int");
+    const NameType strName("str");
+    const NameType dataName("data");
+    const NameType otherName("other");
+    const NameType missedName("missed");
+    const Container::Ptr first = Container::Create();
+    const Container::Ptr second = Container::Create();
+    first->SetValue(intName, IntType(1));
+    first->SetValue(strName, String("first"));
+    second->SetValue(intName, IntType(2));
+    second->SetValue(otherName, IntType(3));
+    second->SetValue(dataName, DataType(2, 0xaa));
+    const Accessor::Ptr merged = CreateMergedAccessor(first, second);
+    const Accessor::Ptr snapshot = CreateSnapshot(*merged);
+    IntType intVal = 0;
+    StringType strVal;
+    DataType dataVal;
+    Test("snapshot.Version", snapshot->Version(), merged->Version());
+    Test("snapshot prioritized int", snapshot->FindValue(intName, intVal) && intVal == 1, true);
+    Test("snapshot int", snapshot->FindValue(otherName, intVal) && intVal == 3, true);
+    Test("snapshot str", snapshot->FindValue(strName, strVal) && strVal == "first", true);
+    Test("snapshot data", snapshot->FindValue(dataName, dataVal) && dataVal.size() == 2, true);
+    Test("snapshot missed", snapshot->FindValue(missedName, intVal), false);
+    Test("snapshot wrong type", snapshot->FindValue(strName, intVal), false);
+    first->SetValue(intName, IntType(4));
+    Test("snapshot is immutable", snapshot->FindValue(intName, intVal) && intVal == 1, true);
+  }
+  //should be the last one since names table is exhausted
+  std::cout << "---- Test for Parameters::NameType without identifiers" << std::endl;
+  {
+    using namespace Parameters;
+    const NameType interned("interned");
+    const Container::Ptr container = Container::Create();
+    std::vector<NameType> names;
+    for (uint_t idx = 0; idx != 20000; ++idx)
+    {
+      names.push_back(NameType("exhaust." + std::to_string(idx)));
+      container->SetValue(names.back(), IntType(idx));
+    }
+    const NameType& last = names.back();
+    const NameType sameLast(last.FullPath());
+    Test("last.Id", last.Id(), NameType::IdType(0));
+    Test("last == same", last == sameLast, true);
+    Test("last.Hash == same.Hash", last.Hash() == sameLast.Hash(), true);
+    Test("last != previous", last != names[names.size() - 2], true);
+    Test("interned is kept", interned.Id() != 0 && interned.Id() == NameType("interned").Id(), true);
+    IntType intVal = 0;
+    Test("container lookup", container->FindValue(sameLast, intVal) && intVal == 19999, true);
+    const Accessor::Ptr snapshot = CreateSnapshot(*container);
+    Test("snapshot lookup", snapshot->FindValue(sameLast, intVal) && intVal == 19999, true);
+    Test("snapshot lookup of interned", snapshot->FindValue(names.front(), intVal) && intVal == 0, true);
+    class OrderChecker : public Visitor
+    {
+    public:
+      OrderChecker()
+        : Ordered(true)
+      {
+      }
+
+      void SetValue(const NameType& name, IntType /*val*/) override
+      {
+        Ordered = Ordered && !(name < Previous);
+        Previous = name;
+      }
+
+      void SetValue(const NameType& /*name*/, const StringType& /*val*/) override
+      {
+      }
+
+      void SetValue(const NameType& /*name*/, const DataType& /*val*/) override
+      {
+      }
+
+      bool Ordered;
+      NameType Previous;
+    } checker;
+    container->Process(checker);
+    Test("visited in names order", checker.Ordered, true);
+  }
   }
   catch (int code)
   {
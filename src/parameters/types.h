@@ -12,6 +12,8 @@
 
 //common includes
 #include <types.h>
+//std includes
+#include <functional>
 
 //! @brief Namespace is used to keep parameters-working related types and functions
 namespace Parameters
@@ -36,15 +38,27 @@ namespace Parameters
   const String::value_type DATA_PREFIX = '#';
   //@}
 
+  //! @brief Dotted parameter name with interned identifier
   class NameType
   {
     //! @brief Delimiter between namespaces in parameters' names
     static const char NAMESPACE_DELIMITER = '.';
   public:
-    NameType() = default;
+    //! @brief Process-wide identifier of the name. Different paths always have different identifiers.
+    //! Empty names and ones appeared when names table is near exhaustion have 0,
+    //! so equal paths may have either 0 or the same non-zero identifier
+    typedef uint_t IdType;
+
+    NameType()
+      : PathHash()
+      , Identifier()
+    {
+    }
 
     /*explicit*/NameType(std::string path)
       : Path(std::move(path))
+      , PathHash(Path.empty() ? 0 : std::hash<std::string>()(Path))
+      , Identifier(Intern(Path, PathHash))
     {
     }
 
@@ -55,12 +69,25 @@ namespace Parameters
 
     bool operator == (const NameType& rh) const
     {
-      return Path == rh.Path;
+      return Identifier && rh.Identifier
+        ? Identifier == rh.Identifier
+        : PathHash == rh.PathHash && Path == rh.Path;
     }
 
     bool operator != (const NameType& rh) const
     {
-      return Path != rh.Path;
+      return !(*this == rh);
+    }
+
+    IdType Id() const
+    {
+      return Identifier;
+    }
+
+    //! @brief Does not depend on identifier, so equal names have equal hashes
+    std::size_t Hash() const
+    {
+      return PathHash;
     }
 
     bool IsEmpty() const
@@ -123,7 +150,23 @@ namespace Parameters
         ? Path.substr(lastDelim + 1)
         : Path;
     }
+  private:
+    static IdType Intern(const std::string& path, std::size_t hash);
   private:
     std::string Path;
+    std::size_t PathHash;
+    IdType Identifier;
+  };
+}
+
+namespace std
+{
+  template<>
+  struct hash<Parameters::NameType>
+  {
+    std::size_t operator()(const Parameters::NameType& name) const
+    {
+      return name.Hash();
+    }
   };
 }
@@ -0,0 +1,33 @@
+/**
+*
+* @file
+*
+* @brief  Linux implementation of memory usage tools
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//library includes
+#include <platform/tools.h>
+//platform includes
+#include <sys/resource.h>
+
+namespace Platform
+{
+  uint64_t GetPeakMemoryUsage()
+  {
+    struct rusage usage;
+    if (0 != ::getrusage(RUSAGE_SELF, &usage))
+    {
+      return 0;
+    }
+#ifdef __APPLE__
+    //in bytes
+    return usage.ru_maxrss;
+#else
+    //in kilobytes
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+  }
+}
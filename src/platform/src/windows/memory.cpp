@@ -0,0 +1,27 @@
+/**
+*
+* @file
+*
+* @brief  Windows implementation of memory usage tools
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//library includes
+#include <platform/tools.h>
+//platform includes
+#include <windows.h>
+#include <psapi.h>
+
+namespace Platform
+{
+  uint64_t GetPeakMemoryUsage()
+  {
+    PROCESS_MEMORY_COUNTERS counters;
+    counters.cb = sizeof(counters);
+    return ::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))
+      ? counters.PeakWorkingSetSize
+      : 0;
+  }
+}
@@ -16,4 +16,7 @@
 namespace Platform
 {
   std::string GetCurrentImageFilename();
+
+  //! @return Peak resident memory size of current process in bytes, 0 if not available
+  uint64_t GetPeakMemoryUsage();
 }
@@ -79,14 +79,16 @@ namespace File
     {
     }
 
-    String Instantiate(const Module::TrackState& state) const
+    //called on every frame, so result buffer is reused and updated only when tracked values are changed
+    const String& Instantiate(const Module::TrackState& state) const
     {
-      if (CurPosition.Update(state.Position()) ||
-          CurPattern.Update(state.Pattern()) ||
-          CurLine.Update(state.Line()))
+      const bool posChanged = CurPosition.Update(state.Position());
+      const bool patChanged = CurPattern.Update(state.Pattern());
+      const bool lineChanged = CurLine.Update(state.Line());
+      if (posChanged || patChanged || lineChanged)
       {
         const StateFieldsSource source(state);
-        Result = Template->Instantiate(source);
+        Template->Instantiate(source, Result);
       }
       return Result;
     }
@@ -8,6 +8,8 @@
 *
 **/
 
+//local includes
+#include "mixer_block.h"
 //common includes
 #include <error.h>
 #include <make_ptr.h>
@@ -16,8 +18,8 @@
 #include <math/numeric.h>
 #include <math/fixedpoint.h>
 #include <sound/gainer.h>
-//boost includes
-#include <boost/integer/static_log2.hpp>
+//std includes
+#include <algorithm>
 
 #define FILE_TAG F5996093
 
@@ -34,19 +36,25 @@ namespace Sound
     {
     }
 
-    Sample Apply(Sample in) const
+    //whole chunk is processed at once: constant gain or linear ramp from current level to the next step's one
+    void Apply(Chunk& chunk)
     {
-      static const Coeff ONE(1);
-      static const Coeff ZERO(0);
-      if (Level == ONE)
+      const std::size_t count = chunk.size();
+      if (!count)
       {
-        return in;
+        return;
       }
-      else if (Level == ZERO)
+      const Coeff start = Level;
+      ApplyStep();
+      if (start == Level)
+      {
+        ApplyConstant(chunk.data(), count);
+      }
+      else
       {
-        return Sample();
+        const int64_t delta = (Level.Raw() - start.Raw()) / static_cast<int64_t>(count);
+        GainBlock(chunk.data(), count, static_cast<int32_t>(start.Raw()), static_cast<int32_t>(delta));
       }
-      return Sample((Level * in.Left()).Round(), (Level * in.Right()).Round());
     }
 
     void SetGain(Gain::Type in)
@@ -64,6 +72,24 @@ namespace Sound
     {
       Step = Coeff(delta) / step;
     }
+  private:
+    void ApplyConstant(Sample* data, std::size_t count) const
+    {
+      static const Coeff ONE(1);
+      static const Coeff ZERO(0);
+      if (Level == ONE)
+      {
+        return;
+      }
+      else if (Level == ZERO)
+      {
+        std::fill_n(data, count, Sample());
+      }
+      else
+      {
+        GainBlock(data, count, static_cast<int32_t>(Level.Raw()), 0);
+      }
+    }
 
     void ApplyStep()
     {
@@ -80,8 +106,7 @@ namespace Sound
       }
     }
   private:
-    typedef Math::FixedPoint<int64_t, int64_t(1) << 31> Coeff;
-    static_assert(8 * sizeof(Coeff) >= boost::static_log2<Coeff::PRECISION>::value + Sample::BITS, "Not enough bits");
+    typedef Math::FixedPoint<int64_t, GAIN_BLOCK_PRECISION> Coeff;
     Coeff Level;
     Coeff Step;
   };
@@ -97,11 +122,7 @@ namespace Sound
 
     void ApplyData(Chunk::Ptr in) override
     {
-      for (auto& val : *in)
-      {
-        val = Core.Apply(val);
-      }
-      Core.ApplyStep();
+      Core.Apply(*in);
       return Delegate->ApplyData(std::move(in));
     }
 
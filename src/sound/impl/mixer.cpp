@@ -44,6 +44,11 @@ namespace Sound
       return Core.Mix(in);
     }
 
+    void ApplyBlock(const typename Base::InBlockType& in, std::size_t count, Sample* out) const override
+    {
+      Core.Mix(in.data(), count, out);
+    }
+
     void SetMatrix(const typename Base::Matrix& data) override
     {
       const auto it = std::find_if(data.begin(), data.end(), std::not1(std::mem_fun_ref(&Gain::IsNormalized)));
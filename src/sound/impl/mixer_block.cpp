@@ -0,0 +1,357 @@
+/**
+*
+* @file
+*
+* @brief  Block mixing and gain kernels implementation
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+//local includes
+#include "mixer_block.h"
+//std includes
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIXER_BLOCK_SSE2
+#include <emmintrin.h>
+//runtime cpu features detection is implemented for gcc-compatible compilers only
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIXER_BLOCK_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MIXER_BLOCK_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Sound
+{
+namespace
+{
+  static_assert(sizeof(Sample) == sizeof(uint32_t), "Incompatible sample layout");
+
+  typedef void (*MixBlockFunc)(const Sample::Type* const*, const int16_t*, uint_t, std::size_t, Sample*);
+  typedef void (*GainBlockFunc)(Sample*, std::size_t, int32_t, int32_t);
+
+  /*
+    Reference implementation, used for tails as well.
+    Vectorized versions should provide exactly the same result: sum is divided with truncation towards zero
+    and packed into sample without saturation.
+  */
+  void MixRange(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t begin, std::size_t end, Sample* out)
+  {
+    const int_t PRECISION = 256;
+    for (std::size_t pos = begin; pos != end; ++pos)
+    {
+      int_t left = 0;
+      int_t right = 0;
+      for (uint_t chan = 0; chan != channels; ++chan)
+      {
+        const int_t val = in[chan][pos];
+        left += coeffs[2 * chan] * val;
+        right += coeffs[2 * chan + 1] * val;
+      }
+      out[pos] = Sample(left / PRECISION, right / PRECISION);
+    }
+  }
+
+  /*
+    Reference gain implementation, used for tails as well.
+    Gain of every sample is taken with 1/32768 precision, product is rounded half up. Gain is less than 1,
+    so result always fits sample range.
+  */
+  const int32_t GAIN_SHIFT = 15;
+  const int32_t MAX_GAIN = (int32_t(1) << GAIN_SHIFT) - 1;
+  const int32_t GAIN_ROUNDING = int32_t(1) << (GAIN_SHIFT - 1);
+
+  inline int32_t GetSampleGain(int32_t level)
+  {
+    return std::min(level >> GAIN_SHIFT, MAX_GAIN);
+  }
+
+  void GainRange(Sample* data, std::size_t begin, std::size_t end, int32_t level, int32_t delta)
+  {
+    for (std::size_t pos = begin; pos != end; ++pos)
+    {
+      const int32_t gain = GetSampleGain(level + static_cast<int32_t>(pos) * delta);
+      const Sample in = data[pos];
+      data[pos] = Sample((in.Left() * gain + GAIN_ROUNDING) >> GAIN_SHIFT, (in.Right() * gain + GAIN_ROUNDING) >> GAIN_SHIFT);
+    }
+  }
+
+#if !defined(MIXER_BLOCK_SSE2) && !defined(MIXER_BLOCK_NEON)
+  void MixBlockScalar(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t count, Sample* out)
+  {
+    MixRange(in, coeffs, channels, 0, count, out);
+  }
+
+  void GainBlockScalar(Sample* data, std::size_t count, int32_t level, int32_t delta)
+  {
+    GainRange(data, 0, count, level, delta);
+  }
+#endif
+
+#ifdef MIXER_BLOCK_SSE2
+  //pairs of channels are interleaved and multiplied by pairs of coefficients using pmaddwd
+  namespace SSE2
+  {
+    inline __m128i Load(const Sample::Type* data)
+    {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    inline __m128i MakeCoeffs(int16_t first, int16_t second)
+    {
+      return _mm_set1_epi32(int(uint_t(uint16_t(second)) << 16) | uint16_t(first));
+    }
+
+    inline __m128i Divide(__m128i val)
+    {
+      const __m128i bias = _mm_srli_epi32(_mm_srai_epi32(val, 31), 24);
+      return _mm_srai_epi32(_mm_add_epi32(val, bias), 8);
+    }
+
+    inline __m128i Pack(__m128i left, __m128i right)
+    {
+      const __m128i mask = _mm_set1_epi32(0xffff);
+      return _mm_or_si128(_mm_and_si128(Divide(left), mask), _mm_slli_epi32(Divide(right), 16));
+    }
+
+    void MixBlock(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t count, Sample* out)
+    {
+      const std::size_t STEP = 8;
+      const std::size_t aligned = count - count % STEP;
+      for (std::size_t pos = 0; pos != aligned; pos += STEP)
+      {
+        __m128i leftLo = _mm_setzero_si128();
+        __m128i leftHi = leftLo;
+        __m128i rightLo = leftLo;
+        __m128i rightHi = leftLo;
+        for (uint_t chan = 0; chan < channels; chan += 2)
+        {
+          const bool hasPair = chan + 1 < channels;
+          const __m128i first = Load(in[chan] + pos);
+          const __m128i second = hasPair ? Load(in[chan + 1] + pos) : _mm_setzero_si128();
+          const __m128i lo = _mm_unpacklo_epi16(first, second);
+          const __m128i hi = _mm_unpackhi_epi16(first, second);
+          const __m128i left = MakeCoeffs(coeffs[2 * chan], hasPair ? coeffs[2 * chan + 2] : 0);
+          const __m128i right = MakeCoeffs(coeffs[2 * chan + 1], hasPair ? coeffs[2 * chan + 3] : 0);
+          leftLo = _mm_add_epi32(leftLo, _mm_madd_epi16(lo, left));
+          leftHi = _mm_add_epi32(leftHi, _mm_madd_epi16(hi, left));
+          rightLo = _mm_add_epi32(rightLo, _mm_madd_epi16(lo, right));
+          rightHi = _mm_add_epi32(rightHi, _mm_madd_epi16(hi, right));
+        }
+        __m128i* const target = reinterpret_cast<__m128i*>(out + pos);
+        _mm_storeu_si128(target, Pack(leftLo, rightLo));
+        _mm_storeu_si128(target + 1, Pack(leftHi, rightHi));
+      }
+      MixRange(in, coeffs, channels, aligned, count, out);
+    }
+
+    //values are interleaved with rounding multiplier, so pmaddwd calculates in*gain+rounding at once
+    void GainBlock(Sample* data, std::size_t count, int32_t level, int32_t delta)
+    {
+      const std::size_t STEP = 4;
+      const std::size_t aligned = count - count % STEP;
+      const __m128i ones = _mm_set1_epi16(1);
+      const __m128i rounding = _mm_set1_epi32(GAIN_ROUNDING << 16);
+      const __m128i maxGain = _mm_set1_epi32(MAX_GAIN);
+      const __m128i levelStep = _mm_set1_epi32(int32_t(STEP) * delta);
+      __m128i levels = _mm_setr_epi32(level, level + delta, level + 2 * delta, level + 3 * delta);
+      for (std::size_t pos = 0; pos != aligned; pos += STEP)
+      {
+        const __m128i rawGains = _mm_srai_epi32(levels, GAIN_SHIFT);
+        const __m128i overflow = _mm_cmpgt_epi32(rawGains, maxGain);
+        const __m128i gains = _mm_or_si128(_mm_andnot_si128(overflow, rawGains), _mm_and_si128(overflow, maxGain));
+        //gains of left and right channels of two samples
+        const __m128i coeffsLo = _mm_or_si128(_mm_unpacklo_epi32(gains, gains), rounding);
+        const __m128i coeffsHi = _mm_or_si128(_mm_unpackhi_epi32(gains, gains), rounding);
+        __m128i* const target = reinterpret_cast<__m128i*>(data + pos);
+        const __m128i val = _mm_loadu_si128(target);
+        const __m128i lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(val, ones), coeffsLo), GAIN_SHIFT);
+        const __m128i hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(val, ones), coeffsHi), GAIN_SHIFT);
+        _mm_storeu_si128(target, _mm_packs_epi32(lo, hi));
+        levels = _mm_add_epi32(levels, levelStep);
+      }
+      GainRange(data, aligned, count, level, delta);
+    }
+  }
+#endif
+
+#ifdef MIXER_BLOCK_AVX2
+  //same as SSE2 version, but unpacking works within 128-bit lanes, so halves are permuted before store
+  namespace AVX2
+  {
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+
+    AVX2_FUNCTION inline __m256i Load(const Sample::Type* data)
+    {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    }
+
+    AVX2_FUNCTION inline __m256i MakeCoeffs(int16_t first, int16_t second)
+    {
+      return _mm256_set1_epi32(int(uint_t(uint16_t(second)) << 16) | uint16_t(first));
+    }
+
+    AVX2_FUNCTION inline __m256i Divide(__m256i val)
+    {
+      const __m256i bias = _mm256_srli_epi32(_mm256_srai_epi32(val, 31), 24);
+      return _mm256_srai_epi32(_mm256_add_epi32(val, bias), 8);
+    }
+
+    AVX2_FUNCTION inline __m256i Pack(__m256i left, __m256i right)
+    {
+      const __m256i mask = _mm256_set1_epi32(0xffff);
+      return _mm256_or_si256(_mm256_and_si256(Divide(left), mask), _mm256_slli_epi32(Divide(right), 16));
+    }
+
+    AVX2_FUNCTION void MixBlock(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t count, Sample* out)
+    {
+      const std::size_t STEP = 16;
+      const std::size_t aligned = count - count % STEP;
+      for (std::size_t pos = 0; pos != aligned; pos += STEP)
+      {
+        __m256i leftLo = _mm256_setzero_si256();
+        __m256i leftHi = leftLo;
+        __m256i rightLo = leftLo;
+        __m256i rightHi = leftLo;
+        for (uint_t chan = 0; chan < channels; chan += 2)
+        {
+          const bool hasPair = chan + 1 < channels;
+          const __m256i first = Load(in[chan] + pos);
+          const __m256i second = hasPair ? Load(in[chan + 1] + pos) : _mm256_setzero_si256();
+          //samples 0..3 and 8..11
+          const __m256i lo = _mm256_unpacklo_epi16(first, second);
+          //samples 4..7 and 12..15
+          const __m256i hi = _mm256_unpackhi_epi16(first, second);
+          const __m256i left = MakeCoeffs(coeffs[2 * chan], hasPair ? coeffs[2 * chan + 2] : 0);
+          const __m256i right = MakeCoeffs(coeffs[2 * chan + 1], hasPair ? coeffs[2 * chan + 3] : 0);
+          leftLo = _mm256_add_epi32(leftLo, _mm256_madd_epi16(lo, left));
+          leftHi = _mm256_add_epi32(leftHi, _mm256_madd_epi16(hi, left));
+          rightLo = _mm256_add_epi32(rightLo, _mm256_madd_epi16(lo, right));
+          rightHi = _mm256_add_epi32(rightHi, _mm256_madd_epi16(hi, right));
+        }
+        const __m256i lo = Pack(leftLo, rightLo);
+        const __m256i hi = Pack(leftHi, rightHi);
+        __m256i* const target = reinterpret_cast<__m256i*>(out + pos);
+        _mm256_storeu_si256(target, _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(target + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+      }
+      MixRange(in, coeffs, channels, aligned, count, out);
+    }
+
+#undef AVX2_FUNCTION
+
+    bool IsSupported()
+    {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    }
+  }
+#endif
+
+#ifdef MIXER_BLOCK_NEON
+  //widening multiply-accumulate by scalar coefficient
+  namespace NEON
+  {
+    inline int32x4_t Divide(int32x4_t val)
+    {
+      const uint32x4_t bias = vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(val, 31)), 24);
+      return vshrq_n_s32(vaddq_s32(val, vreinterpretq_s32_u32(bias)), 8);
+    }
+
+    void MixBlock(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t count, Sample* out)
+    {
+      const std::size_t STEP = 4;
+      const std::size_t aligned = count - count % STEP;
+      for (std::size_t pos = 0; pos != aligned; pos += STEP)
+      {
+        int32x4_t left = vdupq_n_s32(0);
+        int32x4_t right = left;
+        for (uint_t chan = 0; chan != channels; ++chan)
+        {
+          const int16x4_t val = vld1_s16(in[chan] + pos);
+          left = vmlal_n_s16(left, val, coeffs[2 * chan]);
+          right = vmlal_n_s16(right, val, coeffs[2 * chan + 1]);
+        }
+        //(right << 16) | (left & 0xffff)
+        const uint32x4_t res = vsliq_n_u32(vreinterpretq_u32_s32(Divide(left)), vreinterpretq_u32_s32(Divide(right)), 16);
+        vst1q_u32(reinterpret_cast<uint32_t*>(out + pos), res);
+      }
+      MixRange(in, coeffs, channels, aligned, count, out);
+    }
+
+    //widening multiply by per-sample gains duplicated for both channels
+    void GainBlock(Sample* data, std::size_t count, int32_t level, int32_t delta)
+    {
+      const std::size_t STEP = 4;
+      const std::size_t aligned = count - count % STEP;
+      const int32x4_t rounding = vdupq_n_s32(GAIN_ROUNDING);
+      const int32x4_t maxGain = vdupq_n_s32(MAX_GAIN);
+      const int32x4_t levelStep = vdupq_n_s32(int32_t(STEP) * delta);
+      const int32_t initial[STEP] = {level, level + delta, level + 2 * delta, level + 3 * delta};
+      int32x4_t levels = vld1q_s32(initial);
+      for (std::size_t pos = 0; pos != aligned; pos += STEP)
+      {
+        const int16x4_t gains = vmovn_s32(vminq_s32(vshrq_n_s32(levels, GAIN_SHIFT), maxGain));
+        const int16x4x2_t coeffs = vzip_s16(gains, gains);
+        int16_t* const target = reinterpret_cast<int16_t*>(data + pos);
+        const int16x8_t val = vld1q_s16(target);
+        const int32x4_t lo = vshrq_n_s32(vmlal_s16(rounding, vget_low_s16(val), coeffs.val[0]), GAIN_SHIFT);
+        const int32x4_t hi = vshrq_n_s32(vmlal_s16(rounding, vget_high_s16(val), coeffs.val[1]), GAIN_SHIFT);
+        vst1q_s16(target, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+        levels = vaddq_s32(levels, levelStep);
+      }
+      GainRange(data, aligned, count, level, delta);
+    }
+  }
+#endif
+
+  MixBlockFunc SelectMixBlock()
+  {
+#if defined(MIXER_BLOCK_AVX2)
+    if (AVX2::IsSupported())
+    {
+      return &AVX2::MixBlock;
+    }
+#endif
+#if defined(MIXER_BLOCK_SSE2)
+    return &SSE2::MixBlock;
+#elif defined(MIXER_BLOCK_NEON)
+    return &NEON::MixBlock;
+#else
+    return &MixBlockScalar;
+#endif
+  }
+
+  GainBlockFunc SelectGainBlock()
+  {
+#if defined(MIXER_BLOCK_SSE2)
+    return &SSE2::GainBlock;
+#elif defined(MIXER_BLOCK_NEON)
+    return &NEON::GainBlock;
+#else
+    return &GainBlockScalar;
+#endif
+  }
+
+}
+}
+
+namespace Sound
+{
+  void MixBlock(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t count, Sample* out)
+  {
+    static const MixBlockFunc IMPL = SelectMixBlock();
+    IMPL(in, coeffs, channels, count, out);
+  }
+
+  void GainBlock(Sample* data, std::size_t count, int32_t level, int32_t delta)
+  {
+    static const GainBlockFunc IMPL = SelectGainBlock();
+    IMPL(data, count, level, delta);
+  }
+}
@@ -0,0 +1,33 @@
+/**
+*
+* @file
+*
+* @brief  Declaration of block mixing and gain kernels
+*
+* @author vitamin.caig@gmail.com
+*
+**/
+
+#pragma once
+
+//library includes
+#include <sound/sample.h>
+
+namespace Sound
+{
+  //! @brief Mix planar block using integer coefficients
+  //! @param in Pointers to @count samples of each of @channels channels
+  //! @param coeffs Left/right levels pair for each channel, 1/256 precision
+  //! @note Result is the same as per-sample MixerCore::Mix produces. Fastest implementation for current CPU is used
+  void MixBlock(const Sample::Type* const* in, const int16_t* coeffs, uint_t channels, std::size_t count, Sample* out);
+
+  //! @brief Precision of gain values for GainBlock
+  const int32_t GAIN_BLOCK_PRECISION = int32_t(1) << 30;
+
+  //! @brief Apply in place gain changing linearly from @level by @delta per sample
+  //! @param level Gain of the first sample, [0, GAIN_BLOCK_PRECISION]
+  //! @param delta Gain change per sample, so all the gains are kept in the same range
+  //! @note Gain is rounded to 1/32768 and limited by 32767/32768, full gain is expected to be handled by caller.
+  //!       Fastest implementation for current CPU is used, results are the same for all of them
+  void GainBlock(Sample* data, std::size_t count, int32_t level, int32_t delta);
+}
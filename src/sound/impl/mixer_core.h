@@ -10,6 +10,8 @@
 
 #pragma once
 
+//local includes
+#include "mixer_block.h"
 //library includes
 #include <sound/gain.h>
 #include <sound/multichannel_sample.h>
@@ -34,6 +36,7 @@ namespace Sound
           row[outChan] = val;
         }
       }
+      UpdateRawCoeffs();
     }
 
     Sample Mix(const InType& in) const
@@ -52,6 +55,12 @@ namespace Sound
       return Sample(out[0].Integer(), out[1].Integer());
     }
 
+    //! @param in Pointers to @count samples for each of channels
+    void Mix(const Sample::Type* const* in, std::size_t count, Sample* out) const
+    {
+      MixBlock(in, RawCoeffs.data(), ChannelsCount, count, out);
+    }
+
     void SetMatrix(const MatrixType& matrix)
     {
       for (uint_t inChan = 0; inChan != ChannelsCount; ++inChan)
@@ -61,6 +70,19 @@ namespace Sound
         out[0] = Coeff(in.Left() / ChannelsCount);
         out[1] = Coeff(in.Right() / ChannelsCount);
       }
+      UpdateRawCoeffs();
+    }
+  private:
+    void UpdateRawCoeffs()
+    {
+      for (uint_t inChan = 0; inChan != ChannelsCount; ++inChan)
+      {
+        const CoeffRow& row = Matrix[inChan];
+        for (uint_t outChan = 0; outChan != row.size(); ++outChan)
+        {
+          RawCoeffs[inChan * Sample::CHANNELS + outChan] = static_cast<int16_t>(row[outChan].Raw());
+        }
+      }
     }
   private:
     static const int_t PRECISION = 256;
@@ -68,5 +90,7 @@ namespace Sound
     typedef std::array<Coeff, Sample::CHANNELS> CoeffRow;
     typedef std::array<CoeffRow, ChannelsCount> CoeffMatrix;
     CoeffMatrix Matrix;
+    //same as Matrix in layout suitable for block mixing
+    std::array<int16_t, Sample::CHANNELS * ChannelsCount> RawCoeffs;
   };
 }
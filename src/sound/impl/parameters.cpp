@@ -70,6 +70,8 @@ namespace Parameters
       extern const NameType LOOPED = PREFIX + "looped";
       extern const NameType FADEIN = PREFIX + "fadein";
       extern const NameType FADEOUT = PREFIX + "fadeout";
+      extern const NameType SILENCE_LIMIT = PREFIX + "silencelimit";
+      extern const NameType REPEAT_LIMIT = PREFIX + "repeatlimit";
 
       namespace Mixer
       {
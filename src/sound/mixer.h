@@ -20,10 +20,26 @@ namespace Sound
   {
   public:
     typedef typename MultichannelSample<Channels>::Type InDataType;
+    //! @brief Planar block of input data, one pointer per channel
+    typedef std::array<const Sample::Type*, Channels> InBlockType;
     typedef std::shared_ptr<const FixedChannelsMixer<Channels> > Ptr;
     virtual ~FixedChannelsMixer() = default;
 
     virtual Sample ApplyData(const InDataType& in) const = 0;
+
+    //! @brief Mix @count samples of each channel from @in into @out
+    virtual void ApplyBlock(const InBlockType& in, std::size_t count, Sample* out) const
+    {
+      InDataType sample;
+      for (std::size_t pos = 0; pos != count; ++pos)
+      {
+        for (uint_t chan = 0; chan != Channels; ++chan)
+        {
+          sample[chan] = in[chan][pos];
+        }
+        out[pos] = ApplyData(sample);
+      }
+    }
   };
 
   typedef FixedChannelsMixer<1> OneChannelMixer;
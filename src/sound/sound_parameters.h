@@ -67,6 +67,25 @@ namespace Parameters
       //! Parameter name
       extern const NameType FADEOUT;
       //@}
+
+      //@{
+      //! @name Stop rendering after sustained silence in microseconds
+
+      //! Default value- do not stop
+      const IntType SILENCE_LIMIT_DEFAULT = 0;
+      //! Parameter name
+      extern const NameType SILENCE_LIMIT;
+      //@}
+
+      //@{
+      //! @name Stop rendering after exactly repeated output of specified duration in microseconds
+      //! @note Not used in looped mode
+
+      //! Default value- do not stop
+      const IntType REPEAT_LIMIT_DEFAULT = 0;
+      //! Parameter name
+      extern const NameType REPEAT_LIMIT;
+      //@}
     }
   }
 }
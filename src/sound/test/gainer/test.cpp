@@ -12,9 +12,12 @@
 #include <math/numeric.h>
 #include <sound/gainer.h>
 #include <sound/chunk_builder.h>
+#include <sound/impl/mixer_block.h>
 #include <boost/range/size.hpp>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 #define FILE_TAG B5BAF4C1
 
@@ -115,6 +118,144 @@ namespace Sound
   private:
     Sample ToCompare;
   };
+
+  std::vector<Sample> MakeBlock(std::size_t count)
+  {
+    std::vector<Sample> result(count);
+    uint_t seed = 1;
+    for (auto& val : result)
+    {
+      seed = seed * 1103515245 + 12345;
+      const Sample::Type left = static_cast<Sample::Type>(seed >> 16);
+      seed = seed * 1103515245 + 12345;
+      val = Sample(left, static_cast<Sample::Type>(seed >> 16));
+    }
+    result[0] = Sample(Sample::MIN, Sample::MAX);
+    result[count - 1] = Sample(Sample::MAX, Sample::MIN);
+    return result;
+  }
+
+  //scalar reference of GainBlock: gain with 1/32768 precision limited by 32767/32768, product rounded half up
+  Sample ApplyGain(Sample in, int32_t level)
+  {
+    const int32_t gain = std::min(level >> 15, int32_t(32767));
+    return Sample((in.Left() * gain + 16384) >> 15, (in.Right() * gain + 16384) >> 15);
+  }
+
+  void CheckGainBlock(std::size_t count, int32_t level, int32_t delta)
+  {
+    std::cout << "Checking for " << count << " samples from " << level << " by " << delta << ":";
+    const std::vector<Sample> input = MakeBlock(count);
+    std::vector<Sample> result(input);
+    GainBlock(&result[0], count, level, delta);
+    for (std::size_t pos = 0; pos != count; ++pos)
+    {
+      const Sample ref = ApplyGain(input[pos], level + static_cast<int32_t>(pos) * delta);
+      if (!(result[pos] == ref))
+      {
+        std::cout << " failed\n";
+        throw MakeFormattedError(THIS_LINE, "Block value at %5%=<%1%,%2%> while expected=<%3%,%4%>",
+          result[pos].Left(), result[pos].Right(), ref.Left(), ref.Right(), pos);
+      }
+    }
+    std::cout << " passed\n";
+  }
+
+  void TestGainBlock()
+  {
+    //sizes to cover both vectorized and tail parts
+    const std::size_t COUNTS[] = {1, 3, 4, 5, 8, 53};
+    for (const auto count : COUNTS)
+    {
+      const int32_t rampStep = GAIN_BLOCK_PRECISION / static_cast<int32_t>(count);
+      CheckGainBlock(count, GAIN_BLOCK_PRECISION, 0);
+      CheckGainBlock(count, GAIN_BLOCK_PRECISION / 2, 0);
+      CheckGainBlock(count, GAIN_BLOCK_PRECISION / 10, 0);
+      CheckGainBlock(count, 0, rampStep);
+      CheckGainBlock(count, GAIN_BLOCK_PRECISION, -rampStep);
+      CheckGainBlock(count, GAIN_BLOCK_PRECISION / 2, rampStep / 2);
+    }
+  }
+
+  //fading is applied as a linear ramp from the current level to the next step one
+  class FadeTarget : public Receiver
+  {
+  public:
+    FadeTarget()
+      : Start(), End()
+    {
+    }
+
+    void ApplyData(Chunk::Ptr data) override
+    {
+      const std::size_t count = data->size();
+      const int_t first = static_cast<int_t>(Sample::MAX * Start);
+      const int_t last = static_cast<int_t>(Sample::MAX * (Start + (End - Start) * (count - 1) / count));
+      if (Check(data->front().Left(), first) && Check(data->back().Left(), last) && IsMonotonic(*data))
+      {
+        std::cout << " passed\n";
+      }
+      else
+      {
+        std::cout << " failed\n";
+        throw MakeFormattedError(THIS_LINE, "Failed. Values=<%1%..%2%> while expected=<%3%..%4%>",
+          data->front().Left(), data->back().Left(), first, last);
+      }
+    }
+
+    void Flush() override
+    {
+    }
+
+    void SetLevels(double start, double end)
+    {
+      Start = start;
+      End = end;
+    }
+  private:
+    static bool Check(Sample::Type data, int_t ref)
+    {
+      return Math::Absolute(int_t(data) - ref) <= THRESHOLD;
+    }
+
+    bool IsMonotonic(const Chunk& data) const
+    {
+      for (std::size_t pos = 1; pos < data.size(); ++pos)
+      {
+        const Sample::Type prev = data[pos - 1].Left();
+        const Sample::Type cur = data[pos].Left();
+        if (End < Start ? cur > prev : cur < prev)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  private:
+    double Start;
+    double End;
+  };
+
+  void TestFading()
+  {
+    FadeTarget* tgt = nullptr;
+    Receiver::Ptr receiver(tgt = new FadeTarget);
+    const FadeGainer::Ptr gainer = CreateFadeGainer();
+    gainer->SetTarget(receiver);
+    gainer->SetGain(Gain::Type(1));
+    gainer->SetFading(Gain::Type(-1), 2);
+    //level changes by half per chunk and stays at zero then
+    const double LEVELS[] = {1.0, 0.5, 0.0, 0.0};
+    const std::size_t COUNTS[] = {53, 4, 7};
+    for (unsigned chunk = 0; chunk != boost::size(COUNTS); ++chunk)
+    {
+      std::cout << "Checking for fade out of " << COUNTS[chunk] << " samples:";
+      tgt->SetLevels(LEVELS[chunk], LEVELS[chunk + 1]);
+      Chunk::Ptr data(new Chunk(COUNTS[chunk]));
+      std::fill(data->begin(), data->end(), Sample(Sample::MAX, Sample::MAX));
+      gainer->ApplyData(std::move(data));
+    }
+  }
 }
 
 int main()
@@ -159,6 +300,10 @@ int main()
         gainer->ApplyData(builder.CaptureResult());
       }
     }
+    std::cout << "--- Test for block gain ---\n";
+    TestGainBlock();
+    std::cout << "--- Test for fading ---\n";
+    TestFading();
     std::cout << " Succeed!" << std::endl;
   }
   catch (const Error& e)
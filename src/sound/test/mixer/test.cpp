@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 #include <boost/range/size.hpp>
 
@@ -129,6 +130,45 @@ namespace Sound
     }
   }
 
+  template<unsigned Channels>
+  void CheckBlock(const FixedChannelsMixer<Channels>& mixer)
+  {
+    //odd size to cover both vectorized and tail parts
+    const std::size_t SAMPLES = 53;
+    std::vector<Sample::Type> data(SAMPLES * Channels);
+    uint_t seed = 1;
+    for (auto& val : data)
+    {
+      seed = seed * 1103515245 + 12345;
+      val = static_cast<Sample::Type>(seed >> 16);
+    }
+    data[0] = Sample::MIN;
+    data[1] = Sample::MAX;
+    typename FixedChannelsMixer<Channels>::InBlockType planes;
+    for (uint_t chan = 0; chan != Channels; ++chan)
+    {
+      planes[chan] = &data[chan * SAMPLES];
+    }
+    std::vector<Sample> result(SAMPLES);
+    mixer.ApplyBlock(planes, SAMPLES, &result[0]);
+    for (std::size_t pos = 0; pos != SAMPLES; ++pos)
+    {
+      typename MultichannelSample<Channels>::Type in;
+      for (uint_t chan = 0; chan != Channels; ++chan)
+      {
+        in[chan] = planes[chan][pos];
+      }
+      const Sample ref = mixer.ApplyData(in);
+      if (!(result[pos] == ref))
+      {
+        std::cout << " failed\n";
+        throw MakeFormattedError(THIS_LINE, "Block value at %5%=<%1%,%2%> while expected=<%3%,%4%>",
+          result[pos].Left(), result[pos].Right(), ref.Left(), ref.Right(), pos);
+      }
+    }
+    std::cout << " passed\n";
+  }
+
   template<unsigned Channels>
   void TestMixer()
   {
@@ -166,6 +206,19 @@ namespace Sound
         std::cout << "Checking for " << INPUT_NAMES[input] << " input: ";
         Check(mixer->ApplyData(MakeSample<MultichannelSample<Channels> >(INPUTS[input])), *result);
       }
+      std::cout << "Checking for block input: ";
+      CheckBlock<Channels>(*mixer);
+    }
+    {
+      std::cout << "--- Test for mixed matrix ---\n";
+      typename FixedChannelsMatrixMixer<Channels>::Matrix matrix;
+      for (uint_t chan = 0; chan != Channels; ++chan)
+      {
+        matrix[chan] = GAINS[(chan + 1) % boost::size(GAINS)];
+      }
+      mixer->SetMatrix(matrix);
+      std::cout << "Checking for block input: ";
+      CheckBlock<Channels>(*mixer);
     }
     std::cout << "Parameters:" << std::endl;
     for (uint_t inChan = 0; inChan != Channels; ++inChan)
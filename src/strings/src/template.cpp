@@ -17,31 +17,68 @@
 //std includes
 #include <algorithm>
 #include <cassert>
-//boost includes
-#include <boost/bind.hpp>
 
 namespace Strings
 {
   const Char Template::FIELD_START = '[';
   const Char Template::FIELD_END = ']';
 
+  //Template is parsed once to literal parts stored in single string and unique fields list.
+  //Each field's value is requested once per instantiation, result is built in place.
   class PreprocessingTemplate : public Template
   {
   public:
     explicit PreprocessingTemplate(const String& templ)
+      : RepeatedFields(false)
     {
       const std::size_t fieldsAvg = std::count(templ.begin(), templ.end(), FIELD_START);
-      FixedStrings.reserve(fieldsAvg);
       Fields.reserve(fieldsAvg);
-      Entries.reserve(fieldsAvg * 2);
+      Parts.reserve(fieldsAvg * 2 + 1);
       ParseTemplate(templ);
     }
 
-    String Instantiate(const FieldsSource& src) const override
+    using Template::Instantiate;
+
+    void Instantiate(const FieldsSource& src, String& result) const override
     {
-      Array resultFields(Fields.size());
-      std::transform(Fields.begin(), Fields.end(), resultFields.begin(), boost::bind(&FieldsSource::GetFieldValue, &src, _1));
-      return SubstFields(resultFields);
+      result.clear();
+      if (RepeatedFields)
+      {
+        Array values(Fields.size());
+        std::size_t size = Literals.size();
+        for (std::size_t idx = 0, lim = Fields.size(); idx != lim; ++idx)
+        {
+          values[idx] = src.GetFieldValue(Fields[idx]);
+          size += values[idx].size();
+        }
+        result.reserve(size);
+        for (const auto& part : Parts)
+        {
+          if (part.IsField)
+          {
+            result += values[part.Index];
+          }
+          else
+          {
+            result.append(Literals, part.Index, part.Size);
+          }
+        }
+      }
+      else
+      {
+        result.reserve(Literals.size());
+        for (const auto& part : Parts)
+        {
+          if (part.IsField)
+          {
+            result += src.GetFieldValue(Fields[part.Index]);
+          }
+          else
+          {
+            result.append(Literals, part.Index, part.Size);
+          }
+        }
+      }
     }
   private:
     void ParseTemplate(const String& templ)
@@ -59,46 +96,57 @@ namespace Strings
         {
           break;//invalid syntax
         }
-        if (textBegin != fieldBegin)
-        {
-          //add text to set
-          auto text = templ.substr(textBegin, fieldBegin - textBegin);
-          const auto idx = FixedStrings.size();
-          FixedStrings.emplace_back(std::move(text));
-          Entries.emplace_back(idx, false);
-        }
-        {
-          auto field = templ.substr(fieldBegin + 1, fieldEnd - fieldBegin - 1);
-          const auto idx = Fields.size();
-          Fields.emplace_back(std::move(field));
-          Entries.emplace_back(idx, true);
-        }
+        AddLiteral(templ, textBegin, fieldBegin - textBegin);
+        AddField(templ.substr(fieldBegin + 1, fieldEnd - fieldBegin - 1));
         textBegin = fieldEnd + 1;
       }
       //add rest text
+      AddLiteral(templ, textBegin, templ.size() - textBegin);
+    }
+
+    void AddLiteral(const String& templ, std::size_t offset, std::size_t size)
+    {
+      if (size)
       {
-        auto restText = templ.substr(textBegin);
-        const auto restIdx = FixedStrings.size();
-        FixedStrings.emplace_back(std::move(restText));
-        Entries.emplace_back(restIdx, false);
+        Parts.push_back(Part(Literals.size(), size, false));
+        Literals.append(templ, offset, size);
       }
     }
-    
-    String SubstFields(const Array& fields) const
+
+    void AddField(String field)
     {
-      String res;
-      for (const auto& entry : Entries)
+      const auto it = std::find(Fields.begin(), Fields.end(), field);
+      if (it != Fields.end())
       {
-        res += (entry.second ? fields : FixedStrings)[entry.first];
+        RepeatedFields = true;
+        Parts.push_back(Part(it - Fields.begin(), 0, true));
+      }
+      else
+      {
+        Parts.push_back(Part(Fields.size(), 0, true));
+        Fields.emplace_back(std::move(field));
       }
-      return res;
     }
   private:
-    Array FixedStrings;
+    struct Part
+    {
+      Part(std::size_t index, std::size_t size, bool isField)
+        : Index(index)
+        , Size(size)
+        , IsField(isField)
+      {
+      }
+
+      //field index or literal offset
+      std::size_t Index;
+      std::size_t Size;
+      bool IsField;
+    };
+
+    String Literals;
     Array Fields;
-    typedef std::pair<std::size_t, bool> PartEntry; //index => isField
-    typedef std::vector<PartEntry> PartEntries;
-    PartEntries Entries;
+    std::vector<Part> Parts;
+    bool RepeatedFields;
   };
 
   Template::Ptr Template::Create(const String& templ)
@@ -29,7 +29,15 @@ namespace Strings
     //! @brief Virtual destructor
     virtual ~Template() = default;
     //! @brief Performing instantiation
-    virtual String Instantiate(const class FieldsSource& source) const = 0;
+    String Instantiate(const class FieldsSource& source) const
+    {
+      String result;
+      Instantiate(source, result);
+      return result;
+    }
+    //! @brief Performing instantiation to reusable buffer
+    //! @param result Previous content is replaced keeping allocated storage
+    virtual void Instantiate(const class FieldsSource& source, String& result) const = 0;
 
     //! @brief Factory
     static Ptr Create(const String& templ);
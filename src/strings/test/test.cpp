@@ -39,13 +39,48 @@ namespace
   void TestTemplate(const Strings::FieldsSource& source, const String& templ, const String& reference)
   {
     const String res = Strings::Template::Instantiate(templ, source);
-    if (res == reference)
+    //buffer is reused between tests
+    static String buffer("previous content");
+    Strings::Template::Create(templ)->Instantiate(source, buffer);
+    if (res == reference && buffer == reference)
     {
       std::cout << "Passed test for '" << templ << '\'' << std::endl;
     }
     else
     {
-      std::cout << "Failed test for '" << templ << "' (result is '" << res << "')" << std::endl;
+      std::cout << "Failed test for '" << templ << "' (result is '" << res << "', '" << buffer << "')" << std::endl;
+      throw 1;
+    }
+  }
+
+  class CountingFieldsSource : public Strings::SkipFieldsSource
+  {
+  public:
+    CountingFieldsSource()
+      : Requests()
+    {
+    }
+
+    String GetFieldValue(const String& name) const override
+    {
+      ++Requests;
+      return name;
+    }
+
+    mutable std::size_t Requests;
+  };
+
+  void TestFieldsRequests(const String& templ, std::size_t reference)
+  {
+    const CountingFieldsSource source;
+    Strings::Template::Create(templ)->Instantiate(source);
+    if (source.Requests == reference)
+    {
+      std::cout << "Passed requests test for '" << templ << '\'' << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed requests test for '" << templ << "' (" << source.Requests << " requests)" << std::endl;
       throw 1;
     }
   }
@@ -95,6 +130,8 @@ int main()
       TestTemplate(replaceToChar, "Replace bunch of symbols to single in [name] and [value]", "Replace bunch of symbols to single in v%lu% and n%m%");
       const Strings::FilterFieldsSource replaceToCharsSet(source, "abcde", "ABCDE");
       TestTemplate(replaceToCharsSet, "Replace bunch of symbols to multiple in [name] and [value]", "Replace bunch of symbols to multiple in vAluE and nAmE");
+      TestFieldsRequests("[name] and [value]", 2);
+      TestFieldsRequests("[name], [value] and [name] again", 2);
     }
     std::cout << "---- Test for transcode ----" << std::endl;
     {
@@ -55,6 +55,11 @@ namespace Time
       return Count;
     }
 
+    const TimeStamp& GetPeriod() const
+    {
+      return Period;
+    }
+
     template<class OtherTimestamp>
     void SetPeriod(const OtherTimestamp& period)
     {